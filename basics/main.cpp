@@ -6,6 +6,9 @@
 #include <over/core/Camera.hpp>
 #include <over/core/Includes.hpp>
 #include <over/core/Shader.hpp>
+#include <over/core/window/Context.hpp>
+#include <over/core/window/RunOptions.hpp>
+#include <over/core/window/Window.hpp>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -92,25 +95,12 @@ glm::mat4 LookAt(glm::vec3 position, glm::vec3 target, glm::vec3 globalUp) {
 int main() {
   fmt::println("Hello, opengl app!");
 
-  glfwInit();
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-  GLFWwindow* window = glfwCreateWindow(
-      WIDTH, HEIGHT, "Hello, opengl, finally!", nullptr, nullptr);
-  if (!window) {
-    fmt::println("Failed to create glfw window");
-    glfwTerminate();
-    return -1;
-  }
-
-  glfwMakeContextCurrent(window);
-
-  if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-    fmt::println("Failed to initialize GLAD");
-    return -1;
-  }
+  // OVER_BACKEND, OVER_FRAMES and OVER_CAPTURE, see over::RunOptions
+  const auto& options = over::RunOptions::Get();
+  over::Context context(3, 3);
+  over::Window surface(WIDTH, HEIGHT, "Hello, opengl, finally!");
+  context.LoadOpenGL(surface);
+  GLFWwindow* window = surface.Get();
 
   // Set callbacks
   glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -235,8 +225,9 @@ int main() {
 
   float lastUpdate = glfwGetTime();
   int32_t fps = 0;
+  size_t frame = 0;
 
-  while (!glfwWindowShouldClose(window)) {
+  while (!glfwWindowShouldClose(window) && !options.IsDone(frame)) {
     float start = glfwGetTime();
     processInput(window);
 
@@ -288,10 +279,14 @@ int main() {
 
     glBindVertexArray(0);
 
-    glfwSwapBuffers(window);
+    if (options.IsCaptured(frame)) {
+      surface.ReadPixels().ToFile(options.capture);
+    }
+    surface.SwapBuffers();
     glfwPollEvents();
 
     fps++;
+    frame++;
     if (glfwGetTime() - lastUpdate > 1.0f) {
       lastUpdate = glfwGetTime();
       fmt::println("fps: {}", fps);
@@ -301,7 +296,5 @@ int main() {
     deltaTime = glfwGetTime() - start;
   }
 
-  glfwTerminate();
-
   return 0;
 }
\ No newline at end of file
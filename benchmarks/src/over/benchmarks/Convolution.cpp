@@ -0,0 +1,129 @@
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <over/core/Includes.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/post/ConvolutionFilter.hpp>
+#include <over/core/post/Kernel.hpp>
+#include <over/core/window/Context.hpp>
+#include <over/core/window/Window.hpp>
+
+#include <fmt/core.h>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+constexpr usize ITERATIONS = 10;
+constexpr uint32 SIZES[] = {3, 9, 15, 31};
+
+using Method = post::ConvolutionFilter::Method;
+
+// GPU time per Apply, the queue is drained before and after
+template <class F>
+static float64 Measure(F&& func) {
+  func();
+  glFinish();
+
+  auto start = std::chrono::steady_clock::now();
+  for (usize i = 0; i < ITERATIONS; i++) {
+    func();
+  }
+  glFinish();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<float64>(end - start).count() / ITERATIONS;
+}
+
+static gl::TextureWrapper<> CreateTarget(glm::ivec2 size, const void* data) {
+  gl::TextureWrapper<> texture;
+  auto view = texture.As<gl::TextureTarget::TEXTURE_2D>();
+  view.Bind();
+  view.Reserve2D(GL_RGBA8, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, data);
+  view.SetParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  view.SetParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  view.Unbind();
+  return texture;
+}
+
+static const char* GetName(Method method) {
+  switch (method) {
+    case Method::SEPARABLE:
+      return "Separable";
+    case Method::TILED:
+      return "Tiled";
+    case Method::DIRECT:
+      return "Direct";
+    default:
+      return "Auto";
+  }
+}
+
+static void Run() {
+  // hidden window, only the context is needed
+  Context context(4, 3);
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  Window window(64, 64, "convolution-benchmark");
+  context.LoadOpenGL(window);
+
+  post::ConvolutionFilter filter("shaders/KernelSeparableCompute.shader",
+                                 "shaders/KernelTiledCompute.shader");
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<uint32> byte(0, 255);
+  std::uniform_real_distribution<float32> weight(-1.f, 1.f);
+
+  fmt::println("convolution, {}, {} iterations",
+               reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+               ITERATIONS);
+  fmt::println("direct is the screen shader approach: a fetch per tap");
+
+  for (glm::ivec2 size : {glm::ivec2(1920, 1080), glm::ivec2(3840, 2160)}) {
+    std::vector<uint8> pixels(usize(size.x) * size.y * 4);
+    for (auto& pixel : pixels) {
+      pixel = static_cast<uint8>(byte(random));
+    }
+
+    auto source = CreateTarget(size, pixels.data());
+    auto destination = CreateTarget(size, nullptr);
+    auto sourceView = source.As<gl::TextureTarget::TEXTURE_2D>();
+    auto destinationView = destination.As<gl::TextureTarget::TEXTURE_2D>();
+
+    float64 pixelCount = float64(size.x) * size.y;
+
+    for (auto kernelSize : SIZES) {
+      // a random kernel is not separable, a gaussian is
+      std::vector<float32> weights(kernelSize * kernelSize);
+      for (auto& w : weights) {
+        w = weight(random);
+      }
+      post::Kernel general(kernelSize, std::move(weights));
+      auto gaussian = post::Kernel::Gaussian(kernelSize);
+
+      auto report = [&](const char* kind, const post::Kernel& kernel,
+                        Method method) {
+        auto seconds = Measure([&] {
+          filter.Apply(kernel, sourceView, destinationView, size, GL_RGBA8,
+                       method);
+        });
+        fmt::println("{}x{} {:>2}x{:<2} {:>8} {:>9}: {:8.3f} ms, {:8.1f} "
+                     "Mpix/s, {} taps",
+                     size.x, size.y, kernelSize, kernelSize, kind,
+                     GetName(method), seconds * 1000.0,
+                     pixelCount / seconds / 1e6, filter.GetTaps());
+      };
+
+      report("general", general, Method::DIRECT);
+      report("general", general, Method::TILED);
+      report("gaussian", gaussian, Method::DIRECT);
+      report("gaussian", gaussian, Method::SEPARABLE);
+    }
+  }
+}
+
+}  // namespace over
+
+int main() {
+  over::Run();
+  return 0;
+}
@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <over/core/BVH.hpp>
+#include <over/core/Bounds.hpp>
+#include <over/core/Camera.hpp>
+#include <over/core/Frustum.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/culling/FrustumCuller.hpp>
+
+#include <fmt/core.h>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+constexpr usize OBJECTS = 100'000;
+constexpr usize ITERATIONS = 200;
+
+template <class F>
+static float64 Measure(F&& func) {
+  auto start = std::chrono::steady_clock::now();
+  for (usize i = 0; i < ITERATIONS; i++) {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<float64>(end - start).count() / ITERATIONS;
+}
+
+static void Report(const char* name, float64 seconds, usize visible) {
+  fmt::println("{:>8}: {:8.3f} ms/frame, {:8.1f} Mboxes/s, visible: {}", name,
+               seconds * 1000.0, OBJECTS / seconds / 1e6, visible);
+}
+
+static void Run() {
+  std::mt19937 random(42);
+  std::uniform_real_distribution<float32> position(-500.f, 500.f);
+  std::uniform_real_distribution<float32> size(0.5f, 5.f);
+
+  std::vector<AABB> boxes;
+  boxes.reserve(OBJECTS);
+
+  culling::BoundsSoA bounds;
+  bounds.Reserve(OBJECTS);
+
+  for (usize i = 0; i < OBJECTS; i++) {
+    glm::vec3 center(position(random), position(random), position(random));
+    glm::vec3 extents(size(random), size(random), size(random));
+    boxes.emplace_back(center - extents, center + extents);
+    bounds.Add(boxes.back());
+  }
+
+  Camera camera({0.f, 0.f, 0.f}, {0.f, 0.f, 0.f}, 1.f, glm::radians(60.f),
+                16.f / 9.f);
+  Frustum frustum = camera.GetFrustum();
+
+  std::vector<uint32> visible;
+  visible.reserve(OBJECTS);
+
+  fmt::println("frustum culling, {} boxes, {} iterations", OBJECTS,
+               ITERATIONS);
+
+  usize count = 0;
+  auto aos = Measure([&] {
+    visible.clear();
+    for (usize i = 0; i < boxes.size(); i++) {
+      if (frustum.Intersects(boxes[i])) {
+        visible.push_back(static_cast<uint32>(i));
+      }
+    }
+    count = visible.size();
+  });
+  Report("AoS", aos, count);
+
+  auto scalar = Measure([&] {
+    visible.clear();
+    count = culling::FrustumCuller::CullScalar(frustum, bounds, visible);
+  });
+  Report("SoA", scalar, count);
+
+  auto simd = Measure([&] {
+    visible.clear();
+    count = culling::FrustumCuller::Cull(frustum, bounds, visible);
+  });
+  Report(culling::FrustumCuller::GetInstructionSet(), simd, count);
+
+  BVH bvh;
+  auto build = Measure([&] { bvh.Build(boxes); });
+  fmt::println("{:>8}: {:8.3f} ms, {} nodes", "BVH build", build * 1000.0,
+               bvh.GetNodes().size());
+
+  auto hierarchy = Measure([&] {
+    visible.clear();
+    count = bvh.Query(frustum, visible);
+  });
+  Report("BVH", hierarchy, count);
+
+  // picking: rays through a grid of screen points
+  constexpr usize RAYS = 1024;
+  std::vector<Ray> rays;
+  rays.reserve(RAYS);
+  for (usize i = 0; i < RAYS; i++) {
+    glm::vec2 ndc((i % 32) / 16.f - 1.f, (i / 32) / 16.f - 1.f);
+    rays.push_back(camera.GetRay(ndc));
+  }
+
+  usize hits = 0;
+  auto linear = Measure([&] {
+    hits = 0;
+    for (const auto& ray : rays) {
+      float32 closest = std::numeric_limits<float32>::infinity();
+      for (const auto& box : boxes) {
+        float32 distance;
+        if (box.Intersects(ray, closest, distance) && distance < closest) {
+          closest = distance;
+        }
+      }
+      hits += std::isinf(closest) ? 0 : 1;
+    }
+  });
+  fmt::println("{:>8}: {:8.3f} ms/{} rays, hits: {}", "Linear", linear * 1000.0,
+               RAYS, hits);
+
+  auto picking = Measure([&] {
+    hits = 0;
+    for (const auto& ray : rays) {
+      hits += bvh.Raycast(ray) ? 1 : 0;
+    }
+  });
+  fmt::println("{:>8}: {:8.3f} ms/{} rays, hits: {}", "BVH", picking * 1000.0,
+               RAYS, hits);
+}
+
+}  // namespace over
+
+int main() {
+  over::Run();
+  return 0;
+}
@@ -0,0 +1,378 @@
+#include <over/benchmarks/Harness.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include <over/core/opengl/RenderStats.hpp>
+
+#include <fmt/core.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace over::benchmarks {
+
+namespace {
+
+// 0.05 ms, below it timers only see noise
+constexpr float64 TIME_SLACK = 0.05;
+
+std::string_view GetVariable(const char* name) {
+  const char* value = std::getenv(name);
+  return value != nullptr ? value : "";
+}
+
+// Peak resident set of the process, bytes
+usize GetPeakResident() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters{};
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return static_cast<usize>(counters.PeakWorkingSetSize);
+  }
+  return 0;
+#else
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<usize>(usage.ru_maxrss);
+#else
+  // kilobytes on Linux
+  return static_cast<usize>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// JSON string contents
+std::string Escape(std::string_view text) {
+  std::string result;
+  result.reserve(text.size());
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      result += fmt::format("\\u{:04x}", c);
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+bool StartsWith(std::string_view text, std::string_view prefix) noexcept {
+  return text.substr(0, prefix.size()) == prefix;
+}
+
+}  // namespace
+
+CameraPath::CameraPath(std::vector<CameraKey> keys) : _keys(std::move(keys)) {
+  std::sort(_keys.begin(), _keys.end(),
+            [](const CameraKey& a, const CameraKey& b) {
+              return a.time < b.time;
+            });
+}
+
+void CameraPath::Apply(Camera& camera, float32 time) const {
+  if (_keys.empty()) {
+    return;
+  }
+
+  auto next = std::upper_bound(
+      _keys.begin(), _keys.end(), time,
+      [](float32 time, const CameraKey& key) { return time < key.time; });
+
+  CameraKey pose;
+  if (next == _keys.begin()) {
+    pose = _keys.front();
+  } else if (next == _keys.end()) {
+    pose = _keys.back();
+  } else {
+    const auto& previous = *(next - 1);
+    float32 t = (time - previous.time) / (next->time - previous.time);
+    pose.position = glm::mix(previous.position, next->position, t);
+    pose.rotation = glm::mix(previous.rotation, next->rotation, t);
+  }
+
+  camera.SetPosition(pose.position);
+  camera.SetRotationDegrees(pose.rotation);
+}
+
+Statistics Statistics::FromSamples(std::vector<float64> samples) {
+  Statistics result;
+  if (samples.empty()) {
+    return result;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  auto rank = [&](float64 percent) {
+    auto index = static_cast<usize>(
+        std::ceil(percent / 100.0 * static_cast<float64>(samples.size())));
+    return samples[std::clamp<usize>(index, 1, samples.size()) - 1];
+  };
+
+  result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) /
+                static_cast<float64>(samples.size());
+  result.p50 = rank(50.0);
+  result.p95 = rank(95.0);
+  result.p99 = rank(99.0);
+  result.max = samples.back();
+  return result;
+}
+
+FrameRecorder::FrameRecorder(usize warmup)
+    : _warmup(std::max<usize>(warmup, gl::TimerQuery::LATENCY)),
+      _frame(0),
+      _start(),
+      _timer(),
+      _cpu(),
+      _gpu(),
+      _drawCalls(),
+      _triangles(),
+      _peakMemory(0) {}
+
+void FrameRecorder::BeginFrame() {
+  auto now = std::chrono::steady_clock::now();
+  // the previous frame is complete now, its stats too
+  if (IsMeasured()) {
+    _cpu.push_back(
+        std::chrono::duration<float64, std::milli>(now - _start).count());
+
+    const auto& stats = gl::RenderStats::Instance();
+    if (stats.GetFrameCount() > 0) {
+      _drawCalls.push_back(static_cast<float64>(stats.GetFrame().drawCalls));
+      _triangles.push_back(static_cast<float64>(stats.GetFrame().triangles));
+    }
+  }
+
+  _start = now;
+  _timer.Begin();
+}
+
+void FrameRecorder::EndFrame(usize memory) {
+  _timer.End();
+  _peakMemory = std::max(_peakMemory, memory);
+
+  _frame++;
+  if (IsMeasured()) {
+    // a frame LATENCY - 1 older than this one
+    _gpu.push_back(_timer.GetMilliseconds());
+  }
+}
+
+void Report::Add(const std::string& group, const Statistics& statistics) {
+  metrics.emplace_back(group + ".mean", statistics.mean);
+  metrics.emplace_back(group + ".p50", statistics.p50);
+  metrics.emplace_back(group + ".p95", statistics.p95);
+  metrics.emplace_back(group + ".p99", statistics.p99);
+  metrics.emplace_back(group + ".max", statistics.max);
+}
+
+const float64* Report::Find(std::string_view metric) const noexcept {
+  for (const auto& [name, value] : metrics) {
+    if (name == metric) {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+std::string Report::ToJson() const {
+  std::string values;
+  for (const auto& [metric, value] : metrics) {
+    if (!values.empty()) {
+      values += ",\n";
+    }
+    values += fmt::format("    \"{}\": {:.6f}", Escape(metric), value);
+  }
+
+  return fmt::format(
+      "{{\n"
+      "  \"benchmark\": \"{}\",\n"
+      "  \"renderer\": \"{}\",\n"
+      "  \"frames\": {},\n"
+      "  \"fixed_delta\": {:.6f},\n"
+      "  \"metrics\": {{\n{}\n  }}\n"
+      "}}\n",
+      Escape(name), Escape(renderer), frames, fixedDelta, values);
+}
+
+Report Report::FromJson(std::string_view json) {
+  Report report;
+
+  auto start = json.find("\"metrics\"");
+  start = start == std::string_view::npos ? start : json.find('{', start);
+  if (start == std::string_view::npos) {
+    throw std::runtime_error("Benchmark report has no metrics");
+  }
+
+  // flat "name": number pairs, as ToJson writes them
+  usize position = start + 1;
+  while (true) {
+    auto quote = json.find_first_of("\"}", position);
+    if (quote == std::string_view::npos) {
+      throw std::runtime_error("Benchmark report metrics are not closed");
+    }
+    if (json[quote] == '}') {
+      break;
+    }
+
+    auto end = json.find('"', quote + 1);
+    auto colon = end == std::string_view::npos ? end : json.find(':', end);
+    if (colon == std::string_view::npos) {
+      throw std::runtime_error("Benchmark report metric has no value");
+    }
+
+    std::string name(json.substr(quote + 1, end - quote - 1));
+    std::string rest(json.substr(colon + 1, 64));
+    char* last = nullptr;
+    float64 value = std::strtod(rest.c_str(), &last);
+    if (last == rest.c_str()) {
+      throw std::runtime_error(
+          fmt::format("Benchmark report metric {} is not a number", name));
+    }
+
+    report.metrics.emplace_back(std::move(name), value);
+    position = colon + 1 + static_cast<usize>(last - rest.c_str());
+  }
+
+  return report;
+}
+
+std::vector<std::string> Compare(const Report& report, const Report& baseline,
+                                 const Tolerance& tolerance) {
+  std::vector<std::string> regressions;
+
+  for (const auto& [metric, expected] : baseline.metrics) {
+    const float64* actual = report.Find(metric);
+    if (actual == nullptr) {
+      regressions.push_back(fmt::format("{}: missing", metric));
+      continue;
+    }
+
+    float64 limit = expected;
+    if (StartsWith(metric, "cpu_ms.") || StartsWith(metric, "gpu_ms.")) {
+      limit = expected * (1.0 + tolerance.time) + TIME_SLACK;
+    } else if (StartsWith(metric, "memory.")) {
+      limit = expected * (1.0 + tolerance.memory);
+    }
+
+    if (*actual > limit) {
+      regressions.push_back(fmt::format(
+          "{}: {:.3f}, baseline {:.3f}, limit {:.3f}", metric, *actual,
+          expected, limit));
+    }
+  }
+
+  return regressions;
+}
+
+void Prepare(const Settings& settings) {
+  auto options = RunOptions::Get();
+  if (options.frames == 0) {
+    options.frames = settings.frames;
+  }
+  options.fixedDelta = settings.delta;
+  RunOptions::Set(std::move(options));
+}
+
+int32 Finish(std::string_view name, const FrameRecorder& recorder) {
+  if (recorder.GetCpu().empty()) {
+    throw std::runtime_error(
+        fmt::format("Benchmark {} ended within its warmup", name));
+  }
+
+  const auto& options = RunOptions::Get();
+
+  Report report;
+  report.name = name;
+  report.renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+  report.frames = recorder.GetCpu().size();
+  report.fixedDelta = options.fixedDelta;
+
+  auto cpu = Statistics::FromSamples(recorder.GetCpu());
+  auto gpu = Statistics::FromSamples(recorder.GetGpu());
+  report.Add("cpu_ms", cpu);
+  report.Add("gpu_ms", gpu);
+  // counted only with OVER_RENDER_STATS. Left out otherwise, a baseline
+  // that has them reports them missing instead of passing on zeros
+  auto drawCalls = Statistics::FromSamples(recorder.GetDrawCalls());
+  auto triangles = Statistics::FromSamples(recorder.GetTriangles());
+#ifdef OVER_RENDER_STATS
+  report.metrics.emplace_back("draw_calls.mean", drawCalls.mean);
+  report.metrics.emplace_back("draw_calls.max", drawCalls.max);
+  report.metrics.emplace_back("triangles.mean", triangles.mean);
+  report.metrics.emplace_back("triangles.max", triangles.max);
+#endif
+  // render targets only, the post chain's included
+  report.metrics.emplace_back(
+      "memory.pool_peak", static_cast<float64>(recorder.GetPeakMemory()));
+  report.metrics.emplace_back("memory.resident_peak",
+                              static_cast<float64>(GetPeakResident()));
+
+  fmt::println("{}, {}, {} frames of {:.3f} ms", report.name, report.renderer,
+               report.frames, report.fixedDelta * 1000.f);
+  fmt::println("cpu ms: mean {:.3f}, p50 {:.3f}, p95 {:.3f}, p99 {:.3f}, "
+               "max {:.3f}",
+               cpu.mean, cpu.p50, cpu.p95, cpu.p99, cpu.max);
+  fmt::println("gpu ms: mean {:.3f}, p50 {:.3f}, p95 {:.3f}, p99 {:.3f}, "
+               "max {:.3f}",
+               gpu.mean, gpu.p50, gpu.p95, gpu.p99, gpu.max);
+  fmt::println("draw calls: {:.0f}, triangles: {:.0f}, pool peak {:.1f} MiB",
+               drawCalls.max, triangles.max,
+               recorder.GetPeakMemory() / (1024.0 * 1024.0));
+
+  std::string path(GetVariable("OVER_REPORT"));
+  if (path.empty()) {
+    path = fmt::format("{}.json", name);
+  }
+  std::ofstream(path) << report.ToJson();
+  fmt::println("report: {}", path);
+
+  std::string baselinePath(GetVariable("OVER_BASELINE"));
+  if (baselinePath.empty()) {
+    return 0;
+  }
+
+  std::ifstream file(baselinePath);
+  if (!file) {
+    throw std::runtime_error(
+        fmt::format("Cannot read baseline {}", baselinePath));
+  }
+  std::stringstream json;
+  json << file.rdbuf();
+
+  Tolerance tolerance;
+  std::string time(GetVariable("OVER_TOLERANCE"));
+  if (!time.empty()) {
+    char* end = nullptr;
+    auto value = std::strtod(time.c_str(), &end);
+    if (end != time.c_str() + time.size() || !(value >= 0.0)) {
+      throw std::runtime_error(
+          fmt::format("OVER_TOLERANCE {} is not a tolerance", time));
+    }
+    tolerance.time = value;
+  }
+
+  auto regressions =
+      Compare(report, Report::FromJson(json.str()), tolerance);
+  for (const auto& regression : regressions) {
+    fmt::println("regression: {}", regression);
+  }
+  fmt::println("baseline {}: {}", baselinePath,
+               regressions.empty() ? "passed" : "failed");
+  return regressions.empty() ? 0 : 1;
+}
+
+}  // namespace over::benchmarks
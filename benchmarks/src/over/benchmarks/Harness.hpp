@@ -0,0 +1,189 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <over/core/Camera.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/TimerQuery.hpp>
+#include <over/core/window/RunOptions.hpp>
+#include <over/engine/App.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::benchmarks {
+
+// Camera pose at a point of the path
+class CameraKey {
+ public:
+  float32 time = 0.f;
+  glm::vec3 position{0.f};
+  // degrees, see Camera::SetRotationDegrees
+  glm::vec3 rotation{0.f};
+};
+
+// Scripted camera flight: linear between keys, held before the first and
+// after the last one
+class CameraPath {
+ public:
+  CameraPath() = default;
+  explicit CameraPath(std::vector<CameraKey> keys);
+
+  void Apply(Camera& camera, float32 time) const;
+
+ private:
+  std::vector<CameraKey> _keys;
+};
+
+class Statistics {
+ public:
+  float64 mean = 0, p50 = 0, p95 = 0, p99 = 0, max = 0;
+
+  // Nearest rank percentiles
+  static Statistics FromSamples(std::vector<float64> samples);
+};
+
+// Frame times and render stats of every frame after the warmup. CPU time is
+// measured from one BeginFrame to the next, so it covers swap and event
+// polling too; GPU time covers the commands between BeginFrame and EndFrame
+// and arrives gl::TimerQuery::LATENCY - 1 frames late
+class FrameRecorder {
+ public:
+  explicit FrameRecorder(usize warmup);
+
+  FrameRecorder(const FrameRecorder&) = delete;
+  FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+  ~FrameRecorder() = default;
+
+  void BeginFrame();
+  // memory: bytes in the app's render target pool this frame
+  void EndFrame(usize memory);
+
+  const std::vector<float64>& GetCpu() const noexcept { return _cpu; }
+  const std::vector<float64>& GetGpu() const noexcept { return _gpu; }
+  const std::vector<float64>& GetDrawCalls() const noexcept {
+    return _drawCalls;
+  }
+  const std::vector<float64>& GetTriangles() const noexcept {
+    return _triangles;
+  }
+  usize GetPeakMemory() const noexcept { return _peakMemory; }
+
+ private:
+  bool IsMeasured() const noexcept { return _frame > _warmup; }
+
+  usize _warmup;
+  usize _frame;
+  std::chrono::steady_clock::time_point _start;
+  gl::TimerQuery _timer;
+
+  std::vector<float64> _cpu;
+  std::vector<float64> _gpu;
+  std::vector<float64> _drawCalls;
+  std::vector<float64> _triangles;
+  usize _peakMemory;
+};
+
+// Results of a run. Metrics are flat "group.statistic" pairs with stable
+// names, lower is better for every one of them
+class Report {
+ public:
+  std::string name;
+  std::string renderer;
+  usize frames = 0;
+  float32 fixedDelta = 0.f;
+  std::vector<std::pair<std::string, float64>> metrics;
+
+  void Add(const std::string& group, const Statistics& statistics);
+  // nullptr if the report has no such metric
+  const float64* Find(std::string_view metric) const noexcept;
+
+  std::string ToJson() const;
+  // Metrics of a report written by ToJson, throws on anything else
+  static Report FromJson(std::string_view json);
+};
+
+// Allowed growth over the baseline: times by `time` (relative) plus 0.05 ms
+// of timer noise, memory by `memory`. Draw calls and triangles must not
+// grow, the path and scene are the same every run
+class Tolerance {
+ public:
+  float64 time = 0.15;
+  float64 memory = 0.05;
+};
+
+// One line per metric worse than the baseline beyond the tolerance
+std::vector<std::string> Compare(const Report& report, const Report& baseline,
+                                 const Tolerance& tolerance);
+
+// Settings of a deterministic run. The environment may override:
+//   OVER_FRAMES     frames (see RunOptions), the backend comes from
+//                   OVER_BACKEND as for every app
+//   OVER_REPORT     JSON report path, <name>.json by default
+//   OVER_BASELINE   report to compare with, no comparison if unset
+//   OVER_TOLERANCE  Tolerance::time
+class Settings {
+ public:
+  uint32 width = 1280, height = 720;
+  usize frames = 600;
+  // frames not measured: shader compilation, pool allocations
+  usize warmup = 60;
+  float32 delta = 1.f / 60.f;
+};
+
+// Drives an App subclass: every Update moves the camera along the path at
+// the simulated time first, then is measured.
+// A needs Camera& GetCamera() and usize GetMemory() (bytes of its render
+// target pool; meshes, instance buffers and frame buffers are not counted)
+template <class A>
+class Benchmarked final : public A {
+ public:
+  template <class... Args>
+  Benchmarked(CameraPath path, usize warmup, Args&&... args)
+      : A(std::forward<Args>(args)...),
+        _path(std::move(path)),
+        _recorder(warmup),
+        _time(0.f) {}
+
+  void Update(float32 dt) override {
+    _path.Apply(A::GetCamera(), _time);
+
+    _recorder.BeginFrame();
+    A::Update(dt);
+    _recorder.EndFrame(A::GetMemory());
+
+    _time += dt;
+  }
+
+  const FrameRecorder& GetRecorder() const noexcept { return _recorder; }
+
+ private:
+  CameraPath _path;
+  FrameRecorder _recorder;
+  float32 _time;
+};
+
+// Applies the settings to RunOptions, before any context exists
+void Prepare(const Settings& settings);
+// Writes the report of the finished run and compares it to the baseline.
+// Needs the context of the run. Returns the exit code: 1 on regressions
+int32 Finish(std::string_view name, const FrameRecorder& recorder);
+
+// Runs A for the frames of the settings and reports, see Finish
+template <class A, class... Args>
+int32 Run(std::string_view name, CameraPath path, const Settings& settings,
+          Args&&... args) {
+  Prepare(settings);
+
+  Benchmarked<A> app(std::move(path), settings.warmup,
+                     std::forward<Args>(args)...);
+  app.Run(static_cast<int32>(settings.width),
+          static_cast<int32>(settings.height));
+  return Finish(name, app.GetRecorder());
+}
+
+}  // namespace over::benchmarks
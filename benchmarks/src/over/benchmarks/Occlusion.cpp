@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <over/core/Bounds.hpp>
+#include <over/core/Camera.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/culling/FrustumCuller.hpp>
+#include <over/core/culling/OcclusionBuffer.hpp>
+
+#include <fmt/core.h>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+// City of BLOCKS x BLOCKS buildings split by streets, props everywhere
+constexpr usize BLOCKS = 48;
+constexpr float32 BLOCK_SIZE = 24.f;
+constexpr float32 STREET_WIDTH = 8.f;
+constexpr usize PROPS = 200'000;
+
+constexpr uint32 WIDTH = 512;
+constexpr uint32 HEIGHT = 256;
+constexpr usize ITERATIONS = 100;
+
+template <class F>
+static float64 Measure(F&& func) {
+  auto start = std::chrono::steady_clock::now();
+  for (usize i = 0; i < ITERATIONS; i++) {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<float64>(end - start).count() / ITERATIONS;
+}
+
+static void Run() {
+  std::mt19937 random(42);
+  std::uniform_real_distribution<float32> height(8.f, 80.f);
+  std::uniform_real_distribution<float32> margin(0.f, 3.f);
+
+  constexpr float32 pitch = BLOCK_SIZE + STREET_WIDTH;
+  constexpr float32 extent = BLOCKS * pitch;
+
+  std::vector<culling::Occluder> buildings;
+  buildings.reserve(BLOCKS * BLOCKS);
+  for (usize z = 0; z < BLOCKS; z++) {
+    for (usize x = 0; x < BLOCKS; x++) {
+      glm::vec3 min(x * pitch + margin(random), 0.f, z * pitch + margin(random));
+      glm::vec3 max(x * pitch + BLOCK_SIZE - margin(random), height(random),
+                    z * pitch + BLOCK_SIZE - margin(random));
+      buildings.push_back(culling::Occluder::FromBox(AABB(min, max)));
+    }
+  }
+
+  std::uniform_real_distribution<float32> position(0.f, extent);
+  std::uniform_real_distribution<float32> size(0.3f, 2.f);
+
+  std::vector<AABB> props;
+  culling::BoundsSoA bounds;
+  props.reserve(PROPS);
+  bounds.Reserve(PROPS);
+  for (usize i = 0; i < PROPS; i++) {
+    glm::vec3 extents(size(random), size(random), size(random));
+    glm::vec3 center(position(random), extents.y, position(random));
+    props.emplace_back(center - extents, center + extents);
+    bounds.Add(props.back());
+  }
+
+  // street level, in the middle of a street, looking across the city
+  glm::vec3 eye(BLOCKS / 2 * pitch - STREET_WIDTH / 2, 2.f, extent - 4.f);
+  Camera camera(eye, {0.f, 0.35f, 0.f}, 1.f, glm::radians(60.f),
+                16.f / 9.f);
+
+  std::vector<uint32> candidates;
+  std::vector<uint32> visible;
+  candidates.reserve(PROPS);
+  visible.reserve(PROPS);
+  culling::FrustumCuller::Cull(camera.GetFrustum(), bounds, candidates);
+
+  fmt::println(
+      "occlusion culling, {} buildings, {} props, {}x{} buffer, {}, {} "
+      "iterations",
+      buildings.size(), PROPS, WIDTH, HEIGHT,
+      culling::OcclusionBuffer::GetInstructionSet(), ITERATIONS);
+
+  culling::OcclusionBuffer buffer(WIDTH, HEIGHT);
+  auto render = [&] {
+    buffer.Begin(camera);
+    for (const auto& building : buildings) {
+      buffer.Add(building, glm::mat4(1.f));
+    }
+    buffer.Render();
+  };
+
+  std::vector<usize> threads = {1};
+  if (std::thread::hardware_concurrency() > 1) {
+    threads.push_back(std::thread::hardware_concurrency());
+  }
+
+  for (auto count : threads) {
+    buffer.SetThreads(count);
+    auto seconds = Measure(render);
+    fmt::println("{:>8}: {:8.3f} ms/frame, {} threads, {} triangles", "Render",
+                 seconds * 1000.0, buffer.GetThreads(),
+                 buffer.GetTriangleCount());
+  }
+
+  usize count = 0;
+  auto test = Measure([&] {
+    visible.clear();
+    count = buffer.Cull(props, candidates, visible);
+  });
+  fmt::println("{:>8}: {:8.3f} ms/frame, {:8.1f} Mboxes/s", "Test",
+               test * 1000.0, candidates.size() / test / 1e6);
+  fmt::println("{:>8}: {} in frustum, {} visible, {:.1f}% occluded", "Props",
+               candidates.size(), count,
+               100.0 * (candidates.size() - count) /
+                   std::max<usize>(candidates.size(), 1));
+}
+
+}  // namespace over
+
+int main() {
+  over::Run();
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <over/core/Bounds.hpp>
+#include <over/core/MeshBVH.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/IBO.hpp>
+#include <over/core/opengl/VBO.hpp>
+
+#include <fmt/core.h>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+constexpr usize GRID = 512;  // terrain cells per side, 2 triangles per cell
+constexpr usize RAYS = 1'000'000;
+
+static float32 Height(float32 x, float32 z) {
+  return 4.f * std::sin(x * 0.05f) * std::cos(z * 0.07f) +
+         std::sin(x * 0.31f + z * 0.17f);
+}
+
+static void Run() {
+  std::vector<Vertex> vertices;
+  std::vector<Element> elements;
+  vertices.reserve((GRID + 1) * (GRID + 1));
+  elements.reserve(GRID * GRID * 2);
+
+  for (usize z = 0; z <= GRID; z++) {
+    for (usize x = 0; x <= GRID; x++) {
+      auto fx = static_cast<float32>(x);
+      auto fz = static_cast<float32>(z);
+      vertices.emplace_back(glm::vec3(fx, Height(fx, fz), fz),
+                            glm::vec3(0, 1, 0), glm::vec2(0));
+    }
+  }
+
+  for (usize z = 0; z < GRID; z++) {
+    for (usize x = 0; x < GRID; x++) {
+      auto i = static_cast<uint32>(z * (GRID + 1) + x);
+      auto row = static_cast<uint32>(GRID + 1);
+      elements.emplace_back(i, i + row, i + 1);
+      elements.emplace_back(i + 1, i + row, i + row + 1);
+    }
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  MeshBVH bvh(vertices, elements);
+  auto built = std::chrono::steady_clock::now();
+
+  fmt::println("triangle BVH, {} triangles, build {:.1f} ms, {}",
+               elements.size(),
+               std::chrono::duration<float64, std::milli>(built - start).count(),
+               MeshBVH::GetInstructionSet());
+
+  // rays from above the terrain in random directions down
+  std::mt19937 random(7);
+  std::uniform_real_distribution<float32> position(0.f, GRID);
+  std::uniform_real_distribution<float32> spread(-1.f, 1.f);
+
+  std::vector<Ray> rays;
+  rays.reserve(RAYS);
+  for (usize i = 0; i < RAYS; i++) {
+    glm::vec3 origin(position(random), 20.f, position(random));
+    glm::vec3 direction(spread(random), -1.f, spread(random));
+    rays.emplace_back(origin, glm::normalize(direction));
+  }
+
+  usize hits = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto& ray : rays) {
+    hits += bvh.Raycast(ray) ? 1 : 0;
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto seconds = std::chrono::duration<float64>(end - start).count();
+  fmt::println("{:>8}: {:8.2f} Mrays/s, hits: {}", "Closest", RAYS / seconds / 1e6,
+               hits);
+
+  usize occluded = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto& ray : rays) {
+    occluded += bvh.Occluded(ray, 30.f) ? 1 : 0;
+  }
+  end = std::chrono::steady_clock::now();
+  seconds = std::chrono::duration<float64>(end - start).count();
+  fmt::println("{:>8}: {:8.2f} Mrays/s, hits: {}", "Any", RAYS / seconds / 1e6,
+               occluded);
+}
+
+}  // namespace over
+
+int main() {
+  over::Run();
+  return 0;
+}
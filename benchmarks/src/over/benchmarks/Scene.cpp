@@ -0,0 +1,228 @@
+#include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <over/benchmarks/Harness.hpp>
+#include <over/core/Camera.hpp>
+#include <over/core/Mesh.hpp>
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/graph/RenderGraph.hpp>
+#include <over/core/opengl/InstanceBuffer.hpp>
+#include <over/core/post/Effect.hpp>
+#include <over/core/post/PostChain.hpp>
+#include <over/engine/App.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace over {
+
+// 64x64 cubes, one instanced draw per 16x16 tile
+constexpr usize GRID = 64;
+constexpr usize TILE = 16;
+constexpr float32 SPACING = 3.f;
+
+constexpr std::string_view VERTEX_SOURCE = R"(#version 330 core
+
+layout (location = 0) in vec3 vPosition;
+layout (location = 1) in vec3 vNormal;
+layout (location = 3) in mat4 iModel;
+layout (location = 7) in vec4 iColor;
+
+uniform mat4 viewProjection;
+uniform float time;
+
+out vec3 fNormal;
+out vec4 fColor;
+
+void main() {
+	vec4 world = iModel * vec4(vPosition, 1.0);
+	world.y += sin(time + iModel[3].x * 0.1 + iModel[3].z * 0.1);
+	gl_Position = viewProjection * world;
+	fNormal = mat3(iModel) * vNormal;
+	fColor = iColor;
+}
+)";
+
+constexpr std::string_view FRAGMENT_SOURCE = R"(#version 330 core
+
+out vec4 FragColor;
+
+in vec3 fNormal;
+in vec4 fColor;
+
+uniform vec3 lightDirection;
+
+void main() {
+	float diffuse = max(dot(normalize(fNormal), -lightDirection), 0.0);
+	FragColor = vec4(fColor.rgb * (0.2 + 2.0 * diffuse), 1.0);
+}
+)";
+
+static Mesh GenCube() {
+  std::vector<Vertex> vertices;
+  std::vector<Element> elements;
+
+  // a face per axis direction, 4 vertices each for flat normals
+  for (int32 axis = 0; axis < 3; axis++) {
+    for (float32 sign : {-1.f, 1.f}) {
+      glm::vec3 normal(0.f);
+      normal[axis] = sign;
+      glm::vec3 u(0.f), v(0.f);
+      u[(axis + 1) % 3] = 1.f;
+      v[(axis + 2) % 3] = sign;
+
+      auto first = static_cast<uint32>(vertices.size());
+      vertices.emplace_back(normal - u - v, normal, glm::vec2(0.f, 0.f));
+      vertices.emplace_back(normal + u - v, normal, glm::vec2(1.f, 0.f));
+      vertices.emplace_back(normal + u + v, normal, glm::vec2(1.f, 1.f));
+      vertices.emplace_back(normal - u + v, normal, glm::vec2(0.f, 1.f));
+      elements.emplace_back(first, first + 1, first + 2);
+      elements.emplace_back(first + 2, first + 3, first);
+    }
+  }
+
+  return Mesh(std::move(vertices), std::move(elements), {});
+}
+
+// Fixed scene for the harness: instanced cubes into a pooled HDR target,
+// then tone mapping, FXAA and gamma through the post chain
+class SceneApp : public App {
+ public:
+  SceneApp()
+      : App("scene-benchmark"),
+        _camera(glm::vec3(0.f), glm::vec3(0.f), 0.f, glm::radians(60.f),
+                16.f / 9.f),
+        _shader(),
+        _cube(),
+        _tiles(),
+        _graph(),
+        _chain(nullptr),
+        _time(0.f) {}
+
+  void Init() override {
+    _shader = Shader::FromSource(VERTEX_SOURCE, FRAGMENT_SOURCE);
+    _cube = GenCube();
+
+    // seeded, every run draws the same scene
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float32> height(0.5f, 4.f);
+    std::uniform_real_distribution<float32> channel(0.2f, 1.f);
+
+    constexpr usize tiles = GRID / TILE;
+    std::vector<std::vector<over::Instance>> instances(tiles * tiles);
+    for (usize x = 0; x < GRID; x++) {
+      for (usize z = 0; z < GRID; z++) {
+        glm::vec3 position((x - GRID / 2.f) * SPACING, 0.f,
+                           (z - GRID / 2.f) * SPACING);
+        auto model = glm::translate(glm::mat4(1.f), position);
+        model = glm::scale(model, glm::vec3(1.f, height(random), 1.f));
+        glm::vec4 color(channel(random), channel(random), channel(random), 1.f);
+
+        instances[(x / TILE) * tiles + z / TILE].emplace_back(model, color, 0);
+      }
+    }
+    // animated in the vertex shader, uploaded once
+    for (auto& tile : instances) {
+      _tiles.emplace_back(std::move(tile), GL_STATIC_DRAW);
+      _tiles.back().ToGPU(true);
+    }
+
+    _chain = std::make_unique<post::PostChain>(nullptr);
+    _chain->Add(post::Effect::ToneMap());
+    _chain->Add(post::Effect::Fxaa());
+    _chain->Add(post::Effect::Gamma());
+  }
+
+  void Update(float32 dt) override {
+    _time += dt;
+
+    auto [width, height] = _window.GetSize();
+    _camera.SetAspectRatio(width * 1.f / height);
+    BuildGraph(width, height);
+    _graph.Execute();
+  }
+
+  Camera& GetCamera() noexcept { return _camera; }
+  usize GetMemory() noexcept { return _graph.GetPool().GetMemory(); }
+
+ private:
+  void BuildGraph(uint32 width, uint32 height) {
+    _graph.Reset(width, height);
+
+    graph::TextureDesc colorDesc;
+    colorDesc.format = GL_RGBA16F;
+    graph::TextureDesc depthDesc;
+    depthDesc.format = GL_DEPTH24_STENCIL8;
+    depthDesc.renderBuffer = true;
+
+    auto color = _graph.Create("color", colorDesc);
+    auto depth = _graph.Create("depth", depthDesc);
+    auto backBuffer = _graph.ImportBackBuffer();
+
+    _graph.AddPass(
+        "scene",
+        [&](graph::PassBuilder& builder) {
+          builder.Write(color, GL_COLOR_ATTACHMENT0);
+          builder.Write(depth, GL_DEPTH_STENCIL_ATTACHMENT);
+        },
+        [this](graph::PassContext&) { RenderScene(); });
+
+    _graph.AddPass(
+        "post",
+        [&](graph::PassBuilder& builder) {
+          builder.Read(color);
+          builder.Write(backBuffer);
+        },
+        [this, color](graph::PassContext& context) {
+          _chain->Execute(_graph.GetPool(), context.GetTexture(color),
+                          glm::ivec2(context.GetWidth(), context.GetHeight()));
+        });
+
+    _graph.Compile();
+  }
+
+  void RenderScene() {
+    _ctx.SetDepthTest(true);
+    _ctx.SetFaceCulling(true);
+    _ctx.SetClearColor(glm::vec4(0.05f, 0.05f, 0.08f, 1.f));
+    _ctx.ClearAll();
+
+    _shader.Use([&] {
+      _shader.SetMatrix4f("viewProjection", _camera.GetViewProjection());
+      _shader.SetFloat("time", _time);
+      _shader.SetVec3f("lightDirection",
+                       glm::normalize(glm::vec3(-0.4f, -1.f, -0.3f)));
+      for (auto& tile : _tiles) {
+        _cube.DrawInstanced(_shader, tile);
+      }
+    });
+  }
+
+  Camera _camera;
+  Shader _shader;
+  Mesh _cube;
+  std::vector<InstanceBuffer> _tiles;
+  graph::RenderGraph _graph;
+  std::unique_ptr<post::PostChain> _chain;
+  float32 _time;
+};
+
+}  // namespace over
+
+int main() {
+  using namespace over;
+
+  // a flight over the grid, then down between the cubes, 10 s
+  benchmarks::CameraPath path({
+      {0.f, glm::vec3(0.f, 60.f, 120.f), glm::vec3(-25.f, 0.f, 0.f)},
+      {3.f, glm::vec3(80.f, 40.f, 80.f), glm::vec3(-20.f, 45.f, 0.f)},
+      {6.f, glm::vec3(80.f, 10.f, -40.f), glm::vec3(-5.f, 120.f, 0.f)},
+      {10.f, glm::vec3(0.f, 4.f, 0.f), glm::vec3(0.f, 270.f, 0.f)},
+  });
+
+  return benchmarks::Run<SceneApp>("scene", std::move(path),
+                                   benchmarks::Settings());
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <over/core/Bounds.hpp>
+#include <over/core/Frustum.hpp>
+#include <over/core/Types.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+// 32 bytes: internal node has count == 0 and children at
+// leftOrFirst, leftOrFirst + 1; leaf owns indices [leftOrFirst, +count)
+class BVHNode {
+ public:
+  glm::vec3 min;
+  uint32 leftOrFirst;
+  glm::vec3 max;
+  uint32 count;
+
+  bool IsLeaf() const noexcept { return count != 0; }
+  AABB GetBounds() const noexcept { return AABB(min, max); }
+};
+
+static_assert(sizeof(BVHNode) == 32);
+
+// Hierarchy over primitive boxes, built with binned SAH. Moved primitives
+// are refitted every Update, the tree is rebuilt every few updates
+class BVH {
+ public:
+  static constexpr uint32 NONE = std::numeric_limits<uint32>::max();
+
+  static constexpr usize BINS = 12;
+  static constexpr uint32 MAX_LEAF_SIZE = 8;
+  // Bounds traversal stack size
+  static constexpr uint32 MAX_DEPTH = 64;
+  // Subtrees with more primitives are built on their own thread
+  static constexpr uint32 PARALLEL_THRESHOLD = 1 << 13;
+
+  class Hit {
+   public:
+    uint32 primitive = NONE;
+    float32 distance = std::numeric_limits<float32>::infinity();
+
+    explicit operator bool() const noexcept { return primitive != NONE; }
+  };
+
+  BVH();
+
+  BVH(const BVH&) = default;
+  BVH& operator=(const BVH&) = default;
+
+  BVH(BVH&&) noexcept = default;
+  BVH& operator=(BVH&&) noexcept = default;
+
+  ~BVH() = default;
+
+  // Primitive i is bounds[i]
+  void Build(std::vector<AABB> bounds);
+  void Build();
+
+  usize Size() const noexcept { return _bounds.size(); }
+  bool IsEmpty() const noexcept { return _nodes.empty(); }
+
+  const AABB& GetBounds(uint32 primitive) const noexcept {
+    return _bounds[primitive];
+  }
+  // Marks the primitive for the next Refit
+  void SetBounds(uint32 primitive, const AABB& box);
+
+  // Grows or shrinks the leaves of moved primitives and their ancestors
+  void Refit();
+  // Refit, and rebuild once per rebuild interval if anything moved
+  void Update();
+
+  uint32 GetRebuildInterval() const noexcept { return _rebuildInterval; }
+  void SetRebuildInterval(uint32 updates) noexcept {
+    _rebuildInterval = updates;
+  }
+
+  // Expected traversal cost, grows while refits degrade the tree
+  float32 GetCost() const noexcept;
+
+  const std::vector<BVHNode>& GetNodes() const noexcept { return _nodes; }
+  const std::vector<uint32>& GetIndices() const noexcept { return _indices; }
+
+  // Append primitives overlapping the volume, return appended count
+  usize Query(const Frustum& frustum, std::vector<uint32>& result) const;
+  usize Query(const Sphere& sphere, std::vector<uint32>& result) const;
+  usize Query(const AABB& box, std::vector<uint32>& result) const;
+
+  // Closest primitive box to the point
+  Hit Nearest(glm::vec3 point,
+              float32 maxDistance =
+                  std::numeric_limits<float32>::infinity()) const noexcept;
+
+  // Closest primitive box along the ray
+  Hit Raycast(const Ray& ray,
+              float32 maxDistance =
+                  std::numeric_limits<float32>::infinity()) const noexcept;
+
+  // Closest exact hit: intersect(primitive, distance) tests the primitive
+  // and lowers distance when it is hit closer, returns true on hit
+  template <class F>
+  Hit Raycast(const Ray& ray, float32 maxDistance, F&& intersect) const;
+
+  // Visits leaves along the ray, near first: leaf(node, distance) tests
+  // primitives of the leaf, lowers distance and returns the hit primitive
+  // or NONE. With anyHit traversal stops at the first hit
+  template <class F>
+  Hit RaycastLeaves(const Ray& ray, float32 maxDistance, F&& leaf,
+                    bool anyHit = false) const;
+
+ private:
+  // Slab test inlined into traversal loops
+  static bool IntersectNode(const BVHNode& node, const Ray& ray,
+                            float32 maxDistance, float32& entry) noexcept;
+
+  void Subdivide(uint32 node, uint32 depth, std::atomic<uint32>& used);
+  void Finalize();
+  void FitNode(uint32 node) noexcept;
+
+  std::vector<AABB> _bounds;
+  std::vector<glm::vec3> _centroids;
+
+  std::vector<BVHNode> _nodes;
+  std::vector<uint32> _indices;
+  std::vector<uint32> _parents;
+  std::vector<uint32> _leaves;  // primitive -> leaf
+
+  std::vector<uint32> _moved;  // leaves waiting for refit
+  std::vector<uint8> _movedFlags;
+
+  uint32 _rebuildInterval;
+  uint32 _updates;
+  bool _changed;
+};
+
+inline bool BVH::IntersectNode(const BVHNode& node, const Ray& ray,
+                              float32 maxDistance, float32& entry) noexcept {
+  float32 enter = 0.f;
+  float32 exit = maxDistance;
+  for (int32 axis = 0; axis < 3; axis++) {
+    float32 inverse = ray.inverseDirection[axis];
+    float32 t0 = (node.min[axis] - ray.origin[axis]) * inverse;
+    float32 t1 = (node.max[axis] - ray.origin[axis]) * inverse;
+    enter = std::max(enter, std::min(t0, t1));
+    exit = std::min(exit, std::max(t0, t1));
+  }
+  entry = enter;
+  return enter <= exit;
+}
+
+template <class F>
+BVH::Hit BVH::Raycast(const Ray& ray, float32 maxDistance,
+                      F&& intersect) const {
+  return RaycastLeaves(
+      ray, maxDistance, [&](const BVHNode& node, float32& distance) {
+        uint32 result = NONE;
+        for (uint32 i = 0; i < node.count; i++) {
+          uint32 primitive = _indices[node.leftOrFirst + i];
+          if (intersect(primitive, distance)) {
+            result = primitive;
+          }
+        }
+        return result;
+      });
+}
+
+template <class F>
+BVH::Hit BVH::RaycastLeaves(const Ray& ray, float32 maxDistance, F&& leaf,
+                            bool anyHit) const {
+  Hit hit;
+  hit.distance = maxDistance;
+  if (_nodes.empty()) {
+    return hit;
+  }
+
+  float32 entry;
+  if (!IntersectNode(_nodes[0], ray, hit.distance, entry)) {
+    return hit;
+  }
+
+  uint32 stack[MAX_DEPTH];
+  float32 entries[MAX_DEPTH];
+  uint32 size = 0;
+  stack[size] = 0;
+  entries[size++] = entry;
+
+  while (size > 0) {
+    size--;
+    // closer hit was found after the node was pushed
+    if (entries[size] > hit.distance) {
+      continue;
+    }
+
+    const auto& node = _nodes[stack[size]];
+
+    if (node.IsLeaf()) {
+      uint32 primitive = leaf(node, hit.distance);
+      if (primitive != NONE) {
+        hit.primitive = primitive;
+        if (anyHit) {
+          return hit;
+        }
+      }
+      continue;
+    }
+
+    // push far child first, so the near one is visited first
+    uint32 left = node.leftOrFirst;
+    uint32 right = left + 1;
+    float32 leftEntry, rightEntry;
+    bool leftHit = IntersectNode(_nodes[left], ray, hit.distance, leftEntry);
+    bool rightHit =
+        IntersectNode(_nodes[right], ray, hit.distance, rightEntry);
+
+    if (leftHit && rightHit) {
+      if (leftEntry > rightEntry) {
+        std::swap(left, right);
+        std::swap(leftEntry, rightEntry);
+      }
+      stack[size] = right;
+      entries[size++] = rightEntry;
+      stack[size] = left;
+      entries[size++] = leftEntry;
+    } else if (leftHit) {
+      stack[size] = left;
+      entries[size++] = leftEntry;
+    } else if (rightHit) {
+      stack[size] = right;
+      entries[size++] = rightEntry;
+    }
+  }
+
+  return hit;
+}
+
+}  // namespace over
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+
+#include <over/core/Types.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+class Vertex;
+class Sphere;
+class Ray;
+
+// Axis aligned bounding box, empty box has min > max
+class AABB {
+ public:
+  glm::vec3 min;
+  glm::vec3 max;
+
+  AABB();
+  AABB(glm::vec3 min, glm::vec3 max);
+
+  static AABB FromVertices(const std::vector<Vertex>& vertices);
+
+  bool IsEmpty() const noexcept;
+
+  glm::vec3 GetCenter() const noexcept { return (min + max) * 0.5f; }
+  glm::vec3 GetExtents() const noexcept { return (max - min) * 0.5f; }
+
+  void Expand(glm::vec3 point) noexcept;
+  void Expand(const AABB& other) noexcept;
+
+  // Box of the transformed box (Arvo), not the tightest box of the mesh
+  AABB Transformed(const glm::mat4& matrix) const noexcept;
+
+  float32 GetSurfaceArea() const noexcept;
+  // Zero inside the box
+  float32 GetDistance(glm::vec3 point) const noexcept;
+
+  bool Intersects(const AABB& other) const noexcept;
+  bool Intersects(const Sphere& sphere) const noexcept;
+  // Slab test, distance is entry distance along the ray (0 if inside)
+  bool Intersects(const Ray& ray, float32 maxDistance,
+                  float32& distance) const noexcept;
+};
+
+class Sphere {
+ public:
+  glm::vec3 center;
+  float32 radius;
+
+  Sphere();
+  Sphere(glm::vec3 center, float32 radius);
+
+  // Centered at box center, radius covers all vertices
+  static Sphere FromVertices(const std::vector<Vertex>& vertices,
+                             const AABB& bounds);
+
+  Sphere Transformed(const glm::mat4& matrix) const noexcept;
+};
+
+// Direction is not normalized by transforms, so distances measured
+// along a transformed ray stay in the space of the original ray
+class Ray {
+ public:
+  glm::vec3 origin;
+  glm::vec3 direction;
+  glm::vec3 inverseDirection;
+
+  Ray();
+  Ray(glm::vec3 origin, glm::vec3 direction);
+
+  glm::vec3 At(float32 distance) const noexcept {
+    return origin + direction * distance;
+  }
+
+  Ray Transformed(const glm::mat4& matrix) const noexcept;
+};
+
+}  // namespace over
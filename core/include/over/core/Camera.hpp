@@ -1,11 +1,42 @@
 #pragma once
 
+#include <over/core/Bounds.hpp>
+#include <over/core/Frustum.hpp>
 #include <over/core/Includes.hpp>
 #include <over/core/Types.hpp>
 
 #include <glm/glm.hpp>
 
 namespace over {
+
+// Everything derived from camera state, computed once per change
+struct CameraSnapshot {
+  // inputs the snapshot was built from
+  glm::vec3 position;
+  glm::vec3 rotation;
+  glm::vec3 worldUp;
+  float32 fov;
+  float32 aspectRatio;
+  float32 zNear;
+  float32 zFar;
+
+  // orientation basis
+  glm::vec3 direction;
+  glm::vec3 right;
+  glm::vec3 up;
+
+  glm::mat4 view;
+  glm::mat4 projection;
+  glm::mat4 viewProjection;
+
+  glm::mat4 inverseView;
+  glm::mat4 inverseProjection;
+  glm::mat4 inverseViewProjection;
+
+  // World space planes of the view-projection
+  Frustum frustum;
+};
+
 class Camera {
  public:
   Camera(glm::vec3 position, glm::vec3 rotation, float32 speed, float32 fov,
@@ -19,11 +50,27 @@ class Camera {
                                       bool flush = false);
   void Camera::UpdateFOVCallback(float32 yoffset);
 
-  glm::mat4 GetView() const noexcept;
-  glm::mat4 GetProjection() const noexcept;
+  // Cached, rebuilt on first access after position, rotation, up, FOV or
+  // aspect ratio changed. Copy it to keep values of one frame
+  const CameraSnapshot& GetSnapshot() const noexcept;
+
+  const glm::mat4& GetView() const noexcept { return GetSnapshot().view; }
+  const glm::mat4& GetProjection() const noexcept {
+    return GetSnapshot().projection;
+  }
+  const glm::mat4& GetViewProjection() const noexcept {
+    return GetSnapshot().viewProjection;
+  }
+  // World space planes of the view-projection
+  const Frustum& GetFrustum() const noexcept { return GetSnapshot().frustum; }
+  // World space ray through the point in normalized device coordinates
+  Ray GetRay(glm::vec2 ndc) const noexcept;
 
   glm::vec3 GetPosition() const noexcept { return _position; }
-  glm::vec3 GetDirection() const noexcept;
+  void SetPosition(glm::vec3 position) noexcept { _position = position; }
+  glm::vec3 GetDirection() const noexcept {
+    return GetSnapshot().direction;
+  }
 
   glm::vec3 GetRotation() const noexcept { return _rotation; }
   glm::vec3 GetRotationDegrees() const noexcept {
@@ -38,6 +85,7 @@ class Camera {
 
   float32 GetFovDegrees() const noexcept { return glm::degrees(_fov); }
   float32 GetFov() const noexcept { return _fov; }
+  void SetFov(float32 fov) noexcept { _fov = fov; }
 
   float32 GetAspectRation() const noexcept { return _aspectRatio; }
   void SetAspectRatio(float32 aspectRatio) noexcept {
@@ -50,6 +98,8 @@ class Camera {
  private:
   static glm::vec3 up;
 
+  glm::vec3 ComputeDirection() const noexcept;
+
   glm::vec3 _position;
   glm::vec3 _rotation;
   float32 _speed;
@@ -59,5 +109,8 @@ class Camera {
   float32 _fov;
 
   float32 _near, _far;
+
+  mutable CameraSnapshot _snapshot;
+  mutable bool _snapshotValid;
 };
 }  // namespace over
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+
+#include <over/core/Bounds.hpp>
+#include <over/core/Types.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+// Six planes (xyz - inward normal, w - distance) in world space
+class Frustum {
+ public:
+  // not NEAR/FAR: those are macros in windows headers
+  enum Plane : usize { LEFT = 0, RIGHT, BOTTOM, TOP, Z_NEAR, Z_FAR, COUNT };
+
+  Frustum();
+
+  // Gribb-Hartmann extraction, works with infinite projection
+  // (degenerate far plane is replaced with "always inside")
+  static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+  const std::array<glm::vec4, COUNT>& GetPlanes() const noexcept {
+    return _planes;
+  }
+  const glm::vec4& GetPlane(Plane plane) const noexcept {
+    return _planes[plane];
+  }
+
+  bool Intersects(const AABB& box) const noexcept;
+  bool Intersects(const Sphere& sphere) const noexcept;
+
+ private:
+  std::array<glm::vec4, COUNT> _planes;
+};
+
+}  // namespace over
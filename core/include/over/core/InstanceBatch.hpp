@@ -0,0 +1,48 @@
+#pragma once
+
+#include <over/core/Model.hpp>
+#include <over/core/Shader.hpp>
+#include <over/core/Transform.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/InstanceBuffer.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+// Collects copies of one model and draws them with one call per mesh.
+// Vertex shader reads the instance streams from Mesh::INSTANCE_*_LOCATION,
+// model uniform of the model holds node transform of the drawn mesh
+class InstanceBatch {
+ public:
+  explicit InstanceBatch(Model& model);
+
+  InstanceBatch(const InstanceBatch&) = delete;
+  InstanceBatch& operator=(const InstanceBatch&) = delete;
+
+  InstanceBatch(InstanceBatch&&) noexcept = default;
+  InstanceBatch& operator=(InstanceBatch&&) noexcept = default;
+
+  ~InstanceBatch() = default;
+
+  void Reserve(usize count);
+  void Add(const Transform& transform, glm::vec4 color = glm::vec4(1),
+           uint32 material = 0);
+  void Add(const glm::mat4& model, glm::vec4 color = glm::vec4(1),
+           uint32 material = 0);
+  void Clear() noexcept;
+
+  // Uploads collected instances once, then draws every mesh of the model
+  void Draw(Shader& shader);
+  void Draw();
+
+  usize Size() const noexcept { return _instances.Size(); }
+  InstanceBuffer& GetInstances() noexcept { return _instances; }
+
+ private:
+  Model* _model;
+  InstanceBuffer _instances;
+  bool _dirty;
+};
+
+}  // namespace over
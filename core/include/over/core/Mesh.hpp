@@ -1,17 +1,23 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include <glm/glm.hpp>
 
+#include <over/core/Bounds.hpp>
 #include <over/core/Includes.hpp>
+#include <over/core/MeshBVH.hpp>
 #include <over/core/Shader.hpp>
 #include <over/core/Types.hpp>
+#include <over/core/opengl/DrawCommand.hpp>
 #include <over/core/opengl/IBO.hpp>
+#include <over/core/opengl/InstanceBuffer.hpp>
 #include <over/core/opengl/VAO.hpp>
 #include <over/core/opengl/VBO.hpp>
 #include <over/core/opengl/targets/TextureTarget.hpp>
 #include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/opengl/wrappers/BufferWrapper.hpp>
 
 namespace over {
 
@@ -38,6 +44,11 @@ class MeshTexture {
 
 class Mesh {
  public:
+  // Vertex shader locations of per-instance attributes (see Instance)
+  static constexpr uint32 INSTANCE_MODEL_LOCATION = 3;  // mat4: 3, 4, 5, 6
+  static constexpr uint32 INSTANCE_COLOR_LOCATION = 7;
+  static constexpr uint32 INSTANCE_MATERIAL_LOCATION = 8;
+
   Mesh() = default;
   Mesh(std::vector<Vertex> vertices, std::vector<Element> elements,
        std::vector<MeshTexture> textures);
@@ -54,6 +65,20 @@ class Mesh {
   void Draw(Shader& shader, int32 count = 1);
   void Draw(int32 count = 1);
 
+  // Binds instance attribute streams to this mesh layout,
+  // no-op if the same buffer is already attached
+  void AttachInstances(const InstanceBuffer& instances);
+  void DrawInstanced(Shader& shader, const InstanceBuffer& instances);
+  // Arguments are read at offset of the bound DRAW_INDIRECT_BUFFER
+  void DrawIndirect(Shader& shader, const InstanceBuffer& instances,
+                    usize offset = 0);
+  // Whole mesh, one instance
+  gl::DrawElementsCommand GetDrawCommand() const noexcept;
+
+  // Depth-only passes: position stream at location 0, no normals, texture
+  // coordinates or textures. The stream is uploaded on first use
+  void DrawDepth(int32 count = 1);
+
   VBO& GetVBO() noexcept { return _vbo; }
   const VBO& GetVBO() const noexcept { return _vbo; }
 
@@ -62,16 +87,43 @@ class Mesh {
 
   std::vector<MeshTexture>& GetTextures() noexcept { return _textures; }
 
+  // Local space bounds, computed from VBO vertices on construction
+  const AABB& GetBounds() const noexcept { return _bounds; }
+  const Sphere& GetBoundingSphere() const noexcept { return _sphere; }
+  // Call after editing VBO vertices on the CPU side, drops the triangle BVH
+  // and the position stream
+  void UpdateBounds();
+
+  // Triangle hierarchy over VBO vertices and IBO elements, built on first use
+  const MeshBVH& GetBVH();
+  // Closest triangle, ray in mesh local space
+  TriangleHit Raycast(const Ray& ray,
+                      float32 maxDistance =
+                          std::numeric_limits<float32>::infinity());
+
   static Mesh GenQuad(std::vector<MeshTexture> textures);
 
  private:
   void Setup();
+  void SetupPositions();
+  void CountDraw(int32 count) const noexcept;
 
   std::vector<MeshTexture> _textures;
 
   VAO _vao;
   VBO _vbo;
   IBO _ibo;
+
+  AABB _bounds;
+  Sphere _sphere;
+  std::unique_ptr<MeshBVH> _bvh;
+
+  GLuint _instanceBuffer = 0;
+
+  // Tightly packed positions sharing the IBO, for depth-only draws
+  VAO _positionVao;
+  gl::BufferWrapper<> _positions;
+  bool _positionsReady = false;
 };
 
 }  // namespace over
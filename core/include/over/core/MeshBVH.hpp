@@ -0,0 +1,74 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <over/core/BVH.hpp>
+#include <over/core/Bounds.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/IBO.hpp>
+#include <over/core/opengl/VBO.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+class TriangleHit {
+ public:
+  // Index into IBO elements
+  uint32 triangle = BVH::NONE;
+  // Weights of element b and c, a gets 1 - x - y
+  glm::vec2 barycentric = glm::vec2(0);
+  float32 distance = std::numeric_limits<float32>::infinity();
+
+  explicit operator bool() const noexcept { return triangle != BVH::NONE; }
+};
+
+// Triangle hierarchy of one mesh. Triangles are kept as structure of arrays
+// in leaf order, so a leaf is tested against one ray in SIMD batches
+class MeshBVH {
+ public:
+  static constexpr usize BATCH = 4;
+
+  MeshBVH() = default;
+  MeshBVH(const std::vector<Vertex>& vertices,
+          const std::vector<Element>& elements);
+
+  MeshBVH(const MeshBVH&) = default;
+  MeshBVH& operator=(const MeshBVH&) = default;
+
+  MeshBVH(MeshBVH&&) noexcept = default;
+  MeshBVH& operator=(MeshBVH&&) noexcept = default;
+
+  ~MeshBVH() = default;
+
+  usize Size() const noexcept { return _order.size(); }
+  const BVH& GetHierarchy() const noexcept { return _bvh; }
+
+  // Closest triangle, ray in mesh local space
+  TriangleHit Raycast(const Ray& ray,
+                      float32 maxDistance =
+                          std::numeric_limits<float32>::infinity()) const;
+  // Any triangle closer than max distance, for line of sight
+  bool Occluded(const Ray& ray, float32 maxDistance) const;
+
+  static const char* GetInstructionSet() noexcept;
+
+ private:
+  // Closest triangle of [first, first + count) closer than distance,
+  // returns leaf order index or BVH::NONE
+  uint32 IntersectRange(const Ray& ray, uint32 first, uint32 count,
+                        float32& distance, glm::vec2& barycentric) const;
+
+  BVH _bvh;
+
+  // leaf order -> element index
+  std::vector<uint32> _order;
+
+  // vertex a and edges b - a, c - a, padded with degenerate triangles
+  std::vector<float32> _ax, _ay, _az;
+  std::vector<float32> _e1x, _e1y, _e1z;
+  std::vector<float32> _e2x, _e2y, _e2z;
+};
+
+}  // namespace over
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <limits>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <over/core/Bounds.hpp>
+#include <over/core/Frustum.hpp>
 #include <over/core/Mesh.hpp>
+#include <over/core/SceneGraph.hpp>
 #include <over/core/Shader.hpp>
 #include <over/core/Transform.hpp>
 
@@ -15,21 +19,67 @@
 namespace over {
 class Model {
  public:
+  class Hit {
+   public:
+    usize mesh = std::numeric_limits<usize>::max();
+    // Index into IBO elements of the mesh
+    uint32 triangle = 0;
+    // Weights of element b and c, a gets 1 - x - y
+    glm::vec2 barycentric = glm::vec2(0);
+    float32 distance = std::numeric_limits<float32>::infinity();
+
+    explicit operator bool() const noexcept {
+      return mesh != std::numeric_limits<usize>::max();
+    }
+  };
+
   Model(const std::string& path);
 
   ~Model() = default;
 
   void Draw(Shader& shader);
   void Draw();
+  // Skips meshes outside of the world space frustum, returns drawn count
+  usize Draw(Shader& shader, const Frustum& frustum);
+  // Position streams only, for depth-only programs
+  void DrawDepth(Shader& shader);
+  // Same, placed in the world with transform (e.g. an instance transform)
+  void DrawDepth(Shader& shader, const glm::mat4& transform);
 
   Transform& GetTransform() noexcept { return _transform; }
 
+  // Node hierarchy of the file, mesh i is attached to GetMeshNode(i)
+  SceneGraph& GetScene() noexcept { return _scene; }
+  const SceneGraph& GetScene() const noexcept { return _scene; }
+  SceneGraph::Node GetMeshNode(usize mesh) const noexcept {
+    return _meshNodes[mesh];
+  }
+  // Model space transform of the mesh, updates the scene if it is dirty
+  const glm::mat4& GetMeshTransform(usize mesh);
+
+  // Uniform receiving model * node transform before each mesh is drawn
+  void SetModelUniform(std::string name) { _modelUniform = std::move(name); }
+  const std::string& GetModelUniform() const noexcept { return _modelUniform; }
+
   std::vector<Mesh>& GetMeshes() noexcept { return _meshes; };
   const std::vector<Mesh>& GetMeshes() const noexcept { return _meshes; }
 
+  // Local space, union of mesh bounds
+  const AABB& GetBounds() const noexcept { return _bounds; }
+  const Sphere& GetBoundingSphere() const noexcept { return _sphere; }
+  AABB GetWorldBounds() const noexcept;
+  void UpdateBounds();
+
+  // Closest triangle under the world space ray, mesh BVHs are built on first
+  // use. Distance is in world units when ray direction is normalized
+  Hit Raycast(const Ray& ray,
+              float32 maxDistance = std::numeric_limits<float32>::infinity());
+
  private:
+  // Scene update for every entry point, bounds follow moved nodes
+  void UpdateScene();
   void LoadModel(const std::string& path);
-  void ProcessNode(aiNode* node, const aiScene* scene);
+  void ProcessNode(aiNode* root, const aiScene* scene);
   Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene);
   std::vector<MeshTexture> LoadMaterialTextures(aiMaterial* material,
                                                 aiTextureType assimpType,
@@ -42,5 +92,11 @@ class Model {
   mutable std::vector<gl::TextureWrapper<>> _wrappers;
 
   std::vector<Mesh> _meshes;
+  std::vector<SceneGraph::Node> _meshNodes;
+  SceneGraph _scene;
+  std::string _modelUniform;
+
+  AABB _bounds;
+  Sphere _sphere;
 };
 }  // namespace over
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <over/core/Types.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+// Flat hierarchy: node is an index, parent index is always less than child
+// index, so world matrices are rebuilt by one linear pass over the arrays.
+// Only dirty nodes and their subtrees are recomputed
+class SceneGraph {
+ public:
+  using Node = uint32;
+
+  static constexpr Node ROOT = 0;
+  static constexpr Node NONE = std::numeric_limits<Node>::max();
+
+  SceneGraph();
+
+  SceneGraph(const SceneGraph&) = default;
+  SceneGraph& operator=(const SceneGraph&) = default;
+
+  SceneGraph(SceneGraph&&) noexcept = default;
+  SceneGraph& operator=(SceneGraph&&) noexcept = default;
+
+  ~SceneGraph() = default;
+
+  void Reserve(usize count);
+
+  Node Add(Node parent, const glm::mat4& local = glm::mat4(1),
+           std::string name = std::string());
+
+  usize Size() const noexcept { return _parents.size(); }
+
+  Node GetParent(Node node) const noexcept { return _parents[node]; }
+  const std::string& GetName(Node node) const noexcept { return _names[node]; }
+  Node Find(std::string_view name) const noexcept;
+
+  const glm::mat4& GetLocal(Node node) const noexcept { return _locals[node]; }
+  void SetLocal(Node node, const glm::mat4& local);
+
+  // Valid after Update()
+  const glm::mat4& GetWorld(Node node) const noexcept { return _worlds[node]; }
+  const std::vector<glm::mat4>& GetWorlds() const noexcept { return _worlds; }
+
+  bool IsDirty() const noexcept { return _firstDirty < Size(); }
+
+  // Recomputes world matrices of dirty subtrees, returns recomputed count
+  usize Update();
+
+  // Reorders storage breadth-first (siblings are contiguous),
+  // returns remap: old node -> new node
+  std::vector<Node> SortBreadthFirst();
+
+ private:
+  void MarkDirty(Node node) noexcept;
+
+  std::vector<Node> _parents;
+  std::vector<glm::mat4> _locals;
+  std::vector<glm::mat4> _worlds;
+  std::vector<uint8> _dirty;
+  std::vector<std::string> _names;
+
+  usize _firstDirty;
+};
+
+}  // namespace over
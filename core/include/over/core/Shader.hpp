@@ -17,6 +17,12 @@ class Shader : public Binded<Shader> {
   Shader(std::string_view vertex, std::string_view fragment,
          std::string_view geometry);
 
+  // Compute program, requires OpenGL 4.3 context
+  static Shader FromCompute(std::string computePath);
+  // Program of GLSL sources instead of files, e.g. generated ones
+  static Shader FromSource(std::string_view vertexSource,
+                           std::string_view fragmentSource);
+
   Shader(const Shader&) = delete;
   Shader& operator=(const Shader&) = delete;
 
@@ -35,6 +41,7 @@ class Shader : public Binded<Shader> {
   void SetBool(const std::string& name, bool value);
   void SetFloat(const std::string& name, float32 value);
   void SetInt(const std::string& name, int32 value);
+  void SetUInt(const std::string& name, uint32 value);
 
   void SetMatrix4f(const std::string& name, float32* ptr);
   void SetMatrix4f(const std::string& name, glm::mat4 mat);
@@ -48,17 +55,43 @@ class Shader : public Binded<Shader> {
   void SetVec2f(const std::string& name, glm::vec2 v);
   void SetVec2f(const std::string& name, float32* ptr);
 
+  void SetVec4f(const std::string& name, glm::vec4 v);
+  void SetVec4fv(const std::string& name, usize count, const float32* ptr);
+
+  void SetIVec2(const std::string& name, glm::ivec2 v);
+  void SetIVec3(const std::string& name, glm::ivec3 v);
+
   void BindUniform(std::string_view name, usize index);
+  // Throws if the program has no storage block of that name
+  void BindStorage(const std::string& name, usize index);
+
+#pragma region Compute
+  bool IsCompute() const noexcept { return !computePath_.empty(); }
+  glm::ivec3 GetWorkGroupSize() const;
+
+  // Number of groups, not invocations
+  void Dispatch(uint32 x, uint32 y = 1, uint32 z = 1);
+  // Reads groups count from the bound DISPATCH_INDIRECT_BUFFER
+  void DispatchIndirect(usize offset = 0);
+#pragma endregion
 
   static Shader GetCurrent() noexcept;
 
  private:
   void Compile();
+  void CompileCompute();
+  void Build(const std::string& vertexSource,
+             const std::string& fragmentSource,
+             const std::string& geometrySource);
+  void Link(GLuint program);
   void FreeGPU() noexcept;
 
   std::string vertexPath_;
   std::string fragmentPath_;
   std::string geometryPath_;
+  std::string computePath_;
+  // owns its program without paths
+  bool generated_;
 
   GLuint program_;
 
@@ -1,20 +1,56 @@
 #pragma once
 
+#include <over/core/TransformStorage.hpp>
+
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace over {
 
+// Owning handle to one slot of TransformStorage
 class Transform {
  public:
-  glm::vec3 position;
-  glm::vec3 rotation;
-  glm::vec3 scale;
-
   Transform();
 
+  // Euler angles in radians, applied X, then Y, then Z
   Transform(glm::vec3 position, glm::vec3 rotation, glm::vec3 scale);
 
-  glm::mat4 GetModel() const noexcept;
+  explicit Transform(TransformStorage& storage,
+                     glm::vec3 position = glm::vec3(0),
+                     glm::quat rotation = glm::quat(1, 0, 0, 0),
+                     glm::vec3 scale = glm::vec3(1));
+
+  Transform(const Transform& other);
+  Transform& operator=(const Transform& other);
+
+  Transform(Transform&& other) noexcept;
+  Transform& operator=(Transform&& other) noexcept;
+
+  ~Transform();
+
+  glm::vec3 GetPosition() const noexcept;
+  void SetPosition(glm::vec3 position) noexcept;
+  void Translate(glm::vec3 offset) noexcept;
+
+  glm::quat GetRotation() const noexcept;
+  void SetRotation(glm::quat rotation) noexcept;
+  // Euler angles in radians, applied X, then Y, then Z
+  void SetRotation(glm::vec3 angles) noexcept;
+  // Around local axis
+  void Rotate(float32 angle, glm::vec3 axis) noexcept;
+
+  glm::vec3 GetScale() const noexcept;
+  void SetScale(glm::vec3 scale) noexcept;
+
+  // Cached, rebuilt only after a change
+  const glm::mat4& GetModel() const noexcept;
+
+  TransformStorage& GetStorage() const noexcept { return *_storage; }
+  TransformStorage::Id GetId() const noexcept { return _id; }
+
+ private:
+  TransformStorage* _storage;
+  TransformStorage::Id _id;
 };
 
 }  // namespace over
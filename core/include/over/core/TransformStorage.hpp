@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+
+#include <over/core/Types.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace over {
+
+// Positions, rotations and scales as structure of arrays. Model matrices are
+// cached and only changed ones are rebuilt, in SIMD batches. Not thread safe:
+// modify and update from one thread
+class TransformStorage {
+ public:
+  using Id = uint32;
+
+  static constexpr usize BATCH = 4;
+  // Dirty transforms count from which Update splits work between the threads
+  // of WorkerPool::GetShared()
+  static constexpr usize PARALLEL_THRESHOLD = 1 << 14;
+
+  TransformStorage();
+
+  TransformStorage(const TransformStorage&) = default;
+  TransformStorage& operator=(const TransformStorage&) = default;
+
+  TransformStorage(TransformStorage&&) noexcept = default;
+  TransformStorage& operator=(TransformStorage&&) noexcept = default;
+
+  ~TransformStorage() = default;
+
+  // Storage of default constructed transforms
+  static TransformStorage& GetDefault();
+
+  void Reserve(usize count);
+
+  Id Create(glm::vec3 position = glm::vec3(0),
+            glm::quat rotation = glm::quat(1, 0, 0, 0),
+            glm::vec3 scale = glm::vec3(1));
+  void Destroy(Id id);
+
+  // Alive transforms
+  usize Size() const noexcept { return _size; }
+
+  glm::vec3 GetPosition(Id id) const noexcept;
+  glm::quat GetRotation(Id id) const noexcept;
+  glm::vec3 GetScale(Id id) const noexcept;
+
+  void SetPosition(Id id, glm::vec3 position) noexcept;
+  void SetRotation(Id id, glm::quat rotation) noexcept;
+  void SetScale(Id id, glm::vec3 scale) noexcept;
+
+  bool IsDirty(Id id) const noexcept { return _dirty[id] != 0; }
+  usize GetDirtyCount() const noexcept { return _dirtyCount; }
+
+  // Rebuilds only this matrix if it is dirty.
+  // Reference is invalidated by Create
+  const glm::mat4& GetModel(Id id) noexcept;
+  // Indexed by id, valid after Update
+  const std::vector<glm::mat4>& GetModels() const noexcept { return _models; }
+
+  // Rebuilds every dirty matrix, returns rebuilt count
+  usize Update();
+
+  static const char* GetInstructionSet() noexcept;
+
+ private:
+  void MarkDirty(Id id) noexcept;
+  void RebuildOne(Id id) noexcept;
+  // Rebuilds dirty batches in [begin, end), bounds are multiple of BATCH
+  void Rebuild(usize begin, usize end) noexcept;
+
+  std::vector<float32> _positionX, _positionY, _positionZ;
+  std::vector<float32> _rotationX, _rotationY, _rotationZ, _rotationW;
+  std::vector<float32> _scaleX, _scaleY, _scaleZ;
+
+  std::vector<glm::mat4> _models;
+  std::vector<uint8> _dirty;
+  std::vector<Id> _free;
+
+  usize _size;
+  usize _dirtyCount;
+};
+
+}  // namespace over
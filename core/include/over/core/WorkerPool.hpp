@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <over/core/Types.hpp>
+
+namespace over {
+
+// Persistent threads for data parallel loops, started once instead of per
+// call. Run calls func(i) once for every i in [0, count): the caller takes 0
+// and any index past Size(), worker k takes k. Runs from several threads are
+// serialized
+class WorkerPool {
+ public:
+  // Threads besides the caller, 0 - one per core but the caller's
+  explicit WorkerPool(usize workers = 0);
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  WorkerPool(WorkerPool&&) = delete;
+  WorkerPool& operator=(WorkerPool&&) = delete;
+
+  ~WorkerPool();
+
+  // Returns when every call is done
+  void Run(usize count, const std::function<void(usize)>& func);
+
+  // Caller and workers
+  usize Size() const noexcept { return _workers.size() + 1; }
+
+  // One per core, for code without a pool of its own
+  static WorkerPool& GetShared();
+
+ private:
+  void Work(usize index);
+
+  std::vector<std::thread> _workers;
+
+  // one Run at a time
+  std::mutex _run;
+
+  std::mutex _mutex;
+  std::condition_variable _start;
+  std::condition_variable _done;
+  const std::function<void(usize)>* _task;
+  usize _count;
+  usize _generation;
+  usize _pending;
+  bool _stop;
+};
+
+}  // namespace over
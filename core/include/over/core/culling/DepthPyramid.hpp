@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/opengl/wrappers/TextureWrapper.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::culling {
+
+// Hi-Z: R32F mip chain where every texel holds the farthest depth of the
+// texels it covers. Level 0 has the size of the depth buffer, odd sizes fold
+// the extra row/column into the last texel
+class DepthPyramid {
+ public:
+  // Compute shader with "depth" sampler2D, "previous" and "destination" r32f
+  // images and "level", "previousSize" and "size" uniforms: level 0 copies
+  // depth, others reduce the previous level of the pyramid
+  explicit DepthPyramid(std::string shaderPath);
+
+  DepthPyramid(const DepthPyramid&) = delete;
+  DepthPyramid& operator=(const DepthPyramid&) = delete;
+
+  DepthPyramid(DepthPyramid&&) noexcept = default;
+  DepthPyramid& operator=(DepthPyramid&&) noexcept = default;
+
+  ~DepthPyramid() = default;
+
+  // Reads the depth texture (not multisampled), one dispatch per level
+  void Build(gl::Texture2DView depth, glm::ivec2 size);
+
+  gl::Texture2DView GetTexture() const noexcept {
+    return _texture.As<gl::TextureTarget::TEXTURE_2D>();
+  }
+  glm::ivec2 GetSize() const noexcept { return _size; }
+  uint32 GetLevels() const noexcept { return _levels; }
+
+  static uint32 GetLevelCount(glm::ivec2 size) noexcept;
+
+ private:
+  void Resize(glm::ivec2 size);
+
+  Shader _shader;
+  gl::TextureWrapper<> _texture;
+  glm::ivec2 _size;
+  uint32 _levels;
+};
+
+}  // namespace over::culling
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+
+#include <over/core/Bounds.hpp>
+#include <over/core/Frustum.hpp>
+#include <over/core/Types.hpp>
+
+namespace over::culling {
+
+// Boxes as center/extents structure of arrays, padded to the SIMD batch
+class BoundsSoA {
+ public:
+  static constexpr usize BATCH = 8;
+
+  BoundsSoA() = default;
+
+  void Reserve(usize count);
+  void Clear() noexcept;
+
+  usize Add(const AABB& box);
+  void Set(usize index, const AABB& box);
+
+  usize Size() const noexcept { return _size; }
+  // Multiple of BATCH, tail is filled with never visible boxes
+  usize PaddedSize() const noexcept { return _centerX.size(); }
+
+  const float32* CenterX() const noexcept { return _centerX.data(); }
+  const float32* CenterY() const noexcept { return _centerY.data(); }
+  const float32* CenterZ() const noexcept { return _centerZ.data(); }
+  const float32* ExtentX() const noexcept { return _extentX.data(); }
+  const float32* ExtentY() const noexcept { return _extentY.data(); }
+  const float32* ExtentZ() const noexcept { return _extentZ.data(); }
+
+ private:
+  void Resize(usize size);
+
+  std::vector<float32> _centerX, _centerY, _centerZ;
+  std::vector<float32> _extentX, _extentY, _extentZ;
+  usize _size = 0;
+};
+
+class FrustumCuller {
+ public:
+  // Appends indices of boxes intersecting the frustum, returns their count.
+  // AVX: 8 boxes per iteration, SSE: 2 x 4, otherwise scalar
+  static usize Cull(const Frustum& frustum, const BoundsSoA& bounds,
+                    std::vector<uint32>& visible);
+
+  static usize CullScalar(const Frustum& frustum, const BoundsSoA& bounds,
+                          std::vector<uint32>& visible);
+
+  static const char* GetInstructionSet() noexcept;
+};
+
+}  // namespace over::culling
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <over/core/Bounds.hpp>
+#include <over/core/Model.hpp>
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/culling/DepthPyramid.hpp>
+#include <over/core/opengl/DrawCommand.hpp>
+#include <over/core/opengl/InstanceBuffer.hpp>
+#include <over/core/opengl/wrappers/BufferWrapper.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::culling {
+
+// Two-phase GPU occlusion culling of instances of one model.
+// DrawVisible draws what was visible last frame, DrawRevealed builds the
+// depth pyramid from that depth, tests every object against it and draws
+// objects that became visible. Culling and draw lists stay on the GPU
+class HiZCuller {
+ public:
+  // Storage buffer bindings of the cull shader
+  static constexpr usize BOUNDS_BINDING = 0;
+  static constexpr usize INSTANCES_BINDING = 1;
+  static constexpr usize VISIBILITY_BINDING = 2;
+  static constexpr usize OUTPUT_BINDING = 3;
+  static constexpr usize COMMANDS_BINDING = 4;
+  static constexpr usize STATISTICS_BINDING = 5;
+
+  // Statistics are read back this many frames after they were written,
+  // so reading does not wait for the GPU
+  static constexpr usize STATISTICS_LATENCY = 3;
+
+  enum Phase : uint32 { VISIBLE = 0, REVEALED, PHASES };
+
+  class Statistics {
+   public:
+    uint32 objects = 0;
+    uint32 frustumCulled = 0;
+    uint32 occlusionCulled = 0;
+    uint32 visible = 0;
+  };
+
+  HiZCuller(std::string pyramidShaderPath, std::string cullShaderPath);
+
+  HiZCuller(const HiZCuller&) = delete;
+  HiZCuller& operator=(const HiZCuller&) = delete;
+
+  HiZCuller(HiZCuller&&) noexcept = default;
+  HiZCuller& operator=(HiZCuller&&) noexcept = default;
+
+  ~HiZCuller() = default;
+
+  // Object i is instances[i] of the model with world space bounds[i].
+  // Visibility is reset, first frame draws everything in the frustum
+  void SetObjects(Model& model, std::vector<Instance> instances,
+                  const std::vector<AABB>& bounds);
+  // Forget last frame visibility, e.g. after a camera cut
+  void ResetVisibility();
+
+  // Without the test phase 2 only frustum culls, for comparison
+  bool GetOcclusionTest() const noexcept { return _occlusionTest; }
+  void SetOcclusionTest(bool enabled) noexcept { _occlusionTest = enabled; }
+
+  // Phase 1: objects visible last frame that are inside the frustum
+  void DrawVisible(Shader& shader, const glm::mat4& viewProjection);
+  // Phase 2: depth holds phase 1 depth (single sample)
+  void DrawRevealed(Shader& shader, gl::Texture2DView depth,
+                    glm::ivec2 size);
+
+  usize Size() const noexcept { return _count; }
+  const Statistics& GetStatistics() const noexcept { return _statistics; }
+  const DepthPyramid& GetPyramid() const noexcept { return _pyramid; }
+
+ private:
+  void Cull(Phase phase);
+  void Draw(Shader& shader, Phase phase);
+  void ReadStatistics();
+
+  DepthPyramid _pyramid;
+  Shader _shader;
+
+  Model* _model;
+  usize _count;
+  std::vector<gl::DrawElementsCommand> _commandTemplate;
+
+  gl::BufferWrapper<> _bounds;
+  gl::BufferWrapper<> _visibility;
+  InstanceBuffer _instances;
+  std::array<InstanceBuffer, PHASES> _output;
+  std::array<gl::BufferWrapper<>, PHASES> _commands;
+
+  std::array<gl::BufferWrapper<>, STATISTICS_LATENCY> _statisticsBuffers;
+  Statistics _statistics;
+  usize _frame;
+
+  glm::mat4 _viewProjection;
+  bool _occlusionTest;
+};
+
+}  // namespace over::culling
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <over/core/Bounds.hpp>
+#include <over/core/Camera.hpp>
+#include <over/core/Frustum.hpp>
+#include <over/core/Mesh.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/WorkerPool.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::culling {
+
+// Low-poly stand-in of a mesh, counter-clockwise triangles seen from outside
+class Occluder {
+ public:
+  std::vector<glm::vec3> vertices;
+  std::vector<uint32> indices;
+  AABB bounds;
+
+  Occluder();
+  Occluder(std::vector<glm::vec3> vertices, std::vector<uint32> indices);
+
+  // Every triangle of the mesh, use on already simplified meshes
+  static Occluder FromMesh(const Mesh& mesh);
+  // 12 triangles, good enough for buildings and walls
+  static Occluder FromBox(const AABB& box);
+
+  usize TriangleCount() const noexcept { return indices.size() / 3; }
+};
+
+// CPU depth buffer for occlusion culling, no GPU readback involved.
+// Masked occlusion style: the screen is split into 8x4 pixel tiles, each
+// keeps a coverage mask and two conservative depths instead of pixels.
+// Occluders are rasterized at low resolution by worker threads, every thread
+// owns a horizontal band of tiles. The threads persist across frames, copies
+// share them. Depth is NDC z, smaller is closer
+class OcclusionBuffer {
+ public:
+  static constexpr uint32 TILE_WIDTH = 8;
+  static constexpr uint32 TILE_HEIGHT = 4;
+  static constexpr uint32 FULL_MASK = 0xFFFFFFFF;
+  // Cull splits candidates across threads above this many per thread
+  static constexpr usize PARALLEL_THRESHOLD = 4096;
+
+  // Width and height are rounded up to whole tiles, 0 threads - one per core
+  OcclusionBuffer(uint32 width, uint32 height, usize threads = 0);
+
+  OcclusionBuffer(const OcclusionBuffer&) = default;
+  OcclusionBuffer& operator=(const OcclusionBuffer&) = default;
+
+  OcclusionBuffer(OcclusionBuffer&&) noexcept = default;
+  OcclusionBuffer& operator=(OcclusionBuffer&&) noexcept = default;
+
+  ~OcclusionBuffer() = default;
+
+  // Clears depth and occluders, following calls use the camera matrices
+  void Begin(const Camera& camera);
+  void Begin(const glm::mat4& viewProjection);
+
+  // Occluder outside the frustum is skipped. Occluder must outlive Render
+  void Add(const Occluder& occluder, const glm::mat4& model);
+  // Rasterizes occluders added since Begin
+  void Render();
+
+  // False if the box is off screen or hidden behind rendered occluders
+  bool IsVisible(const AABB& box) const noexcept;
+  bool IsVisible(const Mesh& mesh, const glm::mat4& model) const noexcept {
+    return IsVisible(mesh.GetBounds().Transformed(model));
+  }
+  // Appends visible candidates (e.g. frustum culling result) to visible
+  usize Cull(const std::vector<AABB>& boxes,
+             const std::vector<uint32>& candidates,
+             std::vector<uint32>& visible) const;
+
+  uint32 GetWidth() const noexcept { return _width; }
+  uint32 GetHeight() const noexcept { return _height; }
+
+  usize GetThreads() const noexcept { return _threads; }
+  void SetThreads(usize threads);
+
+  bool GetBackfaceCulling() const noexcept { return _backfaceCulling; }
+  void SetBackfaceCulling(bool enabled) noexcept { _backfaceCulling = enabled; }
+
+  // Triangles that reached the rasterizer in the last Render
+  usize GetTriangleCount() const noexcept;
+
+  // Conservative depth per pixel (farthest of its tile), for visualization
+  std::vector<float32> GetDepth() const;
+
+  static const char* GetInstructionSet() noexcept;
+
+ private:
+  // Whole tile is closer than reference, pixels in mask are closer than
+  // layer (working layer, merged into reference once the mask is full)
+  class Tile {
+   public:
+    float32 reference;
+    float32 layer;
+    uint32 mask;
+  };
+
+  // Screen space triangle: edge functions are >= 0 inside, depth is a plane
+  class Triangle {
+   public:
+    float32 edgeA[3], edgeB[3], edgeC[3];
+    float32 depthA, depthB, depthC;
+    float32 maxDepth;
+    float32 minX, minY, maxX, maxY;
+  };
+
+  class Draw {
+   public:
+    const Occluder* occluder;
+    glm::mat4 model;
+  };
+
+  void Setup(usize worker);
+  void SetupTriangle(const glm::vec4& a, const glm::vec4& b,
+                     const glm::vec4& c, std::vector<Triangle>& triangles) const;
+  void EmitTriangle(glm::vec3 a, glm::vec3 b, glm::vec3 c,
+                    std::vector<Triangle>& triangles) const;
+
+  void Rasterize(uint32 firstRow, uint32 lastRow);
+  void RasterizeTriangle(const Triangle& triangle, uint32 firstRow,
+                         uint32 lastRow);
+
+  static uint32 Coverage(const Triangle& triangle, float32 x,
+                         float32 y) noexcept;
+  static void UpdateTile(Tile& tile, uint32 coverage, float32 depth) noexcept;
+
+  template <class F>
+  void Parallel(F&& func);
+
+  uint32 _width, _height;
+  uint32 _tilesX, _tilesY;
+  usize _threads;
+  // _threads - 1 workers, nullptr with one thread
+  std::shared_ptr<WorkerPool> _pool;
+  bool _backfaceCulling;
+
+  glm::mat4 _viewProjection;
+  Frustum _frustum;
+
+  std::vector<Tile> _tiles;
+  std::vector<Draw> _draws;
+  // Set up triangles of every worker, rasterized by all of them
+  std::vector<std::vector<Triangle>> _triangles;
+};
+
+}  // namespace over::culling
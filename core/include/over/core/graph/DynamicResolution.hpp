@@ -0,0 +1,82 @@
+#pragma once
+
+#include <over/core/Types.hpp>
+
+namespace over::graph {
+
+// Render scale that keeps the GPU frame time near a target. Frame times are
+// averaged over an interval, then a PID controller on the relative headroom
+// (target - average) / target asks for a change of frame time, which becomes
+// a change of scale through the pixel count (time ~ scale^2). The scale is
+// quantized to steps so the render targets only reallocate on real changes,
+// and samples right after a change are skipped: the pool applies a new
+// extent after RenderTargetPool::RESIZE_FRAMES and timer queries lag by
+// TimerQuery::LATENCY frames
+class DynamicResolution {
+ public:
+  // Frames skipped after a change, until the new scale is measured
+  static constexpr usize SETTLE_FRAMES = 11;
+
+  explicit DynamicResolution(float64 targetMilliseconds = 16.6,
+                             float32 minScale = 0.5f, float32 maxScale = 1.f);
+
+  DynamicResolution(const DynamicResolution&) = delete;
+  DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+  DynamicResolution(DynamicResolution&&) noexcept = default;
+  DynamicResolution& operator=(DynamicResolution&&) noexcept = default;
+
+  ~DynamicResolution() = default;
+
+  // GPU time of a frame, returns true if the scale changed. Empty
+  // measurements (timers not ready yet) are ignored
+  bool Update(float64 milliseconds);
+  // Back to the maximum scale, controller state cleared
+  void Reset() noexcept;
+
+  // Linear scale of the render extent, in [min, max]
+  float32 GetScale() const noexcept { return _scale; }
+  // Average frame time of the last finished interval
+  float64 GetAverage() const noexcept { return _average; }
+
+#pragma region Tuning
+
+  float64 GetTarget() const noexcept { return _target; }
+  void SetTarget(float64 milliseconds) noexcept;
+
+  float32 GetMinScale() const noexcept { return _minScale; }
+  float32 GetMaxScale() const noexcept { return _maxScale; }
+  void SetRange(float32 minScale, float32 maxScale) noexcept;
+
+  void SetGains(float64 proportional, float64 integral,
+                float64 derivative) noexcept;
+
+  // Frames averaged per decision
+  usize GetInterval() const noexcept { return _interval; }
+  void SetInterval(usize frames) noexcept {
+    _interval = frames == 0 ? 1 : frames;
+  }
+
+  float32 GetStep() const noexcept { return _step; }
+  void SetStep(float32 step) noexcept { _step = step; }
+
+#pragma endregion
+
+ private:
+  float64 _target;
+  float32 _minScale, _maxScale;
+  float32 _step;
+  usize _interval;
+  float64 _proportional, _integral, _derivative;
+
+  float32 _scale;
+  float64 _sum;
+  usize _samples;
+  usize _settle;
+  float64 _average;
+  float64 _accumulated;
+  float64 _lastError;
+  bool _first;
+};
+
+}  // namespace over::graph
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <over/core/Includes.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/graph/RenderTargetPool.hpp>
+#include <over/core/opengl/views/FrameBufferView.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/opengl/wrappers/FrameBufferWrapper.hpp>
+
+namespace over::graph {
+
+// Handle of a graph resource, valid until the next Reset
+using Resource = uint32;
+constexpr Resource INVALID_RESOURCE = ~0u;
+
+// Transient 2D target, the graph extent times scale
+class TextureDesc {
+ public:
+  GLenum format = GL_RGBA8;
+  // 0 - single sampled
+  uint32 samples = 0;
+  // Never sampled directly: reads get a resolved texture
+  bool renderBuffer = false;
+  float32 scale = 1.f;
+
+  bool operator==(const TextureDesc& other) const noexcept {
+    return format == other.format && samples == other.samples &&
+           renderBuffer == other.renderBuffer && scale == other.scale;
+  }
+  bool operator!=(const TextureDesc& other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+class RenderGraph;
+
+// Declares what a pass reads and writes, given to the setup of AddPass
+class PassBuilder {
+ public:
+  // Sampled by the pass, multisampled resources are resolved before it
+  void Read(Resource resource);
+  // Rendered to, the graph binds a frame buffer with the attachments
+  void Write(Resource resource, GLenum attachment);
+  // Written by the pass itself (own frame buffer, copies)
+  void Write(Resource resource);
+  // Written by image stores, readers get a memory barrier first
+  void WriteImage(Resource resource);
+  // Never culled, even if nothing reads its outputs
+  void SetSideEffect();
+
+ private:
+  PassBuilder(RenderGraph& graph, uint32 pass) noexcept
+      : _graph(graph), _pass(pass) {}
+
+  RenderGraph& _graph;
+  uint32 _pass;
+
+  friend class RenderGraph;
+};
+
+// Physical resources of the executing pass
+class PassContext {
+ public:
+  // Sampled texture, the resolved one for multisampled resources
+  gl::Texture2DView GetTexture(Resource resource) const;
+
+  // Size of the pass attachments
+  uint32 GetWidth() const noexcept { return _width; }
+  uint32 GetHeight() const noexcept { return _height; }
+
+ private:
+  PassContext(RenderGraph& graph, uint32 width, uint32 height) noexcept
+      : _graph(graph), _width(width), _height(height) {}
+
+  RenderGraph& _graph;
+  uint32 _width, _height;
+
+  friend class RenderGraph;
+};
+
+// Frame graph rebuilt every frame: passes declare the resources they read
+// and write, Compile culls passes nothing depends on and computes resource
+// lifetimes. Transient targets whose lifetimes do not overlap share one
+// target of the pool, which recycles them across frames. Execute binds pass
+// frame buffers, resolves multisampled reads with blits and puts memory
+// barriers after image writes
+class RenderGraph {
+ public:
+  RenderGraph();
+
+  RenderGraph(const RenderGraph&) = delete;
+  RenderGraph& operator=(const RenderGraph&) = delete;
+
+  RenderGraph(RenderGraph&&) noexcept = default;
+  RenderGraph& operator=(RenderGraph&&) noexcept = default;
+
+  ~RenderGraph() = default;
+
+  // Drops the passes and resources of the last frame and advances the pool.
+  // Transient targets follow the back buffer size times scale lazily, see
+  // RenderTargetPool; the back buffer keeps its size
+  void Reset(uint32 width, uint32 height, float32 scale = 1.f);
+
+  Resource Create(std::string name, const TextureDesc& desc);
+  // Texture owned elsewhere, not allocated or aliased by the graph
+  Resource Import(std::string name, gl::Texture2DView texture, uint32 width,
+                  uint32 height);
+  // Default frame buffer, passes writing it are never culled
+  Resource ImportBackBuffer(std::string name = "backbuffer");
+
+  // setup(PassBuilder&) runs now, execute(PassContext&) in Execute if the
+  // pass survives Compile. Passes execute in the order they were added
+  template <class S, class E>
+  void AddPass(std::string name, S&& setup, E&& execute);
+
+  void Compile();
+  void Execute();
+
+  // Graphviz dot of the compiled graph: culled passes are dashed, resources
+  // show the GL object (slot) they were given
+  std::string ExportDot() const;
+
+  // Extent of transient targets, lags the back buffer while it is resized
+  uint32 GetWidth() const noexcept { return _width; }
+  uint32 GetHeight() const noexcept { return _height; }
+
+  RenderTargetPool& GetPool() noexcept { return _pool; }
+
+  usize GetPassCount() const noexcept { return _passes.size(); }
+  usize GetCulledPasses() const noexcept { return _culled; }
+  // Transient resources, including resolve targets
+  usize GetTransientResources() const noexcept { return _transient; }
+  // Pool targets used this frame, fewer than transient resources when aliased
+  usize GetPhysicalResources() const noexcept { return _targets.size(); }
+
+ private:
+  class PassBase {
+   public:
+    virtual ~PassBase() = default;
+    virtual void Execute(PassContext& context) = 0;
+  };
+
+  template <class E>
+  class Pass final : public PassBase {
+   public:
+    explicit Pass(E execute) : _execute(std::move(execute)) {}
+    void Execute(PassContext& context) override { _execute(context); }
+
+   private:
+    E _execute;
+  };
+
+  enum class Kind { TRANSIENT, IMPORTED, BACK_BUFFER };
+
+  class ResourceNode {
+   public:
+    std::string name;
+    TextureDesc desc;
+    Kind kind = Kind::TRANSIENT;
+    gl::Texture2DView texture;
+    uint32 width = 0, height = 0;
+
+    // Live pass range, set by Compile
+    uint32 first = ~0u, last = 0;
+    bool used = false;
+    // Index of _targets
+    uint32 physical = ~0u;
+    // Single sampled copy of a multisampled resource, and its source
+    Resource resolve = INVALID_RESOURCE;
+    Resource source = INVALID_RESOURCE;
+
+    // Execution state
+    bool dirty = false;
+    bool imageWritten = false;
+  };
+
+  class PassNode {
+   public:
+    std::string name;
+    std::unique_ptr<PassBase> execute;
+
+    std::vector<Resource> reads;
+    std::vector<std::pair<Resource, GLenum>> attachments;
+    std::vector<Resource> writes;
+    std::vector<Resource> imageWrites;
+
+    bool sideEffect = false;
+    bool culled = false;
+    bool backBuffer = false;
+  };
+
+  // Pool target held for this frame
+  class Target {
+   public:
+    RenderTarget target = INVALID_TARGET;
+    // Last pass of the resource holding it
+    uint32 busyUntil = 0;
+  };
+
+  uint32 BeginPass(std::string name, std::unique_ptr<PassBase> execute);
+  ResourceNode& GetNode(Resource resource);
+
+  void Cull();
+  void ComputeLifetimes();
+  void Allocate();
+  void ReleaseTargets();
+
+  void Resolve(Resource resource);
+  gl::Texture2DView GetTexture(Resource resource);
+
+  uint32 _width, _height;
+  uint32 _backBufferWidth, _backBufferHeight;
+
+  std::vector<PassNode> _passes;
+  std::vector<ResourceNode> _resources;
+
+  RenderTargetPool _pool;
+  std::vector<Target> _targets;
+  bool _released;
+  // blit sources and destinations of resolves
+  gl::FrameBufferWrapper<> _resolveRead;
+  gl::FrameBufferWrapper<> _resolveDraw;
+
+  bool _compiled;
+  usize _culled;
+  usize _transient;
+
+  friend class PassBuilder;
+  friend class PassContext;
+};
+
+template <class S, class E>
+void RenderGraph::AddPass(std::string name, S&& setup, E&& execute) {
+  auto pass = BeginPass(std::move(name),
+                        std::make_unique<Pass<std::decay_t<E>>>(
+                            std::forward<E>(execute)));
+  PassBuilder builder(*this, pass);
+  setup(builder);
+}
+
+}  // namespace over::graph
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <over/core/Includes.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/views/FrameBufferView.hpp>
+#include <over/core/opengl/views/RenderBufferView.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/opengl/wrappers/FrameBufferWrapper.hpp>
+#include <over/core/opengl/wrappers/RenderBufferWrapper.hpp>
+#include <over/core/opengl/wrappers/TextureWrapper.hpp>
+
+namespace over::graph {
+
+bool IsDepthFormat(GLenum format) noexcept;
+bool IsStencilFormat(GLenum format) noexcept;
+// Bytes per texel of a sized format, 4 for unknown ones
+usize GetFormatSize(GLenum format) noexcept;
+
+class RenderTargetDesc {
+ public:
+  GLenum format = GL_RGBA8;
+  uint32 width = 0, height = 0;
+  // 0 - single sampled
+  uint32 samples = 0;
+  // Attachment only, never sampled
+  bool renderBuffer = false;
+
+  bool operator==(const RenderTargetDesc& other) const noexcept {
+    return format == other.format && width == other.width &&
+           height == other.height && samples == other.samples &&
+           renderBuffer == other.renderBuffer;
+  }
+  bool operator!=(const RenderTargetDesc& other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+// Handle of a pooled target, valid until it is released
+using RenderTarget = uint32;
+constexpr RenderTarget INVALID_TARGET = ~0u;
+
+// Attachment of GetFrameBuffer: a pooled target, or a texture owned elsewhere
+class Attachment {
+ public:
+  GLenum point = GL_COLOR_ATTACHMENT0;
+  RenderTarget target = INVALID_TARGET;
+  gl::Texture2DView texture;
+};
+
+// Textures, render buffers and frame buffers handed out by descriptor.
+// Released targets are recycled by the next Acquire of the same descriptor
+// and freed after staying unused for the idle frame count, frame buffers
+// are cached by attachments the same way. Resize follows the window size
+// lazily: the extent only moves once a new size was requested for
+// RESIZE_FRAMES frames in a row, so dragging the window reallocates a few
+// times instead of every frame
+class RenderTargetPool {
+ public:
+  static constexpr usize RESIZE_FRAMES = 8;
+
+  explicit RenderTargetPool(usize idleFrames = 30);
+
+  RenderTargetPool(const RenderTargetPool&) = delete;
+  RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+  RenderTargetPool(RenderTargetPool&&) noexcept = default;
+  RenderTargetPool& operator=(RenderTargetPool&&) noexcept = default;
+
+  ~RenderTargetPool() = default;
+
+  // Requested size of this frame, returns true if the extent changed
+  bool Resize(uint32 width, uint32 height);
+  // Size full screen targets should have
+  uint32 GetWidth() const noexcept { return _width; }
+  uint32 GetHeight() const noexcept { return _height; }
+
+  RenderTarget Acquire(const RenderTargetDesc& desc);
+  void Release(RenderTarget target);
+
+  const RenderTargetDesc& GetDesc(RenderTarget target) const;
+  gl::Texture2DView GetTexture(RenderTarget target);
+  gl::TextureView<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE>
+  GetMultisampleTexture(RenderTarget target);
+  gl::RenderBufferView<gl::RenderBufferTarget::RENDER_BUFFER> GetRenderBuffer(
+      RenderTarget target);
+
+  // Complete frame buffer with exactly these attachments
+  gl::FrameBufferView<gl::FrameBufferTarget::FRAMEBUFFER> GetFrameBuffer(
+      const std::vector<Attachment>& attachments);
+
+  // Ages released targets and cached frame buffers, frees idle ones
+  void NextFrame();
+
+  usize GetIdleFrames() const noexcept { return _idleFrames; }
+  void SetIdleFrames(usize frames) noexcept { _idleFrames = frames; }
+
+  // Targets alive, in use or waiting for reuse
+  usize GetTargetCount() const noexcept { return _alive; }
+  usize GetFreeCount() const noexcept;
+  usize GetFrameBufferCount() const noexcept { return _frameBuffers.size(); }
+  // Estimated bytes of alive targets, every sample counted
+  usize GetMemory() const noexcept;
+  // GL allocations since creation, flat once the pool is warm
+  usize GetAllocations() const noexcept { return _allocations; }
+
+ private:
+  class Slot {
+   public:
+    RenderTargetDesc desc;
+    gl::TextureWrapper<> texture;
+    gl::RenderBufferWrapper<> renderBuffer;
+    bool alive = false;
+    bool free = false;
+    usize releasedFrame = 0;
+  };
+
+  class FrameBuffer {
+   public:
+    // attachment, GL name (render buffers tagged above bit 32)
+    std::vector<std::pair<GLenum, uint64>> key;
+    gl::FrameBufferWrapper<> frame;
+    usize usedFrame = 0;
+  };
+
+  Slot& GetSlot(RenderTarget target);
+  const Slot& GetSlot(RenderTarget target) const;
+  uint64 GetKey(const Slot& slot) const;
+
+  void Allocate(Slot& slot);
+  void Free(Slot& slot);
+
+  usize _idleFrames;
+  usize _frame;
+
+  uint32 _width, _height;
+  uint32 _pendingWidth, _pendingHeight;
+  usize _pendingFrames;
+
+  std::vector<Slot> _slots;
+  std::vector<FrameBuffer> _frameBuffers;
+  usize _alive;
+  usize _allocations;
+};
+
+}  // namespace over::graph
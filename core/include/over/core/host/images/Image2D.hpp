@@ -25,6 +25,8 @@ class Image2D {
   const std::vector<std::byte>& Data() const noexcept { return _data; }
 
   static Image2D FromFile(std::string_view);
+  // PNG, rows top to bottom
+  void ToFile(std::string_view filename) const;
 
  private:
   usize _width, _height;
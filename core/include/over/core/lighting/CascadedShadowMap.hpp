@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+#include <over/core/Camera.hpp>
+#include <over/core/Frustum.hpp>
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/views/FrameBufferView.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/opengl/wrappers/FrameBufferWrapper.hpp>
+#include <over/core/opengl/wrappers/TextureWrapper.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::lighting {
+
+// Cascaded shadow maps of a directional light, one depth texture array
+// layer per cascade. Each cascade is an orthographic light projection
+// around the bounding sphere of its camera frustum slice: its size does not
+// change when the camera turns and its origin snaps to whole texels, so
+// shadow edges do not shimmer. Static casters are rendered into a cache only
+// when the cascade moved by a texel, the light turned or the cache was
+// invalidated; updates copy the cache and draw dynamic casters over it.
+// Far cascades update every few frames
+class CascadedShadowMap {
+ public:
+  static constexpr uint32 MAX_CASCADES = 4;
+  // Texture unit of Bind, after the G-buffer units
+  static constexpr usize SHADOW_UNIT = 11;
+
+  // Depth program of casters: uniforms lightViewProjection and model
+  CascadedShadowMap(std::string vertexPath, std::string fragmentPath,
+                    uint32 resolution = 2048, uint32 cascades = MAX_CASCADES);
+
+  CascadedShadowMap(const CascadedShadowMap&) = delete;
+  CascadedShadowMap& operator=(const CascadedShadowMap&) = delete;
+
+  CascadedShadowMap(CascadedShadowMap&&) noexcept = default;
+  CascadedShadowMap& operator=(CascadedShadowMap&&) noexcept = default;
+
+  ~CascadedShadowMap() = default;
+
+  // Fits cascades to the camera and re-renders the ones due this frame.
+  // drawStatic(shader, frustum) and drawDynamic(shader, frustum) draw
+  // casters inside the cascade volume with the depth program in use,
+  // e.g. with Model::DrawDepth. Direction points from the light
+  template <class S, class D>
+  void Update(const Camera& camera, glm::vec3 direction, S&& drawStatic,
+              D&& drawDynamic);
+
+  // Static casters moved, re-render them on the next update of each cascade
+  void InvalidateStatic() noexcept;
+
+  // Sampler shadowMap (sampler2DArrayShadow), cascadeCount, cascadeSplits
+  // (far view depths) and cascadeMatrices[], which take positions from the
+  // shading space: pass inverse view for view space shading
+  void Bind(Shader& shader, const glm::mat4& toWorld);
+
+#pragma region Tuning
+
+  // Shadows end at this view depth (or the camera far plane)
+  float32 GetShadowDistance() const noexcept { return _shadowDistance; }
+  void SetShadowDistance(float32 distance) noexcept;
+
+  // 0 - uniform splits, 1 - logarithmic splits
+  float32 GetSplitLambda() const noexcept { return _splitLambda; }
+  void SetSplitLambda(float32 lambda) noexcept;
+
+  // How far behind a cascade (towards the light) casters are kept
+  float32 GetCasterDistance() const noexcept { return _casterDistance; }
+  void SetCasterDistance(float32 distance) noexcept;
+
+  uint32 GetUpdateInterval(uint32 cascade) const noexcept {
+    return _cascades[cascade].interval;
+  }
+  void SetUpdateInterval(uint32 cascade, uint32 frames) noexcept {
+    _cascades[cascade].interval = frames == 0 ? 1 : frames;
+  }
+
+#pragma endregion
+
+  uint32 GetCascadeCount() const noexcept { return _count; }
+  uint32 GetResolution() const noexcept { return _resolution; }
+  float32 GetSplit(uint32 cascade) const noexcept {
+    return _cascades[cascade].split;
+  }
+  const glm::mat4& GetMatrix(uint32 cascade) const noexcept {
+    return _cascades[cascade].viewProjection;
+  }
+
+  // Work of the last Update
+  uint32 GetUpdatedCascades() const noexcept { return _updated; }
+  uint32 GetStaticRenders() const noexcept { return _staticRenders; }
+
+  gl::TextureView<gl::TextureTarget::TEXTURE_2D_ARRAY> GetTexture() {
+    return _shadow.As<gl::TextureTarget::TEXTURE_2D_ARRAY>();
+  }
+
+ private:
+  class Cascade {
+   public:
+    // The map was rendered with it, shading must use the same
+    glm::mat4 viewProjection = glm::mat4(1.f);
+    Frustum frustum;
+    float32 split = 0.f;
+    uint32 interval = 1;
+    bool staticValid = false;
+    bool rendered = false;
+    // Due this frame
+    bool update = false;
+  };
+
+  // Splits, matrices and which cascades update this frame
+  void Fit(const Camera& camera, glm::vec3 direction);
+  glm::mat4 FitCascade(const CameraSnapshot& camera, const glm::mat4& light,
+                       float32 from, float32 to) const noexcept;
+
+  void Begin();
+  // Binds the static cache layer if it has to be re-rendered
+  bool BeginStatic(uint32 cascade);
+  // Copies the cache into the shadow layer and binds it
+  void BeginDynamic(uint32 cascade);
+  void End();
+
+  Shader _shader;
+  uint32 _resolution;
+  uint32 _count;
+
+  float32 _shadowDistance;
+  float32 _splitLambda;
+  float32 _casterDistance;
+
+  glm::vec3 _direction;
+  std::array<Cascade, MAX_CASCADES> _cascades;
+  usize _frame;
+  uint32 _updated;
+  uint32 _staticRenders;
+
+  gl::TextureWrapper<> _static;
+  gl::TextureWrapper<> _shadow;
+  gl::FrameBufferWrapper<> _staticFrame;
+  gl::FrameBufferWrapper<> _shadowFrame;
+
+  // restored by End
+  std::array<GLint, 4> _viewport;
+};
+
+template <class S, class D>
+void CascadedShadowMap::Update(const Camera& camera, glm::vec3 direction,
+                               S&& drawStatic, D&& drawDynamic) {
+  Fit(camera, direction);
+  if (_updated == 0) {
+    return;
+  }
+
+  _shader.Use([&] {
+    Begin();
+    for (uint32 i = 0; i < _count; i++) {
+      auto& cascade = _cascades[i];
+      if (!cascade.update) {
+        continue;
+      }
+
+      if (BeginStatic(i)) {
+        drawStatic(_shader, static_cast<const Frustum&>(cascade.frustum));
+      }
+
+      BeginDynamic(i);
+      drawDynamic(_shader, static_cast<const Frustum&>(cascade.frustum));
+    }
+    End();
+  });
+}
+
+}  // namespace over::lighting
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <over/core/Camera.hpp>
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/views/BufferView.hpp>
+#include <over/core/opengl/wrappers/BufferWrapper.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::lighting {
+
+// std430 vec4 pair. Light reaches zero at radius
+class PointLight {
+ public:
+  glm::vec3 position;
+  float32 radius;
+  glm::vec3 color;
+  float32 intensity;
+};
+
+static_assert(sizeof(PointLight) == 32);
+
+// Lights of a cluster are indices [offset, offset + count) of the index list
+class Cluster {
+ public:
+  uint32 offset;
+  uint32 count;
+};
+
+// Clustered forward shading. The view frustum is split into froxels: a
+// screen tile grid times exponential depth slices. Update assigns point
+// lights to the froxels their sphere touches, on the CPU, and uploads the
+// lights, the cluster ranges and the index list to storage buffers.
+// Fragments shade only the lights of their cluster. Needs GL 4.3
+class ClusteredLights {
+ public:
+  // Storage buffer bindings of the shading program
+  static constexpr usize LIGHTS_BINDING = 6;
+  static constexpr usize CLUSTERS_BINDING = 7;
+  static constexpr usize INDICES_BINDING = 8;
+
+  static constexpr uint32 CLUSTERS_X = 16;
+  static constexpr uint32 CLUSTERS_Y = 9;
+  static constexpr uint32 CLUSTERS_Z = 24;
+
+  // Clusters of a row are tested 4 at a time, rows are padded
+  static constexpr uint32 BATCH = 4;
+
+  explicit ClusteredLights(glm::uvec3 grid = {CLUSTERS_X, CLUSTERS_Y,
+                                              CLUSTERS_Z});
+
+  ClusteredLights(const ClusteredLights&) = delete;
+  ClusteredLights& operator=(const ClusteredLights&) = delete;
+
+  ClusteredLights(ClusteredLights&&) noexcept = default;
+  ClusteredLights& operator=(ClusteredLights&&) noexcept = default;
+
+  ~ClusteredLights() = default;
+
+  // World space lights, may be changed freely between updates
+  std::vector<PointLight>& GetLights() noexcept { return _lights; }
+  const std::vector<PointLight>& GetLights() const noexcept { return _lights; }
+  void SetLights(std::vector<PointLight> lights) noexcept {
+    _lights = std::move(lights);
+  }
+
+  // Assigns lights to clusters of this view and uploads the lists.
+  // Uploaded light positions are view space, as cluster lookups are
+  void Update(const Camera& camera);
+  void Update(const glm::mat4& view, const glm::mat4& projection,
+              float32 zNear, float32 zFar);
+
+  // Binds the buffers and sets cluster uniforms, shader must be in use
+  void Bind(Shader& shader, glm::ivec2 viewport);
+
+  glm::uvec3 GetGrid() const noexcept { return _grid; }
+  usize GetClusterCount() const noexcept { return _clusters.size(); }
+
+  // Statistics of the last Update
+  usize GetVisibleLights() const noexcept { return _visibleLights; }
+  usize GetIndexCount() const noexcept { return _indices.size(); }
+  uint32 GetMaxClusterLights() const noexcept { return _maxClusterLights; }
+
+  // Lights of the cluster as assigned by the last Update
+  const Cluster& GetCluster(uint32 x, uint32 y, uint32 z) const noexcept {
+    return _clusters[x + _grid.x * (y + _grid.y * z)];
+  }
+  const std::vector<uint32>& GetIndices() const noexcept { return _indices; }
+
+  static const char* GetInstructionSet() noexcept;
+
+ private:
+  // Hit clusters of one light, before they are grouped by cluster
+  class Assignment {
+   public:
+    uint32 cluster;
+    uint32 light;
+  };
+
+  // Froxel view space boxes as structure of arrays, row by row
+  void BuildBounds(const glm::mat4& projection, float32 zNear, float32 zFar);
+  void Assign(const PointLight& light, glm::vec3 center, uint32 index);
+  void Upload();
+
+  float32 DepthToSlice(float32 depth) const noexcept;
+
+  glm::uvec3 _grid;
+  uint32 _stride;  // row length padded to BATCH
+
+  std::vector<PointLight> _lights;
+
+  // Bounds are rebuilt only when the projection changes
+  glm::mat4 _projection;
+  float32 _near, _far;
+  float32 _depthScale, _depthBias;
+  std::vector<float32> _minX, _minY, _minZ;
+  std::vector<float32> _maxX, _maxY, _maxZ;
+  std::vector<float32> _sliceDepth;  // grid.z + 1 slice boundaries
+
+  std::vector<PointLight> _viewLights;
+  std::vector<Assignment> _assignments;
+  std::vector<Cluster> _clusters;
+  std::vector<uint32> _indices;
+  usize _visibleLights;
+  uint32 _maxClusterLights;
+
+  gl::BufferWrapper<> _lightBuffer;
+  gl::BufferWrapper<> _clusterBuffer;
+  gl::BufferWrapper<> _indexBuffer;
+};
+
+}  // namespace over::lighting
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/views/FrameBufferView.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/opengl/wrappers/Exception.hpp>
+#include <over/core/opengl/wrappers/FrameBufferWrapper.hpp>
+#include <over/core/opengl/wrappers/TextureWrapper.hpp>
+
+namespace over::lighting {
+
+// Deferred shading targets, 8 bytes per pixel plus depth:
+// RGBA8 albedo + specular intensity, RG16 octahedral view space normal.
+// There is no position target, lighting reconstructs it from depth
+class GBuffer {
+ public:
+  enum Target : usize { ALBEDO_SPECULAR = 0, NORMAL, TARGETS };
+
+  // Units of BindTextures, above the units meshes bind their textures to
+  static constexpr usize ALBEDO_SPECULAR_UNIT = 8;
+  static constexpr usize NORMAL_UNIT = 9;
+  static constexpr usize DEPTH_UNIT = 10;
+
+  GBuffer();
+
+  GBuffer(const GBuffer&) = delete;
+  GBuffer& operator=(const GBuffer&) = delete;
+
+  GBuffer(GBuffer&&) noexcept = default;
+  GBuffer& operator=(GBuffer&&) noexcept = default;
+
+  ~GBuffer() = default;
+
+  // (Re)allocates the targets, nothing happens if the size did not change
+  void Resize(uint32 width, uint32 height);
+
+  // Binds the frame buffer with a viewport of its size, clears every target
+  // and calls geometry(), fragment outputs 0 and 1 are ALBEDO_SPECULAR and
+  // NORMAL. The caller's viewport is restored afterwards
+  template <class F>
+  void Render(F&& geometry);
+
+  // Samplers gAlbedoSpecular, gNormal and gDepth, shader must be in use
+  void BindTextures(Shader& shader);
+
+  gl::Texture2DView GetTarget(Target target) {
+    return _targets[target].As<gl::TextureTarget::TEXTURE_2D>();
+  }
+  gl::Texture2DView GetDepth() {
+    return _depth.As<gl::TextureTarget::TEXTURE_2D>();
+  }
+  gl::FrameBufferWrapper<>& GetFrameBuffer() noexcept { return _frame; }
+
+  uint32 GetWidth() const noexcept { return _width; }
+  uint32 GetHeight() const noexcept { return _height; }
+
+ private:
+  void Clear();
+
+  uint32 _width, _height;
+
+  std::array<gl::TextureWrapper<>, TARGETS> _targets;
+  gl::TextureWrapper<> _depth;
+  gl::FrameBufferWrapper<> _frame;
+};
+
+template <class F>
+void GBuffer::Render(F&& geometry) {
+  // the caller's viewport may be the window while the targets are scaled
+  std::array<GLint, 4> viewport{};
+  glthrow(glGetIntegerv(GL_VIEWPORT, viewport.data()));
+
+  auto frame = _frame.As<gl::FrameBufferTarget::FRAMEBUFFER>();
+  frame.Bind();
+  glthrow(glViewport(0, 0, static_cast<GLsizei>(_width),
+                     static_cast<GLsizei>(_height)));
+  Clear();
+  geometry();
+  frame.Unbind();
+
+  glthrow(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+}
+
+}  // namespace over::lighting
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <over/core/Includes.hpp>
+#include <over/core/Types.hpp>
+
+namespace over::gl {
+// Memory barriers between compute writes and following reads (GL 4.3+).
+// Barrier bit names the way data is READ after the barrier, not written
+class Barrier final {
+ public:
+  static void Memory(GLbitfield barriers);
+
+  // SSBO written by compute, read by shaders
+  static void ShaderStorage();
+  // image2D written by compute, read by imageLoad
+  static void ImageAccess();
+  // image2D written by compute, read by texture()/sampler
+  static void TextureFetch();
+  // buffer written by compute, used as indirect draw/dispatch arguments
+  static void Command();
+  // buffer written by compute, used as vertex/index data
+  static void VertexData();
+  // buffer written by compute, read back to the CPU
+  static void BufferUpdate();
+
+  static void All();
+};
+}  // namespace over::gl
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <over/core/Includes.hpp>
+
+namespace over::gl {
+
+// Frame buffer standing in for 0 wherever the code means "the screen": the
+// window's own, or an offscreen one when the context has no surface
+GLuint GetDefaultFrameBuffer() noexcept;
+void SetDefaultFrameBuffer(GLuint id) noexcept;
+
+}  // namespace over::gl
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <over/core/Types.hpp>
+
+namespace over::gl {
+
+// Arguments of glDrawElementsIndirect as laid out in DRAW_INDIRECT_BUFFER
+class DrawElementsCommand {
+ public:
+  uint32 count = 0;
+  uint32 instanceCount = 0;
+  uint32 firstIndex = 0;
+  int32 baseVertex = 0;
+  uint32 baseInstance = 0;
+};
+
+static_assert(sizeof(DrawElementsCommand) == 20);
+
+}  // namespace over::gl
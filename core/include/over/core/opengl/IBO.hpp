@@ -38,7 +38,7 @@ class IBO : public Binded<IBO> {
   void Bind(bool copy = false) const;
   void Unbind() const;
 
-  usize Size() { return _elements.size() * 3; }
+  usize Size() const noexcept { return _elements.size() * 3; }
 
   std::vector<Element>& GetElements() noexcept { return _elements; }
   const std::vector<Element>& GetElements() const noexcept { return _elements; }
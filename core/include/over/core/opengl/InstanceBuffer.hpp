@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+
+#include <over/core/Includes.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/Binded.hpp>
+#include <over/core/opengl/views/BufferView.hpp>
+#include <over/core/opengl/wrappers/BufferWrapper.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over {
+
+// Per-instance data, streamed next to the per-vertex VBO data
+class Instance {
+ public:
+  glm::mat4 model;
+  glm::vec4 color;
+  uint32 material;
+
+  Instance();
+  Instance(glm::mat4 model, glm::vec4 color, uint32 material);
+};
+
+// HiZCullCompute.shader copies instances as INSTANCE_SIZE (21) floats
+static_assert(sizeof(Instance) == 21 * sizeof(float32));
+
+class InstanceBuffer : public Binded<InstanceBuffer> {
+ public:
+  InstanceBuffer() noexcept;
+  explicit InstanceBuffer(std::vector<Instance> instances,
+                          GLenum usage = GL_STREAM_DRAW);
+
+  InstanceBuffer(const InstanceBuffer&) = delete;
+  InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+  InstanceBuffer(InstanceBuffer&&) noexcept = default;
+  InstanceBuffer& operator=(InstanceBuffer&&) noexcept = default;
+
+  ~InstanceBuffer() = default;
+
+  // Uploads all instances in one call, the buffer only grows
+  void ToGPU(bool unbind = false);
+  // Grows GPU storage without uploading, for instances written by shaders
+  void Reserve(usize count);
+  usize Capacity() const noexcept { return _capacity; }
+
+  // Binds as shader storage buffer, std430 stride is 21 floats (no padding)
+  void BindStorage(usize index) const;
+
+  void Bind() const;
+  void Unbind() const;
+
+  usize Size() const noexcept { return _instances.size(); }
+
+  std::vector<Instance>& GetInstances() noexcept { return _instances; }
+  const std::vector<Instance>& GetInstances() const noexcept {
+    return _instances;
+  }
+
+  // Use only for low level functions
+  GLuint Get() const noexcept { return *_buffer.Get(); }
+
+ private:
+  std::vector<Instance> _instances;
+
+  gl::BufferWrapper<> _buffer;
+  usize _capacity;
+  GLenum _usage;
+};
+
+}  // namespace over
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <over/core/Includes.hpp>
+#include <over/core/Types.hpp>
+
+namespace over::gl {
+
+// Driver work counted by the GL wrappers
+class RenderCounters {
+ public:
+  uint64 drawCalls = 0;
+  // indirect draws add none, their counts live on the GPU
+  uint64 triangles = 0;
+  uint64 instances = 0;
+  uint64 dispatches = 0;
+
+  // binds that reached GL, the shader skips redundant program binds
+  uint64 programBinds = 0;
+  uint64 layoutBinds = 0;
+  uint64 textureBinds = 0;
+  uint64 frameBufferBinds = 0;
+  uint64 uniformCalls = 0;
+
+  uint64 bufferBytes = 0;
+  uint64 textureBytes = 0;
+
+  // textures, buffers, layouts, frame and render buffers, programs
+  uint64 created = 0;
+  uint64 destroyed = 0;
+
+  RenderCounters& operator-=(const RenderCounters& other) noexcept;
+  friend RenderCounters operator-(RenderCounters a,
+                                  const RenderCounters& b) noexcept {
+    return a -= b;
+  }
+};
+
+class PassCounters {
+ public:
+  std::string name;
+  RenderCounters counters;
+};
+
+// Per frame GL statistics. The wrappers add to running totals through
+// OVER_RENDER_STAT, a frame is the difference between two NextFrame calls
+// and a pass the difference between BeginPass and EndPass, so counting is
+// one add per call. The last HISTORY frames are kept for CSV export.
+// Counting compiles out without OVER_RENDER_STATS (independent of the
+// profiler), the stats stay zero then. GL thread only
+class RenderStats {
+ public:
+  static constexpr usize HISTORY = 128;
+
+  static RenderStats& Instance();
+
+  RenderStats(const RenderStats&) = delete;
+  RenderStats& operator=(const RenderStats&) = delete;
+
+  ~RenderStats() = default;
+
+  RenderCounters& GetTotals() noexcept { return _totals; }
+
+  // Passes do not nest, a new one ends the open one
+  void BeginPass(std::string_view name);
+  void EndPass();
+  void NextFrame();
+
+  // Last finished frame and its passes
+  const RenderCounters& GetFrame() const;
+  const std::vector<PassCounters>& GetPasses() const;
+  usize GetFrameCount() const noexcept;
+
+  // frame,pass,counters... rows of the kept frames, pass "total" holds the
+  // whole frame. Stable columns for regression tracking
+  std::string ExportCsv() const;
+
+ private:
+  class Frame {
+   public:
+    usize index = 0;
+    RenderCounters counters;
+    std::vector<PassCounters> passes;
+  };
+
+  RenderStats();
+
+  RenderCounters _totals;
+  RenderCounters _frameStart;
+  RenderCounters _passStart;
+  std::string _pass;
+  bool _inPass;
+  std::vector<PassCounters> _passes;
+
+  std::vector<Frame> _frames;
+  usize _frameIndex;
+};
+
+// Pass of the enclosing scope
+class ScopedPassStats {
+ public:
+  explicit ScopedPassStats(std::string_view name) {
+    RenderStats::Instance().BeginPass(name);
+  }
+
+  ScopedPassStats(const ScopedPassStats&) = delete;
+  ScopedPassStats& operator=(const ScopedPassStats&) = delete;
+
+  ~ScopedPassStats() { RenderStats::Instance().EndPass(); }
+};
+
+// Bytes of texels in format/type uploaded from client memory
+usize GetUploadSize(GLenum format, GLenum type, usize texels) noexcept;
+
+}  // namespace over::gl
+
+#define OVER_RENDER_STATS_CONCAT_IMPL(a, b) a##b
+#define OVER_RENDER_STATS_CONCAT(a, b) OVER_RENDER_STATS_CONCAT_IMPL(a, b)
+
+#ifdef OVER_RENDER_STATS
+#define OVER_RENDER_STAT(counter, value) \
+  (::over::gl::RenderStats::Instance().GetTotals().counter += (value))
+#define OVER_RENDER_STATS_PASS(name) \
+  ::over::gl::ScopedPassStats OVER_RENDER_STATS_CONCAT(overPass, __LINE__)(name)
+#define OVER_RENDER_STATS_FRAME() ::over::gl::RenderStats::Instance().NextFrame()
+#else
+#define OVER_RENDER_STAT(counter, value) ((void)0)
+#define OVER_RENDER_STATS_PASS(name) ((void)0)
+#define OVER_RENDER_STATS_FRAME() ((void)0)
+#endif
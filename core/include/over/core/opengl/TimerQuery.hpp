@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+
+#include <over/core/Includes.hpp>
+#include <over/core/Types.hpp>
+
+namespace over::gl {
+// GPU time of the commands between Begin and End, from a pair of
+// GL_TIMESTAMP queries, so timers can nest. Pairs rotate through LATENCY
+// slots and results are read when the slot is reused, so reading never
+// waits for the GPU
+class TimerQuery final {
+ public:
+  static constexpr usize LATENCY = 3;
+
+  TimerQuery() noexcept;
+
+  TimerQuery(const TimerQuery&) = delete;
+  TimerQuery& operator=(const TimerQuery&) = delete;
+
+  TimerQuery(TimerQuery&& other) noexcept;
+  TimerQuery& operator=(TimerQuery&& other) noexcept;
+
+  ~TimerQuery();
+
+  void Begin();
+  void End();
+
+  // Latest finished measurement, LATENCY - 1 frames old
+  float64 GetMilliseconds() const noexcept { return _milliseconds; }
+
+ private:
+  void Free() noexcept;
+
+  // begin and end timestamps of every slot
+  std::array<GLuint, 2 * LATENCY> _queries;
+  usize _frame;
+  float64 _milliseconds;
+};
+}  // namespace over::gl
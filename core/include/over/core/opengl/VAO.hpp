@@ -22,6 +22,17 @@ class VAO : public Binded<VAO> {
 
   void AttachAttribute(uint32 location, uint32 count, GLenum type, usize size,
                        usize offset);
+  void AttachIntegerAttribute(uint32 location, uint32 count, GLenum type,
+                              usize size, usize offset);
+
+  void AttachInstancedAttribute(uint32 location, uint32 count, GLenum type,
+                                usize size, usize offset, uint32 divisor = 1);
+  void AttachInstancedIntegerAttribute(uint32 location, uint32 count,
+                                       GLenum type, usize size, usize offset,
+                                       uint32 divisor = 1);
+  // mat4 takes 4 consecutive locations: [location, location + 3]
+  void AttachInstancedMatrix(uint32 location, usize size, usize offset,
+                             uint32 divisor = 1);
 
   void Bind() const;
   void Unbind() const noexcept;
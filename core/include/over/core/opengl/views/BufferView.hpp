@@ -4,6 +4,7 @@
 #include <over/core/Types.hpp>
 #include <over/core/opengl/Address.hpp>
 #include <over/core/opengl/Binded.hpp>
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/targets/BufferTarget.hpp>
 #include <over/core/opengl/wrappers/BufferWrapper.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
@@ -32,7 +33,7 @@ class BufferView : public Binded<BufferView<Target>> {
   void Unbind() const { glthrow(glBindBuffer(_target, 0)); }
 
 #pragma region Uniform
-  // For Uniform & Transform feedback buffers ONLY
+  // For Uniform, Shader storage, Atomic counter & Transform feedback buffers ONLY
 
   void BindBase(usize index) {
     glthrow(glBindBufferBase(_target, static_cast<GLuint>(index), *_ptr));
@@ -52,6 +53,9 @@ class BufferView : public Binded<BufferView<Target>> {
     }
 
     glthrow(glBufferData(_target, static_cast<GLsizeiptr>(size), data, usage));
+    if (data != nullptr) {
+      OVER_RENDER_STAT(bufferBytes, size);
+    }
   }
 
   void Write(usize offset, usize size, const void* data) {
@@ -61,6 +65,27 @@ class BufferView : public Binded<BufferView<Target>> {
 
     glthrow(glBufferSubData(_target, static_cast<GLintptr>(offset),
                             static_cast<GLsizeiptr>(size), data));
+    OVER_RENDER_STAT(bufferBytes, size);
+  }
+
+  // Synchronous readback, waits for the GPU
+  void Read(usize offset, usize size, void* data) const {
+    if (0 == *_ptr) {
+      return;
+    }
+
+    glthrow(glGetBufferSubData(_target, static_cast<GLintptr>(offset),
+                               static_cast<GLsizeiptr>(size), data));
+  }
+
+  // Fills the buffer with the same value, e.g. zeroes atomic counters
+  void Fill(GLenum internalFormat, GLenum format, GLenum type,
+            const void* data) {
+    if (0 == *_ptr) {
+      return;
+    }
+
+    glthrow(glClearBufferData(_target, internalFormat, format, type, data));
   }
 
   void Clear(GLenum usage = GL_STATIC_DRAW) {
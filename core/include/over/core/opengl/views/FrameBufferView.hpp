@@ -1,11 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+
 #include <over/core/Includes.hpp>
 #include <over/core/opengl/Address.hpp>
 #include <over/core/opengl/Binded.hpp>
+#include <over/core/opengl/DefaultFrameBuffer.hpp>
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/targets/RenderBufferTarget.hpp>
 #include <over/core/opengl/targets/TextureTarget.hpp>
 #include <over/core/opengl/views/RenderBufferView.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
 #include <over/core/opengl/wrappers/FrameBufferWrapper.hpp>
 
@@ -15,6 +22,9 @@ class FrameBufferView : public Binded<FrameBufferView<Target>> {
   constexpr static GLenum _target = static_cast<GLenum>(Target);
 
  public:
+  // Draw buffers every implementation supports
+  constexpr static usize MAX_DRAW_BUFFERS = 8;
+
   FrameBufferView() noexcept : _ptr(nullptr) {}
   FrameBufferView(nullptr_t) noexcept : FrameBufferView() {}
   explicit FrameBufferView(Address ptr) noexcept : _ptr(ptr) {}
@@ -27,9 +37,14 @@ class FrameBufferView : public Binded<FrameBufferView<Target>> {
 
   ~FrameBufferView() = default;
 
-  void Bind() const { glthrow(glBindFramebuffer(_target, *_ptr)); }
+  void Bind() const {
+    glthrow(glBindFramebuffer(_target, *_ptr));
+    OVER_RENDER_STAT(frameBufferBinds, 1);
+  }
 
-  void Unbind() const { glthrow(glBindFramebuffer(_target, 0)); }
+  void Unbind() const {
+    glthrow(glBindFramebuffer(_target, GetDefaultFrameBuffer()));
+  }
 
   template <TextureTarget TexTarget>
   void Attach(GLenum attachment, gl::TextureView<TexTarget> view, usize level) {
@@ -38,6 +53,15 @@ class FrameBufferView : public Binded<FrameBufferView<Target>> {
                                    *view._ptr, static_cast<GLint>(level)));
   }
 
+  // One layer of a texture array or 3D texture
+  template <TextureTarget TexTarget>
+  void AttachLayer(GLenum attachment, gl::TextureView<TexTarget> view,
+                   usize level, usize layer) {
+    glthrow(glFramebufferTextureLayer(_target, attachment, *view._ptr,
+                                      static_cast<GLint>(level),
+                                      static_cast<GLint>(layer)));
+  }
+
   template <RenderBufferTarget RenTarget>
   void Attach(GLenum attachment, gl::RenderBufferView<RenTarget> view) {
     constexpr GLenum _renderBufferTarget = static_cast<GLenum>(RenTarget);
@@ -45,6 +69,28 @@ class FrameBufferView : public Binded<FrameBufferView<Target>> {
                                       *view._ptr));
   }
 
+  // Multiple render targets: fragment output i goes to attachments[i]
+  void SetDrawBuffers(std::initializer_list<GLenum> attachments) {
+    glthrow(glDrawBuffers(static_cast<GLsizei>(attachments.size()),
+                          attachments.begin()));
+  }
+
+  // Outputs 0..count-1 go to color attachments 0..count-1
+  void SetDrawBuffers(usize count) {
+    std::array<GLenum, MAX_DRAW_BUFFERS> attachments{};
+    count = std::min(count, MAX_DRAW_BUFFERS);
+    for (usize i = 0; i < count; i++) {
+      attachments[i] = static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + i);
+    }
+    glthrow(
+        glDrawBuffers(static_cast<GLsizei>(count), attachments.data()));
+  }
+
+  // Color attachment read by blits and pixel reads
+  void SetReadBuffer(GLenum attachment) {
+    glthrow(glReadBuffer(attachment));
+  }
+
   bool IsReady() const noexcept {
     return GetStatus() == GL_FRAMEBUFFER_COMPLETE;
   }
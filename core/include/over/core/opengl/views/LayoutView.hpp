@@ -3,6 +3,7 @@
 #include <over/core/Types.hpp>
 #include <over/core/opengl/Address.hpp>
 #include <over/core/opengl/Binded.hpp>
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/targets/LayoutTarget.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
 #include <over/core/opengl/wrappers/LayoutWrapper.hpp>
@@ -23,7 +24,10 @@ class LayoutView : public Binded<LayoutView<Target>> {
 
   ~LayoutView() = default;
 
-  void Bind() const { glthrow(glBindVertexArray(*_ptr)); }
+  void Bind() const {
+    glthrow(glBindVertexArray(*_ptr));
+    OVER_RENDER_STAT(layoutBinds, 1);
+  }
 
   void Unbind() const { glthrow(glBindVertexArray(0)); }
 
@@ -34,6 +38,19 @@ class LayoutView : public Binded<LayoutView<Target>> {
         static_cast<GLsizei>(shift), reinterpret_cast<void*>(offset)));
   }
 
+  void SetIntegerAttribute(usize index, int32 size, GLenum type, usize shift,
+                           usize offset) {
+    glthrow(glVertexAttribIPointer(
+        static_cast<GLuint>(index), static_cast<GLint>(size), type,
+        static_cast<GLsizei>(shift), reinterpret_cast<void*>(offset)));
+  }
+
+  // 0 - per vertex, N - advance attribute every N instances
+  void SetAttributeDivisor(usize index, uint32 divisor) {
+    glthrow(glVertexAttribDivisor(static_cast<GLuint>(index),
+                                  static_cast<GLuint>(divisor)));
+  }
+
   void EnableAttribute(usize index) {
     assert(index < GL_MAX_VERTEX_ATTRIBS);
     glthrow(glEnableVertexAttribArray(index));
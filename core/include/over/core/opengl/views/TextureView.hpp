@@ -1,5 +1,6 @@
 #pragma once
 
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/targets/FrameBufferTarget.hpp>
 #include <over/core/opengl/targets/TextureTarget.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
@@ -24,7 +25,10 @@ class TextureView : public Binded<TextureView<Target>> {
 
   ~TextureView() = default;
 
-  void Bind() const { glthrow(glBindTexture(_target, *_ptr)); }
+  void Bind() const {
+    glthrow(glBindTexture(_target, *_ptr));
+    OVER_RENDER_STAT(textureBinds, 1);
+  }
 
   void Unbind() const { glthrow(glBindTexture(_target, 0)); }
 
@@ -45,6 +49,10 @@ class TextureView : public Binded<TextureView<Target>> {
     glthrow(glTexImage2D(target, 0, static_cast<GLint>(internalFormat),
                          static_cast<GLsizei>(width),
                          static_cast<GLsizei>(height), 0, format, type, data));
+    if (data != nullptr) {
+      OVER_RENDER_STAT(textureBytes,
+                       GetUploadSize(format, type, width * height));
+    }
   }
 
   void Reserve2DAsMultisample(GLenum target, int32 internalFormat,
@@ -55,12 +63,50 @@ class TextureView : public Binded<TextureView<Target>> {
                                     height, fixedLocations));
   }
 
+  // Texture arrays and 3D textures, depth is the layer count
+  void Reserve3D(int32 internalFormat, usize width, usize height, usize depth,
+                 GLenum format, GLenum type, const void* data) {
+    glthrow(glTexImage3D(_target, 0, static_cast<GLint>(internalFormat),
+                         static_cast<GLsizei>(width),
+                         static_cast<GLsizei>(height),
+                         static_cast<GLsizei>(depth), 0, format, type, data));
+    if (data != nullptr) {
+      OVER_RENDER_STAT(textureBytes,
+                       GetUploadSize(format, type, width * height * depth));
+    }
+  }
+
   void Clear2D(GLenum internalFormat = GL_RGB, GLenum format = GL_RGB,
                GLenum type = GL_UNSIGNED_BYTE) {
     glthrow(glTexImage2D(_target, 0, internalFormat, 0, 0, 0, format, type,
                          nullptr));
   }
 
+  // Immutable storage, required to get stable image load/store formats
+  void Storage2D(usize levels, GLenum internalFormat, usize width,
+                 usize height) {
+    glthrow(glTexStorage2D(_target, static_cast<GLsizei>(levels),
+                           internalFormat, static_cast<GLsizei>(width),
+                           static_cast<GLsizei>(height)));
+  }
+
+#pragma region Image
+  // Image load/store, used by compute shaders (image2D uniforms)
+
+  void BindImage(usize unit, usize level, GLenum access, GLenum format,
+                 bool layered = false, usize layer = 0) const {
+    glthrow(glBindImageTexture(static_cast<GLuint>(unit), *_ptr,
+                               static_cast<GLint>(level), layered,
+                               static_cast<GLint>(layer), access, format));
+  }
+
+  void UnbindImage(usize unit) const {
+    glthrow(glBindImageTexture(static_cast<GLuint>(unit), 0, 0, GL_FALSE, 0,
+                               GL_READ_ONLY, GL_R8));
+  }
+
+#pragma endregion
+
   void GenerateMipmap() { glthrow(glGenerateMipmap(_target)); }
 
   [[nodiscard]] GLint GetParameter(GLenum name) const {
@@ -73,6 +119,8 @@ class TextureView : public Binded<TextureView<Target>> {
     glthrow(glTexParameteri(_target, name, value));
   }
 
+  const Address& Get() const noexcept { return _ptr; }
+
  private:
   Address _ptr;
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <over/core/Mesh.hpp>
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/graph/RenderTargetPool.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::post {
+
+// Bloom through a mip chain of pooled R11F_G11F_B10F targets. The first
+// level is a thresholded 13 tap downsample of the source at half
+// resolution, every next level halves the previous one. The way back
+// blends a 3x3 tent upsample of each level additively into the level above,
+// so level 0 ends up with every blur radius at once, in 2 * levels cheap
+// passes instead of full resolution blurs. Composite it with
+// Effect::BloomComposite
+class Bloom {
+ public:
+  // Levels of the chain, each one doubles the blur radius
+  enum class Quality : uint32 { LOW = 3, MEDIUM = 5, HIGH = 7 };
+
+  static constexpr GLenum FORMAT = GL_R11F_G11F_B10F;
+
+  // Fullscreen vertex shader, downsample with "source", "texelSize",
+  // "prefilter", "threshold", "knee" uniforms, upsample with "source",
+  // "texelSize", "radius"
+  Bloom(std::string vertexPath, std::string downsamplePath,
+        std::string upsamplePath, Quality quality = Quality::MEDIUM);
+
+  Bloom(const Bloom&) = delete;
+  Bloom& operator=(const Bloom&) = delete;
+
+  Bloom(Bloom&&) noexcept = default;
+  Bloom& operator=(Bloom&&) noexcept = default;
+
+  ~Bloom() = default;
+
+  Quality GetQuality() const noexcept { return _quality; }
+  void SetQuality(Quality quality) noexcept { _quality = quality; }
+
+  // Colors brighter than threshold bloom, the knee softens the cut
+  void SetThreshold(float32 threshold, float32 knee = 0.5f) noexcept;
+  // Upsample tent radius in texels of the smaller level
+  void SetRadius(float32 radius) noexcept { _radius = radius; }
+
+  // Renders the bloom of source (sampled bilinearly, its filter is set to
+  // linear). Targets come from the pool and stay valid until Release.
+  // The bound frame buffer and viewport are kept
+  gl::Texture2DView Render(graph::RenderTargetPool& pool,
+                           gl::Texture2DView source, glm::ivec2 size);
+  void Release(graph::RenderTargetPool& pool);
+
+  // Levels of the last Render, fewer than the quality for small sources
+  usize GetLevels() const noexcept { return _levels.size(); }
+
+ private:
+  void Draw(Shader& shader, gl::Texture2DView source, glm::ivec2 sourceSize);
+
+  Shader _downsample;
+  Shader _upsample;
+  Mesh _quad;
+
+  Quality _quality;
+  float32 _threshold;
+  float32 _knee;
+  float32 _radius;
+
+  std::vector<graph::RenderTarget> _levels;
+};
+
+}  // namespace over::post
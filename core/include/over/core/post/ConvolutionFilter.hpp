@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/opengl/views/BufferView.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/opengl/wrappers/BufferWrapper.hpp>
+#include <over/core/opengl/wrappers/TextureWrapper.hpp>
+#include <over/core/post/Kernel.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::post {
+
+// Convolution of a texture with compute shaders (GL 4.3). Separable kernels
+// run a row and a column pass through an RGBA16F intermediate, 2 * size taps
+// per pixel instead of size^2. General kernels load the tile of a work group
+// and its apron into shared memory once, taps read shared memory instead of
+// the texture. Edges are clamped
+class ConvolutionFilter {
+ public:
+  // Storage buffer binding of the weights
+  static constexpr usize WEIGHTS_BINDING = 9;
+  static constexpr usize DESTINATION_IMAGE = 0;
+
+  enum class Method {
+    // Separable if the kernel is, tiled otherwise
+    AUTO,
+    SEPARABLE,
+    TILED,
+    // A texture fetch per tap, like a fragment shader kernel
+    DIRECT,
+  };
+
+  // Compute shaders with "source" sampler2D, "destination" image, "size",
+  // "radius" uniforms and the weights storage block. The separable one also
+  // takes "direction" and "weightOffset", the tiled one "tiled"
+  ConvolutionFilter(std::string separablePath, std::string tiledPath);
+
+  ConvolutionFilter(const ConvolutionFilter&) = delete;
+  ConvolutionFilter& operator=(const ConvolutionFilter&) = delete;
+
+  ConvolutionFilter(ConvolutionFilter&&) noexcept = default;
+  ConvolutionFilter& operator=(ConvolutionFilter&&) noexcept = default;
+
+  ~ConvolutionFilter() = default;
+
+  // Convolves source into destination, both of size. Destination is written
+  // as an image of format, so it needs a load/store compatible format
+  void Apply(const Kernel& kernel, gl::Texture2DView source,
+             gl::Texture2DView destination, glm::ivec2 size,
+             GLenum format = GL_RGBA8, Method method = Method::AUTO);
+
+  // Method AUTO picks for the kernel
+  static Method Choose(const Kernel& kernel) noexcept;
+
+  // Method and texture or shared memory taps per pixel of the last Apply
+  Method GetMethod() const noexcept { return _method; }
+  usize GetTaps() const noexcept { return _taps; }
+
+ private:
+  void Upload(const Kernel& kernel, Method method);
+  void Resize(glm::ivec2 size);
+
+  void Separable(const Kernel& kernel, gl::Texture2DView source,
+                 gl::Texture2DView destination, glm::ivec2 size,
+                 GLenum format);
+  void General(const Kernel& kernel, gl::Texture2DView source,
+               gl::Texture2DView destination, glm::ivec2 size, GLenum format,
+               bool tiled);
+
+  Shader _separable;
+  Shader _tiled;
+
+  gl::BufferWrapper<> _weights;
+  // last upload, unchanged kernels are not uploaded again
+  std::vector<float32> _uploaded;
+
+  // row pass result of separable kernels
+  gl::TextureWrapper<> _intermediate;
+  glm::ivec2 _size;
+
+  Method _method;
+  usize _taps;
+};
+
+}  // namespace over::post
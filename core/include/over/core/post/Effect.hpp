@@ -0,0 +1,106 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <over/core/Types.hpp>
+#include <over/core/opengl/Binded.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/opengl/wrappers/TextureWrapper.hpp>
+#include <over/core/post/Kernel.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::post {
+
+using LutView = gl::TextureView<gl::TextureTarget::TEXTURE_3D>;
+
+// Node of a PostChain. Point-wise effects are GLSL statements changing
+// `vec4 color` of the pixel at `vec2 uv`, they never read other pixels, so
+// consecutive ones are fused into one shader. Parameters are written $name
+// in the code, the chain declares them per node. Sampling effects also read
+// neighbours of the pass input (`source`, `texelSize`), they start a fused
+// pass. Kernel effects run as their own compute pass
+class Effect {
+ public:
+  std::string name;
+  std::string code;
+  // GLSL at global scope, helper functions named $name as well
+  std::string functions;
+  // reads other pixels of the pass input
+  bool sampling = false;
+  std::vector<std::pair<std::string, float32>> floats;
+  // sampler2D parameters, sampled at uv
+  std::vector<std::pair<std::string, gl::Texture2DView>> textures;
+  // sampler3D parameters
+  std::vector<std::pair<std::string, LutView>> luts;
+  // set for kernel effects, code is unused then
+  std::optional<Kernel> kernel;
+  // disabled effects are skipped, toggling one switches cached programs
+  bool enabled = true;
+
+  bool IsPointWise() const noexcept { return !kernel && !sampling; }
+
+  void Set(std::string_view parameter, float32 value);
+  void SetTexture(std::string_view parameter, gl::Texture2DView texture);
+
+  // 1 - e^(-exposure * color), HDR to [0, 1)
+  static Effect ToneMap(float32 exposure = 1.f);
+  static Effect Gamma(float32 gamma = 2.2f);
+  // Color lookup in a size^3 RGB LUT, blended by intensity
+  static Effect ColorGrading(LutView lut, uint32 size, float32 intensity = 1.f);
+  // Darkens from radius to the corners (1 - half diagonal)
+  static Effect Vignette(float32 strength = 0.5f, float32 radius = 0.5f);
+  static Effect Invert();
+  // Adds the result of Bloom::Render, set every frame with SetTexture
+  static Effect BloomComposite(float32 intensity = 0.6f);
+  // FXAA: blends along luma edges found in the 2x2 neighbourhood, span in
+  // texels
+  static Effect Fxaa(float32 span = 8.f);
+  // Catmull-Rom resampling of the pass input, sharper than bilinear. Place
+  // it where the last pass starts: only that one draws at the caller's
+  // viewport, so it upscales a frame rendered at a lower resolution
+  static Effect Upscale();
+  static Effect Convolution(Kernel kernel);
+};
+
+// size^3 RGB8 3D texture, grade(vec3) -> vec3 maps colors in [0, 1]
+template <class F>
+gl::TextureWrapper<> CreateLut(uint32 size, F&& grade) {
+  std::vector<uint8> data;
+  data.reserve(usize(size) * size * size * 3);
+  for (uint32 b = 0; b < size; b++) {
+    for (uint32 g = 0; g < size; g++) {
+      for (uint32 r = 0; r < size; r++) {
+        glm::vec3 color =
+            grade(glm::vec3(r, g, b) / static_cast<float32>(size - 1));
+        color = glm::clamp(color, 0.f, 1.f) * 255.f + 0.5f;
+        data.push_back(static_cast<uint8>(color.r));
+        data.push_back(static_cast<uint8>(color.g));
+        data.push_back(static_cast<uint8>(color.b));
+      }
+    }
+  }
+
+  gl::TextureWrapper<> texture;
+  auto view = texture.As<gl::TextureTarget::TEXTURE_3D>();
+  view.Bind();
+  glthrow(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+  view.Reserve3D(GL_RGB8, size, size, size, GL_RGB, GL_UNSIGNED_BYTE,
+                 data.data());
+  glthrow(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+
+  // trilinear between the LUT entries
+  view.SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  view.SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  view.SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  view.SetParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  view.SetParameter(GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+  view.Unbind();
+  return texture;
+}
+
+}  // namespace over::post
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+#include <over/core/Types.hpp>
+
+namespace over::post {
+
+// Square convolution kernel, row-major weights, odd size up to MAX_SIZE.
+// Rank 1 kernels (kernel = column * row) are detected on construction and
+// keep their factors, filters run them as two 1D passes
+class Kernel {
+ public:
+  static constexpr uint32 MAX_SIZE = 31;
+  // Largest error of column * row, relative to the largest weight
+  static constexpr float32 SEPARABLE_EPSILON = 1e-5f;
+
+  Kernel(uint32 size, std::vector<float32> weights);
+
+  // Normalized average of size x size texels
+  static Kernel Box(uint32 size);
+  // Normalized gaussian, sigma 0 covers the kernel with 3 sigmas each side
+  static Kernel Gaussian(uint32 size, float32 sigma = 0.f);
+  // 3x3 laplacian, the edge detection of the screen shader
+  static Kernel EdgeDetect();
+
+  uint32 GetSize() const noexcept { return _size; }
+  uint32 GetRadius() const noexcept { return _size / 2; }
+  const std::vector<float32>& GetWeights() const noexcept { return _weights; }
+
+  bool IsSeparable() const noexcept { return !_row.empty(); }
+  // Factors of a separable kernel, empty otherwise
+  const std::vector<float32>& GetRow() const noexcept { return _row; }
+  const std::vector<float32>& GetColumn() const noexcept { return _column; }
+
+  bool operator==(const Kernel& other) const noexcept {
+    return _size == other._size && _weights == other._weights;
+  }
+  bool operator!=(const Kernel& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  void Separate();
+
+  uint32 _size;
+  std::vector<float32> _weights;
+  std::vector<float32> _row;
+  std::vector<float32> _column;
+};
+
+}  // namespace over::post
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <over/core/Mesh.hpp>
+#include <over/core/Shader.hpp>
+#include <over/core/Types.hpp>
+#include <over/core/graph/RenderTargetPool.hpp>
+#include <over/core/opengl/views/TextureView.hpp>
+#include <over/core/post/ConvolutionFilter.hpp>
+#include <over/core/post/Effect.hpp>
+
+#include <glm/glm.hpp>
+
+namespace over::post {
+
+// Ordered post-processing effects. Execute fuses every run of consecutive
+// point-wise effects into one generated fragment shader, so the run reads
+// and writes the frame once. A sampling effect starts a run, it has to read
+// the finished output of the previous one. Kernel effects split the runs and
+// go through the convolution filter. Generated programs are cached by the
+// effect indices of their pass, changing parameters never recompiles,
+// enabling or reordering effects compiles a program once per combination
+class PostChain {
+ public:
+  // Texture units of effect textures and LUTs start after the source
+  static constexpr usize SOURCE_UNIT = 0;
+
+  // Kernel effects need a filter, point-wise ones work on GL 3.3
+  explicit PostChain(ConvolutionFilter* filter = nullptr);
+
+  PostChain(const PostChain&) = delete;
+  PostChain& operator=(const PostChain&) = delete;
+
+  PostChain(PostChain&&) noexcept = default;
+  PostChain& operator=(PostChain&&) noexcept = default;
+
+  ~PostChain() = default;
+
+  // Index of the effect, stable until Clear. Code, functions and parameter
+  // names are compiled once per index, only values may change later
+  usize Add(Effect effect);
+  Effect& Get(usize effect) { return _effects.at(effect); }
+  // Also drops the cached programs, indices are reused
+  void Clear() noexcept {
+    _effects.clear();
+    _programs.clear();
+  }
+
+  // Runs the enabled effects on source (its filter is set to linear), the
+  // last pass draws into the bound frame buffer with the bound viewport and
+  // no depth test. Earlier passes use RGBA16F intermediates of size from
+  // the pool, released again before it returns
+  void Execute(graph::RenderTargetPool& pool, gl::Texture2DView source,
+               glm::ivec2 size);
+
+  // Passes of the last Execute, fused runs and kernels
+  usize GetPassCount() const noexcept { return _passes; }
+  usize GetProgramCount() const noexcept { return _programs.size(); }
+
+ private:
+  // Indices of the effects of a pass: one kernel, or fused point-wise ones
+  class Pass {
+   public:
+    std::vector<usize> effects;
+    bool kernel = false;
+  };
+
+  void Plan();
+  // Fragment shader of a fused pass, generated on a cache miss only
+  std::string Generate(const Pass& pass) const;
+  Shader& GetProgram(const Pass& pass);
+  void Draw(const Pass& pass, gl::Texture2DView source, glm::ivec2 size);
+
+  ConvolutionFilter* _filter;
+  std::vector<Effect> _effects;
+  std::vector<Pass> _plan;
+
+  // by Pass::effects
+  std::map<std::vector<usize>, Shader> _programs;
+  Mesh _quad;
+
+  usize _passes;
+};
+
+}  // namespace over::post
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include <over/core/Includes.hpp>
+#include <over/core/Types.hpp>
+
+namespace over::profiling {
+
+// Timed range of a frame, times in nanoseconds since the profiler started
+class Zone {
+ public:
+  // literal or Profiler::Intern, never freed
+  const char* name = nullptr;
+  uint32 thread = 0;
+  // nesting level on its thread (or on the GPU)
+  uint32 depth = 0;
+  int64 start = 0, end = 0;
+
+  float64 GetMilliseconds() const noexcept {
+    return static_cast<float64>(end - start) / 1e6;
+  }
+};
+
+class Frame {
+ public:
+  usize index = 0;
+  int64 start = 0, end = 0;
+  // zones closed during the frame, on any thread
+  std::vector<Zone> cpu;
+  // GPU zones opened during the frame, converted to the CPU clock
+  std::vector<Zone> gpu;
+  // GPU zones arrive Profiler::GPU_LATENCY frames after the frame closed
+  bool gpuReady = false;
+
+  float64 GetMilliseconds() const noexcept {
+    return static_cast<float64>(end - start) / 1e6;
+  }
+};
+
+// Frame profiler. CPU zones are recorded per thread into thread local
+// buffers, so threads only meet at NextFrame when the buffers are
+// collected. GPU zones are pairs of GL_TIMESTAMP queries, read back
+// GPU_LATENCY frames later without stalling, and mapped onto the CPU clock
+// with the offset between the clocks, sampled on the first frame with GPU
+// zones and again every HISTORY frames for drift. The trace keeps the
+// latency and overlap of the GPU behind the CPU.
+// The last HISTORY frames are kept in a ring and export to Chrome trace JSON.
+// Use the OVER_PROFILE_* macros: they compile out without OVER_PROFILER and
+// cost one relaxed load while the profiler is disabled
+class Profiler {
+ public:
+  static constexpr usize HISTORY = 128;
+  static constexpr usize GPU_LATENCY = 3;
+  // Zone::thread of GPU zones
+  static constexpr uint32 GPU_THREAD = ~0u;
+
+  static Profiler& Instance();
+
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+
+  // queries die with the GL context, which is gone by static destruction
+  ~Profiler() = default;
+
+  bool IsEnabled() const noexcept {
+    return _enabled.load(std::memory_order_relaxed);
+  }
+  void SetEnabled(bool enabled) noexcept;
+
+  // Name of the calling thread in traces
+  void SetThreadName(std::string name);
+  // Stable copy of a dynamic name
+  const char* Intern(std::string_view name);
+
+  // Closes the current frame and opens the next. Call between frames on the
+  // thread owning the GL context, which also runs the GPU zones
+  void NextFrame();
+
+  void BeginZone(const char* name);
+  void EndZone();
+  // GL thread only
+  void BeginGpuZone(const char* name);
+  void EndGpuZone();
+
+  // Frames closed so far and kept, age 0 is the last one. Only the thread
+  // calling NextFrame may read them
+  usize GetFrameCount() const noexcept;
+  const Frame& GetFrame(usize age) const;
+  // Newest frame whose GPU zones arrived, or nullptr
+  const Frame* GetLatestComplete() const noexcept;
+
+  // Chrome trace event JSON of the kept frames (chrome://tracing, Perfetto)
+  std::string ExportTrace() const;
+
+  // Nanoseconds since the profiler started
+  int64 Now() const noexcept;
+
+ private:
+  class Thread {
+   public:
+    uint32 id = 0;
+    std::string name;
+    // open zones, touched only by the owning thread
+    std::vector<Zone> open;
+    std::mutex mutex;
+    std::vector<Zone> closed;
+  };
+
+  class GpuQuery {
+   public:
+    const char* name = nullptr;
+    uint32 depth = 0;
+    GLuint begin = 0, end = 0;
+  };
+
+  // GPU zones of a closed frame waiting for their results
+  class InFlight {
+   public:
+    usize frame = 0;
+    // NextFrame call that closed it, counted while disabled too
+    usize tick = 0;
+    // CPU minus GPU clock, nanoseconds
+    int64 offset = 0;
+    std::vector<GpuQuery> queries;
+  };
+
+  Profiler();
+
+  Thread& GetThread();
+  GLuint AcquireQuery();
+  void ReadGpu();
+  // CPU minus GPU clock, resampled every HISTORY ticks
+  int64 GetClockOffset();
+
+  std::atomic<bool> _enabled;
+  int64 _epoch;
+
+  mutable std::mutex _threadsMutex;
+  std::vector<std::unique_ptr<Thread>> _threads;
+
+  std::mutex _namesMutex;
+  std::unordered_set<std::string> _names;
+
+  std::vector<Frame> _frames;
+  usize _frameIndex;
+  int64 _frameStart;
+  // NextFrame calls, enabled or not
+  usize _tick;
+
+  int64 _clockOffset;
+  usize _clockSync;
+
+  std::vector<GpuQuery> _gpuOpen;
+  std::vector<GpuQuery> _gpuClosed;
+  std::deque<InFlight> _inFlight;
+  std::vector<GLuint> _freeQueries;
+  std::vector<GLuint> _queries;
+};
+
+// Zone of the enclosing scope, nothing if the profiler was disabled when it
+// opened or the name is null
+class ScopedZone {
+ public:
+  explicit ScopedZone(const char* name)
+      : _active(name != nullptr && Profiler::Instance().IsEnabled()) {
+    if (_active) {
+      Profiler::Instance().BeginZone(name);
+    }
+  }
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+
+  ~ScopedZone() {
+    if (_active) {
+      Profiler::Instance().EndZone();
+    }
+  }
+
+ private:
+  bool _active;
+};
+
+class ScopedGpuZone {
+ public:
+  explicit ScopedGpuZone(const char* name)
+      : _active(name != nullptr && Profiler::Instance().IsEnabled()) {
+    if (_active) {
+      Profiler::Instance().BeginGpuZone(name);
+    }
+  }
+
+  ScopedGpuZone(const ScopedGpuZone&) = delete;
+  ScopedGpuZone& operator=(const ScopedGpuZone&) = delete;
+
+  ~ScopedGpuZone() {
+    if (_active) {
+      Profiler::Instance().EndGpuZone();
+    }
+  }
+
+ private:
+  bool _active;
+};
+
+// Name interned only while the profiler records
+inline const char* InternIfEnabled(std::string_view name) {
+  auto& profiler = Profiler::Instance();
+  return profiler.IsEnabled() ? profiler.Intern(name) : nullptr;
+}
+
+}  // namespace over::profiling
+
+#define OVER_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OVER_PROFILE_CONCAT(a, b) OVER_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef OVER_PROFILER
+// name: string literal
+#define OVER_PROFILE_ZONE(name) \
+  ::over::profiling::ScopedZone OVER_PROFILE_CONCAT(overZone, __LINE__)(name)
+#define OVER_PROFILE_GPU_ZONE(name)                                      \
+  ::over::profiling::ScopedGpuZone OVER_PROFILE_CONCAT(overGpuZone, \
+                                                       __LINE__)(name)
+// name: any string, copied once
+#define OVER_PROFILE_DYNAMIC_ZONE(name) \
+  OVER_PROFILE_ZONE(::over::profiling::InternIfEnabled(name))
+#define OVER_PROFILE_DYNAMIC_GPU_ZONE(name) \
+  OVER_PROFILE_GPU_ZONE(::over::profiling::InternIfEnabled(name))
+#define OVER_PROFILE_FRAME() ::over::profiling::Profiler::Instance().NextFrame()
+#define OVER_PROFILE_THREAD(name) \
+  ::over::profiling::Profiler::Instance().SetThreadName(name)
+#else
+#define OVER_PROFILE_ZONE(name) ((void)0)
+#define OVER_PROFILE_GPU_ZONE(name) ((void)0)
+#define OVER_PROFILE_DYNAMIC_ZONE(name) ((void)0)
+#define OVER_PROFILE_DYNAMIC_GPU_ZONE(name) ((void)0)
+#define OVER_PROFILE_FRAME() ((void)0)
+#define OVER_PROFILE_THREAD(name) ((void)0)
+#endif
@@ -2,15 +2,20 @@
 
 #include <over/core/Includes.hpp>
 #include <over/core/Types.hpp>
+#include <over/core/window/RunOptions.hpp>
 #include <over/core/window/Window.hpp>
 
 #include <glm/glm.hpp>
 
 namespace over {
 // Context manages OpenGL settings (Version, Depth/Stencil Test, Face Culling e.t.c)
+// Headless backends need GLFW 3.4: its null platform creates windows without
+// a display server, they only hold the context and the size of an offscreen
+// frame buffer that replaces the default one
 class Context {
  public:
-  Context(int32 major = 3, int32 minor = 3);
+  Context(int32 major = 3, int32 minor = 3,
+          Backend backend = RunOptions::Get().backend);
 
   Context(const Context&) = delete;
 
@@ -18,6 +23,9 @@ class Context {
 
   void LoadOpenGL(Window& window);
 
+  Backend GetBackend() const noexcept { return _backend; }
+  bool IsHeadless() const noexcept { return _backend != Backend::WINDOW; }
+
   void Viewport(uint32 x, uint32 y, uint32 width, uint32 height);
 
   void SetClearColor(glm::vec4 color);
@@ -25,8 +33,16 @@ class Context {
   void SetDepthTest(bool value);
   void SetStencilTest(bool value);
 
+  // Depth/color writes and depth comparison, e.g. for depth pre-pass
+  void SetDepthWrite(bool value);
+  void SetDepthFunc(GLenum func);
+  void SetColorWrite(bool value);
+
   void ClearAll();
 
   void ThrowErrors();
+
+ private:
+  Backend _backend;
 };
 }  // namespace over
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <over/core/Types.hpp>
+#include <over/core/opengl/wrappers/FrameBufferWrapper.hpp>
+#include <over/core/opengl/wrappers/RenderBufferWrapper.hpp>
+
+namespace over {
+
+// Default frame buffer of a headless context: RGBA8 color and
+// depth/stencil render buffers the size of the window. While it lives it is
+// gl::GetDefaultFrameBuffer, so unbinding frame buffers lands on it
+class OffscreenTarget {
+ public:
+  OffscreenTarget(uint32 width, uint32 height);
+
+  OffscreenTarget(const OffscreenTarget&) = delete;
+  OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+  ~OffscreenTarget();
+
+  // (Re)allocates the render buffers, nothing happens if the size did not
+  // change
+  void Resize(uint32 width, uint32 height);
+
+  GLuint GetId() const noexcept { return *_frame.Get(); }
+
+ private:
+  uint32 _width, _height;
+
+  gl::RenderBufferWrapper<> _color;
+  gl::RenderBufferWrapper<> _depth;
+  gl::FrameBufferWrapper<> _frame;
+};
+
+}  // namespace over
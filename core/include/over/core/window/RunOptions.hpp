@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+
+#include <over/core/Types.hpp>
+
+namespace over {
+
+// Where the GL context comes from
+enum class Backend : int32 {
+  // visible GLFW window
+  WINDOW = 0,
+  // EGL without a display (surfaceless Mesa, llvmpipe works)
+  EGL,
+  // OSMesa, software only
+  OSMESA
+};
+
+// How an example runs, read from the environment so every example takes the
+// same switches without parsing arguments:
+//   OVER_BACKEND  window (default), egl or osmesa
+//   OVER_FRAMES   frames to render before exiting, 0 (default) runs until
+//                 the window closes
+//   OVER_CAPTURE  PNG the last of OVER_FRAMES frames is written to
+//   OVER_FIXED_DELTA  seconds every frame advances by, 0 (default) uses the
+//                     measured frame time
+class RunOptions {
+ public:
+  Backend backend = Backend::WINDOW;
+  usize frames = 0;
+  std::string capture;
+  float32 fixedDelta = 0.f;
+
+  // Parsed on first use, throws on values it does not know
+  static const RunOptions& Get();
+  // Overrides the environment, call before the context is created
+  static void Set(RunOptions options);
+  static RunOptions FromEnvironment();
+
+  bool IsHeadless() const noexcept { return backend != Backend::WINDOW; }
+
+  // Whether `frame` frames are enough to exit
+  bool IsDone(usize frame) const noexcept {
+    return frames != 0 && frame >= frames;
+  }
+  // Whether frame number `frame` (from 0) is the one to capture
+  bool IsCaptured(usize frame) const noexcept {
+    return !capture.empty() && frames != 0 && frame + 1 == frames;
+  }
+};
+
+}  // namespace over
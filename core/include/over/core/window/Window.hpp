@@ -3,10 +3,15 @@
 #include <over/core/Includes.hpp>
 #include <over/core/Types.hpp>
 
+#include <memory>
 #include <string>
 
+#include <over/core/host/images/Image2D.hpp>
+
 namespace over {
 
+class OffscreenTarget;
+
 class Window {
  public:
   Window(uint32 width, uint32 height, const char* title,
@@ -40,12 +45,23 @@ class Window {
   void SetShouldClose(bool value) const noexcept;
 
   void SetSwapInterval(int32 swapInterval);
+  // Nothing to present offscreen, the commands are only flushed
   void SwapBuffers() const noexcept;
 
+  // Renders into an offscreen frame buffer from now on, the context must be
+  // current. Context::LoadOpenGL calls it for headless backends
+  void CreateOffscreen();
+  bool IsOffscreen() const noexcept { return _offscreen != nullptr; }
+
+  // RGBA8 copy of the back buffer (or the offscreen one), rows top to
+  // bottom. Read before SwapBuffers, the back buffer is undefined after it
+  host::Image2D ReadPixels() const;
+
   GLFWwindow* Get() { return _ptr; }
 
  private:
   int32 _swapInterval;
   GLFWwindow* _ptr;
+  std::unique_ptr<OffscreenTarget> _offscreen;
 };
 }  // namespace over
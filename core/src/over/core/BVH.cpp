@@ -0,0 +1,445 @@
+#include <over/core/BVH.hpp>
+
+#include <algorithm>
+#include <array>
+#include <future>
+#include <numeric>
+
+namespace over {
+
+BVH::BVH()
+    : _bounds(),
+      _centroids(),
+      _nodes(),
+      _indices(),
+      _parents(),
+      _leaves(),
+      _moved(),
+      _movedFlags(),
+      _rebuildInterval(60),
+      _updates(0),
+      _changed(false) {}
+
+void BVH::Build(std::vector<AABB> bounds) {
+  _bounds = std::move(bounds);
+  Build();
+}
+
+void BVH::Build() {
+  usize size = _bounds.size();
+
+  _nodes.clear();
+  _updates = 0;
+  _changed = false;
+
+  if (size == 0) {
+    _indices.clear();
+    Finalize();
+    return;
+  }
+
+  _centroids.resize(size);
+  for (usize i = 0; i < size; i++) {
+    _centroids[i] = _bounds[i].IsEmpty() ? glm::vec3(0)
+                                         : _bounds[i].GetCenter();
+  }
+
+  _indices.resize(size);
+  std::iota(_indices.begin(), _indices.end(), 0);
+
+  // upper bound, children pairs are taken from the atomic counter
+  _nodes.resize(2 * size - 1);
+  std::atomic<uint32> used = 1;
+
+  _nodes[0].leftOrFirst = 0;
+  _nodes[0].count = static_cast<uint32>(size);
+  FitNode(0);
+
+  Subdivide(0, 0, used);
+
+  _nodes.resize(used.load());
+  Finalize();
+}
+
+void BVH::FitNode(uint32 index) noexcept {
+  auto& node = _nodes[index];
+
+  AABB box;
+  if (node.IsLeaf()) {
+    for (uint32 i = 0; i < node.count; i++) {
+      box.Expand(_bounds[_indices[node.leftOrFirst + i]]);
+    }
+  } else {
+    box.Expand(_nodes[node.leftOrFirst].GetBounds());
+    box.Expand(_nodes[node.leftOrFirst + 1].GetBounds());
+  }
+
+  node.min = box.min;
+  node.max = box.max;
+}
+
+void BVH::Subdivide(uint32 index, uint32 depth, std::atomic<uint32>& used) {
+  // nodes are preallocated, references stay valid between threads
+  auto& node = _nodes[index];
+  uint32 first = node.leftOrFirst;
+  uint32 count = node.count;
+
+  // leaves end at MAX_DEPTH - 2, traversal stacks never overflow
+  if (count <= 2 || depth + 2 >= MAX_DEPTH) {
+    return;
+  }
+
+  AABB centroids;
+  for (uint32 i = 0; i < count; i++) {
+    centroids.Expand(_centroids[_indices[first + i]]);
+  }
+
+  // binned SAH: cost of split after bin, for every axis
+  int32 bestAxis = -1;
+  usize bestSplit = 0;
+  float32 bestCost = std::numeric_limits<float32>::max();
+
+  for (int32 axis = 0; axis < 3; axis++) {
+    float32 low = centroids.min[axis];
+    float32 extent = centroids.max[axis] - low;
+    if (extent <= 0.f) {
+      continue;
+    }
+
+    std::array<AABB, BINS> boxes;
+    std::array<uint32, BINS> counts{};
+    float32 scale = BINS / extent;
+
+    for (uint32 i = 0; i < count; i++) {
+      uint32 primitive = _indices[first + i];
+      auto bin = std::min(
+          BINS - 1,
+          static_cast<usize>((_centroids[primitive][axis] - low) * scale));
+      counts[bin]++;
+      boxes[bin].Expand(_bounds[primitive]);
+    }
+
+    std::array<float32, BINS - 1> leftCost;
+    AABB left;
+    uint32 leftCount = 0;
+    for (usize i = 0; i < BINS - 1; i++) {
+      left.Expand(boxes[i]);
+      leftCount += counts[i];
+      leftCost[i] = left.GetSurfaceArea() * leftCount;
+    }
+
+    AABB right;
+    uint32 rightCount = 0;
+    for (usize i = BINS - 1; i > 0; i--) {
+      right.Expand(boxes[i]);
+      rightCount += counts[i];
+      float32 cost = leftCost[i - 1] + right.GetSurfaceArea() * rightCount;
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestSplit = i - 1;
+      }
+    }
+  }
+
+  uint32 middle = first;
+  if (bestAxis >= 0) {
+    float32 area = node.GetBounds().GetSurfaceArea();
+    float32 splitCost = 1.f + (area > 0.f ? bestCost / area : 0.f);
+    if (splitCost >= count && count <= MAX_LEAF_SIZE) {
+      return;
+    }
+
+    float32 low = centroids.min[bestAxis];
+    float32 scale = BINS / (centroids.max[bestAxis] - low);
+    auto* begin = _indices.data() + first;
+    auto* split = std::partition(begin, begin + count, [&](uint32 primitive) {
+      auto bin = std::min(
+          BINS - 1,
+          static_cast<usize>((_centroids[primitive][bestAxis] - low) * scale));
+      return bin <= bestSplit;
+    });
+    middle = first + static_cast<uint32>(split - begin);
+  }
+
+  if (middle == first || middle == first + count) {
+    // all centroids in one point: halve only to keep leaves small
+    if (count <= MAX_LEAF_SIZE) {
+      return;
+    }
+    middle = first + count / 2;
+  }
+
+  uint32 left = used.fetch_add(2);
+  _nodes[left].leftOrFirst = first;
+  _nodes[left].count = middle - first;
+  _nodes[left + 1].leftOrFirst = middle;
+  _nodes[left + 1].count = first + count - middle;
+
+  node.leftOrFirst = left;
+  node.count = 0;
+
+  FitNode(left);
+  FitNode(left + 1);
+
+  if (count >= PARALLEL_THRESHOLD) {
+    auto task = std::async(std::launch::async, [this, left, depth, &used] {
+      Subdivide(left, depth + 1, used);
+    });
+    Subdivide(left + 1, depth + 1, used);
+    task.get();
+  } else {
+    Subdivide(left, depth + 1, used);
+    Subdivide(left + 1, depth + 1, used);
+  }
+}
+
+void BVH::Finalize() {
+  _parents.assign(_nodes.size(), NONE);
+  _leaves.assign(_bounds.size(), NONE);
+  _movedFlags.assign(_nodes.size(), 0);
+  _moved.clear();
+
+  for (uint32 i = 0; i < _nodes.size(); i++) {
+    const auto& node = _nodes[i];
+    if (node.IsLeaf()) {
+      for (uint32 j = 0; j < node.count; j++) {
+        _leaves[_indices[node.leftOrFirst + j]] = i;
+      }
+    } else {
+      _parents[node.leftOrFirst] = i;
+      _parents[node.leftOrFirst + 1] = i;
+    }
+  }
+}
+
+void BVH::SetBounds(uint32 primitive, const AABB& box) {
+  _bounds[primitive] = box;
+  _changed = true;
+
+  uint32 leaf = _leaves[primitive];
+  if (leaf != NONE && _movedFlags[leaf] == 0) {
+    _movedFlags[leaf] = 1;
+    _moved.push_back(leaf);
+  }
+}
+
+void BVH::Refit() {
+  for (uint32 leaf : _moved) {
+    _movedFlags[leaf] = 0;
+    FitNode(leaf);
+
+    for (uint32 node = _parents[leaf]; node != NONE; node = _parents[node]) {
+      glm::vec3 min = _nodes[node].min;
+      glm::vec3 max = _nodes[node].max;
+      FitNode(node);
+      if (_nodes[node].min == min && _nodes[node].max == max) {
+        break;
+      }
+    }
+  }
+  _moved.clear();
+}
+
+void BVH::Update() {
+  Refit();
+
+  _updates++;
+  if (_changed && _updates >= _rebuildInterval) {
+    Build();
+  }
+}
+
+float32 BVH::GetCost() const noexcept {
+  if (_nodes.empty()) {
+    return 0.f;
+  }
+
+  float32 cost = 0.f;
+  for (const auto& node : _nodes) {
+    float32 area = node.GetBounds().GetSurfaceArea();
+    cost += node.IsLeaf() ? area * node.count : area;
+  }
+
+  float32 root = _nodes[0].GetBounds().GetSurfaceArea();
+  return root > 0.f ? cost / root : cost;
+}
+
+usize BVH::Query(const Frustum& frustum, std::vector<uint32>& result) const {
+  usize before = result.size();
+  if (_nodes.empty()) {
+    return 0;
+  }
+
+  const auto& planes = frustum.GetPlanes();
+  constexpr uint32 ALL_PLANES = (1u << Frustum::COUNT) - 1;
+
+  // mask holds planes the node still straddles
+  std::pair<uint32, uint32> stack[MAX_DEPTH];
+  uint32 size = 0;
+  stack[size++] = {0, ALL_PLANES};
+
+  while (size > 0) {
+    auto [index, mask] = stack[--size];
+    const auto& node = _nodes[index];
+
+    glm::vec3 center = (node.min + node.max) * 0.5f;
+    glm::vec3 extents = (node.max - node.min) * 0.5f;
+
+    bool outside = false;
+    for (uint32 i = 0; i < Frustum::COUNT && !outside; i++) {
+      if ((mask & (1u << i)) == 0) {
+        continue;
+      }
+
+      glm::vec3 normal(planes[i]);
+      float32 distance = glm::dot(normal, center) + planes[i].w;
+      float32 radius = glm::dot(glm::abs(normal), extents);
+      if (distance + radius < 0.f) {
+        outside = true;
+      } else if (distance - radius >= 0.f) {
+        mask &= ~(1u << i);
+      }
+    }
+
+    if (outside) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      for (uint32 i = 0; i < node.count; i++) {
+        uint32 primitive = _indices[node.leftOrFirst + i];
+        if (mask == 0 || frustum.Intersects(_bounds[primitive])) {
+          result.push_back(primitive);
+        }
+      }
+    } else {
+      stack[size++] = {node.leftOrFirst, mask};
+      stack[size++] = {node.leftOrFirst + 1, mask};
+    }
+  }
+
+  return result.size() - before;
+}
+
+usize BVH::Query(const Sphere& sphere, std::vector<uint32>& result) const {
+  usize before = result.size();
+  if (_nodes.empty()) {
+    return 0;
+  }
+
+  uint32 stack[MAX_DEPTH];
+  uint32 size = 0;
+  stack[size++] = 0;
+
+  while (size > 0) {
+    const auto& node = _nodes[stack[--size]];
+    if (!node.GetBounds().Intersects(sphere)) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      for (uint32 i = 0; i < node.count; i++) {
+        uint32 primitive = _indices[node.leftOrFirst + i];
+        if (_bounds[primitive].Intersects(sphere)) {
+          result.push_back(primitive);
+        }
+      }
+    } else {
+      stack[size++] = node.leftOrFirst;
+      stack[size++] = node.leftOrFirst + 1;
+    }
+  }
+
+  return result.size() - before;
+}
+
+usize BVH::Query(const AABB& box, std::vector<uint32>& result) const {
+  usize before = result.size();
+  if (_nodes.empty() || box.IsEmpty()) {
+    return 0;
+  }
+
+  uint32 stack[MAX_DEPTH];
+  uint32 size = 0;
+  stack[size++] = 0;
+
+  while (size > 0) {
+    const auto& node = _nodes[stack[--size]];
+    if (!node.GetBounds().Intersects(box)) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      for (uint32 i = 0; i < node.count; i++) {
+        uint32 primitive = _indices[node.leftOrFirst + i];
+        if (_bounds[primitive].Intersects(box)) {
+          result.push_back(primitive);
+        }
+      }
+    } else {
+      stack[size++] = node.leftOrFirst;
+      stack[size++] = node.leftOrFirst + 1;
+    }
+  }
+
+  return result.size() - before;
+}
+
+BVH::Hit BVH::Nearest(glm::vec3 point, float32 maxDistance) const noexcept {
+  Hit hit;
+  hit.distance = maxDistance;
+  if (_nodes.empty()) {
+    return hit;
+  }
+
+  uint32 stack[MAX_DEPTH];
+  uint32 size = 0;
+  stack[size++] = 0;
+
+  while (size > 0) {
+    const auto& node = _nodes[stack[--size]];
+    if (node.GetBounds().GetDistance(point) > hit.distance) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      for (uint32 i = 0; i < node.count; i++) {
+        uint32 primitive = _indices[node.leftOrFirst + i];
+        float32 distance = _bounds[primitive].GetDistance(point);
+        if (distance < hit.distance ||
+            (hit.primitive == NONE && distance <= hit.distance)) {
+          hit.primitive = primitive;
+          hit.distance = distance;
+        }
+      }
+      continue;
+    }
+
+    // near child on top of the stack
+    uint32 left = node.leftOrFirst;
+    uint32 right = left + 1;
+    if (_nodes[left].GetBounds().GetDistance(point) >
+        _nodes[right].GetBounds().GetDistance(point)) {
+      std::swap(left, right);
+    }
+    stack[size++] = right;
+    stack[size++] = left;
+  }
+
+  return hit;
+}
+
+BVH::Hit BVH::Raycast(const Ray& ray, float32 maxDistance) const noexcept {
+  return Raycast(ray, maxDistance, [&](uint32 primitive, float32& distance) {
+    float32 entry;
+    if (_bounds[primitive].Intersects(ray, distance, entry) &&
+        entry < distance) {
+      distance = entry;
+      return true;
+    }
+    return false;
+  });
+}
+
+}  // namespace over
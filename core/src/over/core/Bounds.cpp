@@ -0,0 +1,142 @@
+#include <over/core/Bounds.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <over/core/opengl/VBO.hpp>
+
+namespace over {
+
+AABB::AABB()
+    : min(std::numeric_limits<float32>::max()),
+      max(std::numeric_limits<float32>::lowest()) {}
+
+AABB::AABB(glm::vec3 min, glm::vec3 max) : min(min), max(max) {}
+
+AABB AABB::FromVertices(const std::vector<Vertex>& vertices) {
+  AABB result;
+  for (const auto& vertex : vertices) {
+    result.Expand(vertex.position);
+  }
+  return result;
+}
+
+bool AABB::IsEmpty() const noexcept {
+  return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+void AABB::Expand(glm::vec3 point) noexcept {
+  min = glm::min(min, point);
+  max = glm::max(max, point);
+}
+
+void AABB::Expand(const AABB& other) noexcept {
+  if (other.IsEmpty()) {
+    return;
+  }
+
+  min = glm::min(min, other.min);
+  max = glm::max(max, other.max);
+}
+
+AABB AABB::Transformed(const glm::mat4& matrix) const noexcept {
+  if (IsEmpty()) {
+    return *this;
+  }
+
+  glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.f));
+  glm::vec3 extents = GetExtents();
+
+  glm::vec3 newExtents(0);
+  for (int32 i = 0; i < 3; i++) {
+    for (int32 j = 0; j < 3; j++) {
+      newExtents[i] += std::abs(matrix[j][i]) * extents[j];
+    }
+  }
+
+  return AABB(center - newExtents, center + newExtents);
+}
+
+float32 AABB::GetSurfaceArea() const noexcept {
+  if (IsEmpty()) {
+    return 0.f;
+  }
+
+  glm::vec3 size = max - min;
+  return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+float32 AABB::GetDistance(glm::vec3 point) const noexcept {
+  glm::vec3 outside = glm::max(glm::max(min - point, point - max), 0.f);
+  return glm::length(outside);
+}
+
+bool AABB::Intersects(const AABB& other) const noexcept {
+  return min.x <= other.max.x && max.x >= other.min.x &&
+         min.y <= other.max.y && max.y >= other.min.y &&
+         min.z <= other.max.z && max.z >= other.min.z;
+}
+
+bool AABB::Intersects(const Sphere& sphere) const noexcept {
+  return !IsEmpty() && GetDistance(sphere.center) <= sphere.radius;
+}
+
+bool AABB::Intersects(const Ray& ray, float32 maxDistance,
+                      float32& distance) const noexcept {
+  glm::vec3 t0 = (min - ray.origin) * ray.inverseDirection;
+  glm::vec3 t1 = (max - ray.origin) * ray.inverseDirection;
+
+  glm::vec3 tNear = glm::min(t0, t1);
+  glm::vec3 tFar = glm::max(t0, t1);
+
+  float32 enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.f));
+  float32 exit =
+      std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+
+  distance = enter;
+  return enter <= exit;
+}
+
+Sphere::Sphere() : center(0), radius(0) {}
+
+Sphere::Sphere(glm::vec3 center, float32 radius)
+    : center(center), radius(radius) {}
+
+Sphere Sphere::FromVertices(const std::vector<Vertex>& vertices,
+                            const AABB& bounds) {
+  if (bounds.IsEmpty()) {
+    return Sphere();
+  }
+
+  glm::vec3 center = bounds.GetCenter();
+  float32 radius2 = 0.f;
+  for (const auto& vertex : vertices) {
+    glm::vec3 d = vertex.position - center;
+    radius2 = std::max(radius2, glm::dot(d, d));
+  }
+
+  return Sphere(center, std::sqrt(radius2));
+}
+
+Sphere Sphere::Transformed(const glm::mat4& matrix) const noexcept {
+  glm::vec3 newCenter = glm::vec3(matrix * glm::vec4(center, 1.f));
+
+  float32 scale = std::max({glm::length(glm::vec3(matrix[0])),
+                            glm::length(glm::vec3(matrix[1])),
+                            glm::length(glm::vec3(matrix[2]))});
+
+  return Sphere(newCenter, radius * scale);
+}
+
+Ray::Ray() : Ray(glm::vec3(0), glm::vec3(0, 0, -1)) {}
+
+Ray::Ray(glm::vec3 origin, glm::vec3 direction)
+    : origin(origin), direction(direction), inverseDirection(1.f / direction) {}
+
+Ray Ray::Transformed(const glm::mat4& matrix) const noexcept {
+  return Ray(glm::vec3(matrix * glm::vec4(origin, 1.f)),
+             glm::vec3(matrix * glm::vec4(direction, 0.f)));
+}
+
+}  // namespace over
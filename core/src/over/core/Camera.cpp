@@ -21,7 +21,9 @@ Camera::Camera(glm::vec3 position, glm::vec3 rotation, float32 speed,
       _aspectRatio(aspectRatio),
       _near(near),
       _far(far),
-      _sensitivity(sensitivity) {}
+      _sensitivity(sensitivity),
+      _snapshot(),
+      _snapshotValid(false) {}
 
 void Camera::UpdatePositionCallback(GLFWwindow* window, float deltaTime) {
   auto direction = GetDirection();
@@ -82,7 +84,7 @@ void Camera::UpdateFOVCallback(float yoffset) {
   _fov = std::min(45.0f, std::max(_fov, 1.0f));
 }
 
-glm::vec3 Camera::GetDirection() const noexcept {
+glm::vec3 Camera::ComputeDirection() const noexcept {
   glm::vec3 dir = glm::vec3(0, 0, -1);
 
   glm::vec3 right = glm::cross(dir, up);
@@ -98,12 +100,58 @@ glm::vec3 Camera::GetDirection() const noexcept {
   return res;
 }
 
-glm::mat4 Camera::GetView() const noexcept {
-  return glm::lookAt(_position, _position + GetDirection(), up);
+const CameraSnapshot& Camera::GetSnapshot() const noexcept {
+  auto& snapshot = _snapshot;
+
+  bool viewChanged = !_snapshotValid || snapshot.position != _position ||
+                     snapshot.rotation != _rotation || snapshot.worldUp != up;
+  bool projectionChanged = !_snapshotValid || snapshot.fov != _fov ||
+                           snapshot.aspectRatio != _aspectRatio ||
+                           snapshot.zNear != _near || snapshot.zFar != _far;
+
+  if (!viewChanged && !projectionChanged) {
+    return snapshot;
+  }
+
+  if (viewChanged) {
+    snapshot.position = _position;
+    snapshot.rotation = _rotation;
+    snapshot.worldUp = up;
+
+    snapshot.direction = ComputeDirection();
+    snapshot.right = glm::normalize(glm::cross(snapshot.direction, up));
+    snapshot.up = glm::cross(snapshot.right, snapshot.direction);
+
+    snapshot.view = glm::lookAt(_position, _position + snapshot.direction, up);
+    snapshot.inverseView = glm::inverse(snapshot.view);
+  }
+
+  if (projectionChanged) {
+    snapshot.fov = _fov;
+    snapshot.aspectRatio = _aspectRatio;
+    snapshot.zNear = _near;
+    snapshot.zFar = _far;
+
+    snapshot.projection = glm::infinitePerspective(_fov, _aspectRatio, _near);
+    snapshot.inverseProjection = glm::inverse(snapshot.projection);
+  }
+
+  snapshot.viewProjection = snapshot.projection * snapshot.view;
+  snapshot.inverseViewProjection =
+      snapshot.inverseView * snapshot.inverseProjection;
+  snapshot.frustum = Frustum::FromMatrix(snapshot.viewProjection);
+
+  _snapshotValid = true;
+  return snapshot;
 }
 
-glm::mat4 Camera::GetProjection() const noexcept {
-  return glm::infinitePerspective(_fov, _aspectRatio, _near);
+Ray Camera::GetRay(glm::vec2 ndc) const noexcept {
+  const auto& snapshot = GetSnapshot();
+
+  // far plane is at infinity, unproject a point on the near plane
+  glm::vec4 point = snapshot.inverseViewProjection * glm::vec4(ndc, -1.f, 1.f);
+  glm::vec3 direction = glm::vec3(point) / point.w - snapshot.position;
+  return Ray(snapshot.position, glm::normalize(direction));
 }
 
 }  // namespace over
@@ -0,0 +1,64 @@
+#include <over/core/Frustum.hpp>
+
+#include <cmath>
+
+namespace over {
+
+Frustum::Frustum() {
+  _planes.fill(glm::vec4(0, 0, 0, 1));
+}
+
+static glm::vec4 NormalizePlane(glm::vec4 plane) {
+  float32 length = glm::length(glm::vec3(plane));
+  if (length < 1e-6f) {
+    return glm::vec4(0, 0, 0, 1);
+  }
+  return plane / length;
+}
+
+Frustum Frustum::FromMatrix(const glm::mat4& m) {
+  // glm is column major: m[column][row]
+  glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+  glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+  glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+  glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+  Frustum result;
+  result._planes[LEFT] = NormalizePlane(row3 + row0);
+  result._planes[RIGHT] = NormalizePlane(row3 - row0);
+  result._planes[BOTTOM] = NormalizePlane(row3 + row1);
+  result._planes[TOP] = NormalizePlane(row3 - row1);
+  result._planes[Z_NEAR] = NormalizePlane(row3 + row2);
+  result._planes[Z_FAR] = NormalizePlane(row3 - row2);
+  return result;
+}
+
+bool Frustum::Intersects(const AABB& box) const noexcept {
+  if (box.IsEmpty()) {
+    return false;
+  }
+
+  glm::vec3 center = box.GetCenter();
+  glm::vec3 extents = box.GetExtents();
+
+  for (const auto& plane : _planes) {
+    glm::vec3 normal(plane);
+    float32 distance = glm::dot(normal, center) + plane.w;
+    float32 radius = glm::dot(glm::abs(normal), extents);
+    if (distance + radius < 0.f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Frustum::Intersects(const Sphere& sphere) const noexcept {
+  for (const auto& plane : _planes) {
+    if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace over
@@ -0,0 +1,50 @@
+#include <over/core/InstanceBatch.hpp>
+
+namespace over {
+
+InstanceBatch::InstanceBatch(Model& model)
+    : _model(&model), _instances(), _dirty(false) {}
+
+void InstanceBatch::Reserve(usize count) {
+  _instances.GetInstances().reserve(count);
+}
+
+void InstanceBatch::Add(const Transform& transform, glm::vec4 color,
+                        uint32 material) {
+  Add(transform.GetModel(), color, material);
+}
+
+void InstanceBatch::Add(const glm::mat4& model, glm::vec4 color,
+                        uint32 material) {
+  _instances.GetInstances().emplace_back(model, color, material);
+  _dirty = true;
+}
+
+void InstanceBatch::Clear() noexcept {
+  _instances.GetInstances().clear();
+  _dirty = true;
+}
+
+void InstanceBatch::Draw(Shader& shader) {
+  if (_instances.Size() == 0) {
+    return;
+  }
+
+  if (_dirty) {
+    _instances.ToGPU(true);
+    _dirty = false;
+  }
+
+  auto& meshes = _model->GetMeshes();
+  for (usize i = 0; i < meshes.size(); i++) {
+    shader.SetMatrix4f(_model->GetModelUniform(), _model->GetMeshTransform(i));
+    meshes[i].DrawInstanced(shader, _instances);
+  }
+}
+
+void InstanceBatch::Draw() {
+  Shader shader = Shader::GetCurrent();
+  Draw(shader);
+}
+
+}  // namespace over
@@ -6,6 +6,7 @@
 #include <utility>
 
 #include <over/core/Shader.hpp>
+#include <over/core/opengl/RenderStats.hpp>
 
 #include <fmt/core.h>
 
@@ -42,6 +43,8 @@ Mesh::Mesh(VBO vbo, IBO ibo, std::vector<MeshTexture> textures)
 }
 
 void Mesh::Setup() {
+  UpdateBounds();
+
   _vao.Use([&] {
     _vbo.ToGPU();
     _ibo.ToGPU();
@@ -57,6 +60,28 @@ void Mesh::Setup() {
   _ibo.Unbind();
 }
 
+void Mesh::UpdateBounds() {
+  _bounds = AABB::FromVertices(_vbo.GetVerticies());
+  _sphere = Sphere::FromVertices(_vbo.GetVerticies(), _bounds);
+  _bvh.reset();
+  _positionsReady = false;
+}
+
+const MeshBVH& Mesh::GetBVH() {
+  if (!_bvh) {
+    _bvh = std::make_unique<MeshBVH>(_vbo.GetVerticies(), _ibo.GetElements());
+  }
+  return *_bvh;
+}
+
+TriangleHit Mesh::Raycast(const Ray& ray, float32 maxDistance) {
+  float32 entry;
+  if (!_bounds.Intersects(ray, maxDistance, entry)) {
+    return TriangleHit();
+  }
+  return GetBVH().Raycast(ray, maxDistance);
+}
+
 static void BindTextures(std::vector<MeshTexture>& textures, Shader& shader,
                          bool flush = false) {
   uint32 diffuseCounter = 0;
@@ -99,6 +124,7 @@ void Mesh::Draw(Shader& shader, int32 count) {
     glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(_ibo.Size()),
                             GL_UNSIGNED_INT, nullptr, count);
   });
+  CountDraw(count);
 
   BindTextures(_textures, shader, true);
 }
@@ -108,6 +134,98 @@ void Mesh::Draw(int32 count) {
   Draw(shader, count);
 }
 
+void Mesh::AttachInstances(const InstanceBuffer& instances) {
+  if (_instanceBuffer == instances.Get() && _instanceBuffer != 0) {
+    return;
+  }
+
+  _vao.Use([&] {
+    instances.Bind();
+    _vao.AttachInstancedMatrix(INSTANCE_MODEL_LOCATION, sizeof(Instance),
+                               offsetof(Instance, Instance::model));
+    _vao.AttachInstancedAttribute(INSTANCE_COLOR_LOCATION, 4, GL_FLOAT,
+                                  sizeof(Instance),
+                                  offsetof(Instance, Instance::color));
+    _vao.AttachInstancedIntegerAttribute(
+        INSTANCE_MATERIAL_LOCATION, 1, GL_UNSIGNED_INT, sizeof(Instance),
+        offsetof(Instance, Instance::material));
+  });
+
+  instances.Unbind();
+  _instanceBuffer = instances.Get();
+}
+
+void Mesh::DrawInstanced(Shader& shader, const InstanceBuffer& instances) {
+  if (instances.Size() == 0) {
+    return;
+  }
+
+  AttachInstances(instances);
+  Draw(shader, static_cast<int32>(instances.Size()));
+}
+
+void Mesh::DrawIndirect(Shader& shader, const InstanceBuffer& instances,
+                        usize offset) {
+  AttachInstances(instances);
+  BindTextures(_textures, shader);
+
+  _vao.Use([&]() {
+    glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                           reinterpret_cast<const void*>(offset));
+  });
+  OVER_RENDER_STAT(drawCalls, 1);
+
+  BindTextures(_textures, shader, true);
+}
+
+void Mesh::SetupPositions() {
+  const auto& vertices = _vbo.GetVerticies();
+  std::vector<glm::vec3> positions;
+  positions.reserve(vertices.size());
+  for (const auto& vertex : vertices) {
+    positions.push_back(vertex.position);
+  }
+
+  _positionVao.Use([&] {
+    auto view = _positions.As<gl::BufferTarget::ARRAY_BUFFER>();
+    view.Bind();
+    view.Reserve(sizeof(glm::vec3) * positions.size(), positions.data(),
+                 GL_STATIC_DRAW);
+    _positionVao.AttachAttribute(0, 3, GL_FLOAT, sizeof(glm::vec3), 0);
+    // element buffer binding is part of the layout
+    _ibo.Bind();
+  });
+
+  _positions.As<gl::BufferTarget::ARRAY_BUFFER>().Unbind();
+  _ibo.Unbind();
+  _positionsReady = true;
+}
+
+void Mesh::DrawDepth(int32 count) {
+  if (!_positionsReady) {
+    SetupPositions();
+  }
+
+  _positionVao.Use([&]() {
+    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(_ibo.Size()),
+                            GL_UNSIGNED_INT, nullptr, count);
+  });
+  CountDraw(count);
+}
+
+void Mesh::CountDraw(int32 count) const noexcept {
+  OVER_RENDER_STAT(drawCalls, 1);
+  OVER_RENDER_STAT(triangles, _ibo.Size() / 3 * static_cast<uint64>(count));
+  OVER_RENDER_STAT(instances, static_cast<uint64>(count));
+}
+
+gl::DrawElementsCommand Mesh::GetDrawCommand() const noexcept {
+  gl::DrawElementsCommand command;
+  command.count = static_cast<uint32>(_ibo.Size());
+  command.instanceCount = 1;
+  return command;
+}
+
 Mesh Mesh::GenQuad(std::vector<MeshTexture> textures) {
   static std::vector<Vertex> data = {
       Vertex({-1.f, -1.f, 0.f}, {0.f, 0.f, 0.f}, {0.f, 0.f}),
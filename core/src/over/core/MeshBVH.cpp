@@ -0,0 +1,235 @@
+#include <over/core/MeshBVH.hpp>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OVER_MESH_BVH_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace over {
+
+// determinant below it means the ray is parallel to the triangle
+constexpr float32 PARALLEL_EPSILON = 1e-8f;
+
+MeshBVH::MeshBVH(const std::vector<Vertex>& vertices,
+                 const std::vector<Element>& elements) {
+  std::vector<AABB> bounds;
+  bounds.reserve(elements.size());
+  for (const auto& element : elements) {
+    AABB box;
+    box.Expand(vertices[element.a].position);
+    box.Expand(vertices[element.b].position);
+    box.Expand(vertices[element.c].position);
+    bounds.push_back(box);
+  }
+
+  _bvh.Build(std::move(bounds));
+  _order = _bvh.GetIndices();
+
+  // batches may read past the last leaf
+  auto padded = (_order.size() + BATCH - 1) / BATCH * BATCH;
+  for (auto* v : {&_ax, &_ay, &_az, &_e1x, &_e1y, &_e1z, &_e2x, &_e2y,
+                  &_e2z}) {
+    v->assign(padded, 0.f);
+  }
+
+  for (usize i = 0; i < _order.size(); i++) {
+    const auto& element = elements[_order[i]];
+    glm::vec3 a = vertices[element.a].position;
+    glm::vec3 e1 = vertices[element.b].position - a;
+    glm::vec3 e2 = vertices[element.c].position - a;
+
+    _ax[i] = a.x;
+    _ay[i] = a.y;
+    _az[i] = a.z;
+    _e1x[i] = e1.x;
+    _e1y[i] = e1.y;
+    _e1z[i] = e1.z;
+    _e2x[i] = e2.x;
+    _e2y[i] = e2.y;
+    _e2z[i] = e2.z;
+  }
+}
+
+TriangleHit MeshBVH::Raycast(const Ray& ray, float32 maxDistance) const {
+  TriangleHit result;
+  glm::vec2 barycentric(0);
+
+  auto hit = _bvh.RaycastLeaves(
+      ray, maxDistance, [&](const BVHNode& node, float32& distance) {
+        uint32 index = IntersectRange(ray, node.leftOrFirst, node.count,
+                                      distance, barycentric);
+        if (index == BVH::NONE) {
+          return BVH::NONE;
+        }
+        result.barycentric = barycentric;
+        return _order[index];
+      });
+
+  if (hit) {
+    result.triangle = hit.primitive;
+    result.distance = hit.distance;
+  }
+  return result;
+}
+
+bool MeshBVH::Occluded(const Ray& ray, float32 maxDistance) const {
+  glm::vec2 barycentric;
+  auto hit = _bvh.RaycastLeaves(
+      ray, maxDistance,
+      [&](const BVHNode& node, float32& distance) {
+        uint32 index = IntersectRange(ray, node.leftOrFirst, node.count,
+                                      distance, barycentric);
+        return index == BVH::NONE ? BVH::NONE : _order[index];
+      },
+      true);
+  return static_cast<bool>(hit);
+}
+
+#if defined(OVER_MESH_BVH_SSE)
+
+uint32 MeshBVH::IntersectRange(const Ray& ray, uint32 first, uint32 count,
+                               float32& distance,
+                               glm::vec2& barycentric) const {
+  // Moller-Trumbore, one ray against four triangles
+  const __m128 dx = _mm_set1_ps(ray.direction.x);
+  const __m128 dy = _mm_set1_ps(ray.direction.y);
+  const __m128 dz = _mm_set1_ps(ray.direction.z);
+  const __m128 ox = _mm_set1_ps(ray.origin.x);
+  const __m128 oy = _mm_set1_ps(ray.origin.y);
+  const __m128 oz = _mm_set1_ps(ray.origin.z);
+
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 epsilon = _mm_set1_ps(PARALLEL_EPSILON);
+  const __m128 signMask = _mm_set1_ps(-0.f);
+
+  uint32 result = BVH::NONE;
+
+  for (uint32 i = first; i < first + count; i += BATCH) {
+    __m128 e1x = _mm_loadu_ps(_e1x.data() + i);
+    __m128 e1y = _mm_loadu_ps(_e1y.data() + i);
+    __m128 e1z = _mm_loadu_ps(_e1z.data() + i);
+    __m128 e2x = _mm_loadu_ps(_e2x.data() + i);
+    __m128 e2y = _mm_loadu_ps(_e2y.data() + i);
+    __m128 e2z = _mm_loadu_ps(_e2z.data() + i);
+
+    // p = d x e2
+    __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+    __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+    __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+    __m128 det = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)),
+        _mm_mul_ps(e1z, pz));
+    __m128 valid = _mm_cmpgt_ps(_mm_andnot_ps(signMask, det), epsilon);
+    __m128 inverse = _mm_div_ps(one, det);
+
+    // t = o - a
+    __m128 tx = _mm_sub_ps(ox, _mm_loadu_ps(_ax.data() + i));
+    __m128 ty = _mm_sub_ps(oy, _mm_loadu_ps(_ay.data() + i));
+    __m128 tz = _mm_sub_ps(oz, _mm_loadu_ps(_az.data() + i));
+
+    __m128 u = _mm_mul_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)),
+                   _mm_mul_ps(tz, pz)),
+        inverse);
+
+    // q = t x e1
+    __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+    __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+    __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+    __m128 v = _mm_mul_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)),
+                   _mm_mul_ps(dz, qz)),
+        inverse);
+    __m128 t = _mm_mul_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)),
+                   _mm_mul_ps(e2z, qz)),
+        inverse);
+
+    valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+    valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+    valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+    valid = _mm_and_ps(valid, _mm_cmpgt_ps(t, zero));
+    valid = _mm_and_ps(valid, _mm_cmplt_ps(t, _mm_set1_ps(distance)));
+
+    int32 mask = _mm_movemask_ps(valid);
+    if (mask == 0) {
+      continue;
+    }
+
+    alignas(16) float32 ts[BATCH], us[BATCH], vs[BATCH];
+    _mm_store_ps(ts, t);
+    _mm_store_ps(us, u);
+    _mm_store_ps(vs, v);
+
+    for (uint32 k = 0; k < BATCH; k++) {
+      // lanes past the range belong to the next leaf, they are real
+      // triangles so a hit there is still a correct hit
+      if ((mask & (1 << k)) != 0 && ts[k] < distance) {
+        distance = ts[k];
+        barycentric = glm::vec2(us[k], vs[k]);
+        result = i + k;
+      }
+    }
+  }
+
+  return result;
+}
+
+const char* MeshBVH::GetInstructionSet() noexcept {
+  return "SSE";
+}
+
+#else
+
+uint32 MeshBVH::IntersectRange(const Ray& ray, uint32 first, uint32 count,
+                               float32& distance,
+                               glm::vec2& barycentric) const {
+  uint32 result = BVH::NONE;
+
+  for (uint32 i = first; i < first + count; i++) {
+    glm::vec3 e1(_e1x[i], _e1y[i], _e1z[i]);
+    glm::vec3 e2(_e2x[i], _e2y[i], _e2z[i]);
+
+    glm::vec3 p = glm::cross(ray.direction, e2);
+    float32 det = glm::dot(e1, p);
+    if (std::abs(det) <= PARALLEL_EPSILON) {
+      continue;
+    }
+    float32 inverse = 1.f / det;
+
+    glm::vec3 t = ray.origin - glm::vec3(_ax[i], _ay[i], _az[i]);
+    float32 u = glm::dot(t, p) * inverse;
+    if (u < 0.f || u > 1.f) {
+      continue;
+    }
+
+    glm::vec3 q = glm::cross(t, e1);
+    float32 v = glm::dot(ray.direction, q) * inverse;
+    if (v < 0.f || u + v > 1.f) {
+      continue;
+    }
+
+    float32 hit = glm::dot(e2, q) * inverse;
+    if (hit > 0.f && hit < distance) {
+      distance = hit;
+      barycentric = glm::vec2(u, v);
+      result = i;
+    }
+  }
+
+  return result;
+}
+
+const char* MeshBVH::GetInstructionSet() noexcept {
+  return "Scalar";
+}
+
+#endif
+
+}  // namespace over
@@ -1,5 +1,8 @@
 #include <over/core/Model.hpp>
 
+#include <algorithm>
+#include <queue>
+#include <utility>
 #include <vector>
 
 #include <assimp/postprocess.h>
@@ -12,14 +15,35 @@
 
 namespace over {
 Model::Model(const std::string& path)
-    : _directory(), _transform(), _paths(), _wrappers(), _meshes() {
+    : _directory(),
+      _transform(),
+      _paths(),
+      _wrappers(),
+      _meshes(),
+      _meshNodes(),
+      _scene(),
+      _modelUniform("camera.model"),
+      _bounds(),
+      _sphere() {
   LoadModel(path);
+  UpdateBounds();
 }
 
+namespace {
+glm::mat4 ToGlm(const aiMatrix4x4& m) {
+  // assimp is row major, glm is column major
+  return glm::mat4(m.a1, m.b1, m.c1, m.d1, m.a2, m.b2, m.c2, m.d2, m.a3, m.b3,
+                   m.c3, m.d3, m.a4, m.b4, m.c4, m.d4);
+}
+}  // namespace
+
 void Model::Draw(Shader& shader) {
-  shader.SetMatrix4f("camera.model", _transform.GetModel());
-  for (auto& mesh : _meshes) {
-    mesh.Draw(shader);
+  UpdateScene();
+
+  auto model = _transform.GetModel();
+  for (usize i = 0; i < _meshes.size(); i++) {
+    shader.SetMatrix4f(_modelUniform, model * _scene.GetWorld(_meshNodes[i]));
+    _meshes[i].Draw(shader);
   }
 }
 
@@ -28,6 +52,102 @@ void Model::Draw() {
   Draw(shader);
 }
 
+void Model::DrawDepth(Shader& shader) { DrawDepth(shader, glm::mat4(1.f)); }
+
+void Model::DrawDepth(Shader& shader, const glm::mat4& transform) {
+  UpdateScene();
+
+  auto model = transform * _transform.GetModel();
+  for (usize i = 0; i < _meshes.size(); i++) {
+    shader.SetMatrix4f(_modelUniform, model * _scene.GetWorld(_meshNodes[i]));
+    _meshes[i].DrawDepth();
+  }
+}
+
+usize Model::Draw(Shader& shader, const Frustum& frustum) {
+  UpdateScene();
+
+  auto model = _transform.GetModel();
+  if (!frustum.Intersects(_bounds.Transformed(model))) {
+    return 0;
+  }
+
+  usize drawn = 0;
+  for (usize i = 0; i < _meshes.size(); i++) {
+    auto meshModel = model * _scene.GetWorld(_meshNodes[i]);
+    if (_meshes.size() > 1 &&
+        !frustum.Intersects(_meshes[i].GetBounds().Transformed(meshModel))) {
+      continue;
+    }
+
+    shader.SetMatrix4f(_modelUniform, meshModel);
+    _meshes[i].Draw(shader);
+    drawn++;
+  }
+  return drawn;
+}
+
+const glm::mat4& Model::GetMeshTransform(usize mesh) {
+  UpdateScene();
+  return _scene.GetWorld(_meshNodes[mesh]);
+}
+
+AABB Model::GetWorldBounds() const noexcept {
+  return _bounds.Transformed(_transform.GetModel());
+}
+
+void Model::UpdateBounds() {
+  _scene.Update();
+
+  _bounds = AABB();
+  for (usize i = 0; i < _meshes.size(); i++) {
+    _bounds.Expand(
+        _meshes[i].GetBounds().Transformed(_scene.GetWorld(_meshNodes[i])));
+  }
+
+  _sphere = Sphere(_bounds.GetCenter(), 0.f);
+  for (usize i = 0; i < _meshes.size(); i++) {
+    auto sphere = _meshes[i].GetBoundingSphere().Transformed(
+        _scene.GetWorld(_meshNodes[i]));
+    _sphere.radius =
+        std::max(_sphere.radius,
+                 glm::distance(_sphere.center, sphere.center) + sphere.radius);
+  }
+}
+
+void Model::UpdateScene() {
+  // every consumer of the dirty flags refreshes the bounds with them
+  if (_scene.Update() > 0) {
+    UpdateBounds();
+  }
+}
+
+Model::Hit Model::Raycast(const Ray& ray, float32 maxDistance) {
+  UpdateScene();
+
+  Hit result;
+  result.distance = maxDistance;
+
+  float32 entry;
+  if (!GetWorldBounds().Intersects(ray, maxDistance, entry)) {
+    return result;
+  }
+
+  auto model = _transform.GetModel();
+  for (usize i = 0; i < _meshes.size(); i++) {
+    // local ray keeps world distances: direction is not renormalized
+    auto local = ray.Transformed(glm::inverse(model * GetMeshTransform(i)));
+    auto hit = _meshes[i].Raycast(local, result.distance);
+    if (hit) {
+      result.mesh = i;
+      result.triangle = hit.triangle;
+      result.barycentric = hit.barycentric;
+      result.distance = hit.distance;
+    }
+  }
+  return result;
+}
+
 void Model::LoadModel(const std::string& path) {
   Assimp::Importer importer;
   const aiScene* scene =
@@ -44,14 +164,27 @@ void Model::LoadModel(const std::string& path) {
   ProcessNode(scene->mRootNode, scene);
 }
 
-void Model::ProcessNode(aiNode* node, const aiScene* scene) {
-  for (size_t i = 0; i < node->mNumMeshes; i++) {
-    auto* mesh = scene->mMeshes[node->mMeshes[i]];
-    _meshes.push_back(ProcessMesh(mesh, scene));
-  }
+void Model::ProcessNode(aiNode* root, const aiScene* scene) {
+  // breadth first, so the scene graph storage is breadth first too
+  std::queue<std::pair<aiNode*, SceneGraph::Node>> nodes;
+  _scene.SetLocal(SceneGraph::ROOT, ToGlm(root->mTransformation));
+  nodes.emplace(root, SceneGraph::ROOT);
+
+  while (!nodes.empty()) {
+    auto [node, index] = nodes.front();
+    nodes.pop();
 
-  for (size_t i = 0; i < node->mNumChildren; i++) {
-    ProcessNode(node->mChildren[i], scene);
+    for (size_t i = 0; i < node->mNumMeshes; i++) {
+      auto* mesh = scene->mMeshes[node->mMeshes[i]];
+      _meshes.push_back(ProcessMesh(mesh, scene));
+      _meshNodes.push_back(index);
+    }
+
+    for (size_t i = 0; i < node->mNumChildren; i++) {
+      auto* child = node->mChildren[i];
+      nodes.emplace(child, _scene.Add(index, ToGlm(child->mTransformation),
+                                      child->mName.C_Str()));
+    }
   }
 }
 
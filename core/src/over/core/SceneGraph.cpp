@@ -0,0 +1,155 @@
+#include <over/core/SceneGraph.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace over {
+
+SceneGraph::SceneGraph()
+    : _parents(), _locals(), _worlds(), _dirty(), _names(), _firstDirty(0) {
+  _parents.push_back(NONE);
+  _locals.emplace_back(1);
+  _worlds.emplace_back(1);
+  _dirty.push_back(1);
+  _names.emplace_back("root");
+}
+
+void SceneGraph::Reserve(usize count) {
+  _parents.reserve(count);
+  _locals.reserve(count);
+  _worlds.reserve(count);
+  _dirty.reserve(count);
+  _names.reserve(count);
+}
+
+SceneGraph::Node SceneGraph::Add(Node parent, const glm::mat4& local,
+                                 std::string name) {
+  assert(parent < Size());
+
+  Node node = static_cast<Node>(Size());
+  _parents.push_back(parent);
+  _locals.push_back(local);
+  _worlds.push_back(local);
+  _dirty.push_back(0);
+  _names.push_back(std::move(name));
+
+  MarkDirty(node);
+  return node;
+}
+
+SceneGraph::Node SceneGraph::Find(std::string_view name) const noexcept {
+  for (usize i = 0; i < _names.size(); i++) {
+    if (_names[i] == name) {
+      return static_cast<Node>(i);
+    }
+  }
+  return NONE;
+}
+
+void SceneGraph::SetLocal(Node node, const glm::mat4& local) {
+  _locals[node] = local;
+  MarkDirty(node);
+}
+
+void SceneGraph::MarkDirty(Node node) noexcept {
+  _dirty[node] = 1;
+  _firstDirty = std::min(_firstDirty, static_cast<usize>(node));
+}
+
+usize SceneGraph::Update() {
+  if (!IsDirty()) {
+    return 0;
+  }
+
+  usize updated = 0;
+  usize begin = _firstDirty;
+
+  if (begin == ROOT) {
+    _worlds[ROOT] = _locals[ROOT];
+    updated++;
+    begin++;
+  }
+
+  // parents are already final: they precede children in storage
+  for (usize i = begin; i < _parents.size(); i++) {
+    Node parent = _parents[i];
+    if ((_dirty[i] | _dirty[parent]) != 0) {
+      _worlds[i] = _worlds[parent] * _locals[i];
+      _dirty[i] = 1;
+      updated++;
+    }
+  }
+
+  std::fill(_dirty.begin() + _firstDirty, _dirty.end(), uint8(0));
+  _firstDirty = Size();
+
+  return updated;
+}
+
+std::vector<SceneGraph::Node> SceneGraph::SortBreadthFirst() {
+  usize size = Size();
+
+  // children lists in counting sort form
+  std::vector<Node> childStart(size + 1, 0);
+  for (usize i = 1; i < size; i++) {
+    childStart[_parents[i] + 1]++;
+  }
+  for (usize i = 0; i < size; i++) {
+    childStart[i + 1] += childStart[i];
+  }
+
+  std::vector<Node> children(size > 0 ? size - 1 : 0);
+  std::vector<Node> cursor(childStart.begin(), childStart.end() - 1);
+  for (usize i = 1; i < size; i++) {
+    children[cursor[_parents[i]]++] = static_cast<Node>(i);
+  }
+
+  std::vector<Node> order;
+  order.reserve(size);
+  order.push_back(ROOT);
+  for (usize head = 0; head < order.size(); head++) {
+    Node node = order[head];
+    for (Node c = childStart[node]; c < childStart[node + 1]; c++) {
+      order.push_back(children[c]);
+    }
+  }
+
+  std::vector<Node> remap(size, NONE);
+  for (usize i = 0; i < size; i++) {
+    remap[order[i]] = static_cast<Node>(i);
+  }
+
+  std::vector<Node> parents(size);
+  std::vector<glm::mat4> locals(size);
+  std::vector<glm::mat4> worlds(size);
+  std::vector<uint8> dirty(size);
+  std::vector<std::string> names(size);
+
+  for (usize i = 0; i < size; i++) {
+    Node old = order[i];
+    parents[i] = old == ROOT ? NONE : remap[_parents[old]];
+    locals[i] = _locals[old];
+    worlds[i] = _worlds[old];
+    dirty[i] = _dirty[old];
+    names[i] = std::move(_names[old]);
+  }
+
+  _parents = std::move(parents);
+  _locals = std::move(locals);
+  _worlds = std::move(worlds);
+  _dirty = std::move(dirty);
+  _names = std::move(names);
+
+  _firstDirty = size;
+  for (usize i = 0; i < size; i++) {
+    if (_dirty[i] != 0) {
+      _firstDirty = i;
+      break;
+    }
+  }
+
+  return remap;
+}
+
+}  // namespace over
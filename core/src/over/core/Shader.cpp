@@ -1,5 +1,7 @@
 #include <over/core/Shader.hpp>
 
+#include <over/core/opengl/RenderStats.hpp>
+
 #include <cassert>
 #include <fstream>
 #include <sstream>
@@ -36,6 +38,8 @@ static std::string_view GetShaderType(GLenum value) {
       return "FRAGMENT_SHADER";
     case GL_GEOMETRY_SHADER:
       return "GEOMETRY_SHADER";
+    case GL_COMPUTE_SHADER:
+      return "COMPUTE_SHADER";
     default:
       throw std::runtime_error("Unknown shader type");
   }
@@ -57,15 +61,17 @@ static GLuint CompileShader(const char* source, GLenum type) {
   return shader;
 }
 
-Shader::Shader() noexcept : vertexPath_(), fragmentPath_(), program_(0) {}
+Shader::Shader() noexcept
+    : vertexPath_(), fragmentPath_(), generated_(false), program_(0) {}
 
 Shader::Shader(GLuint id) noexcept
-    : vertexPath_(), fragmentPath_(), program_(id) {}
+    : vertexPath_(), fragmentPath_(), generated_(false), program_(id) {}
 
 Shader::Shader(std::string vertexPath, std::string fragmentPath)
     : vertexPath_(std::move(vertexPath)),
       fragmentPath_(std::move(fragmentPath)),
       geometryPath_(),
+      generated_(false),
       program_(0) {
   Compile();
 }
@@ -75,10 +81,30 @@ Shader::Shader(std::string_view vertex, std::string_view fragment,
     : vertexPath_(vertex),
       fragmentPath_(fragment),
       geometryPath_(geometry),
+      generated_(false),
       program_(0) {
   Compile();
 }
 
+Shader Shader::FromCompute(std::string computePath) {
+  if (!GLAD_GL_VERSION_4_3) {
+    throw std::runtime_error("Compute shaders require OpenGL 4.3 context");
+  }
+
+  Shader result;
+  result.computePath_ = std::move(computePath);
+  result.CompileCompute();
+  return result;
+}
+
+Shader Shader::FromSource(std::string_view vertexSource,
+                          std::string_view fragmentSource) {
+  Shader result;
+  result.generated_ = true;
+  result.Build(std::string(vertexSource), std::string(fragmentSource), "");
+  return result;
+}
+
 Shader::Shader(Shader&& other) noexcept : Shader() {
   *this = std::move(other);
 }
@@ -92,6 +118,8 @@ Shader& Shader::operator=(Shader&& other) noexcept {
   vertexPath_ = std::move(other.vertexPath_);
   fragmentPath_ = std::move(other.fragmentPath_);
   geometryPath_ = std::move(other.geometryPath_);
+  computePath_ = std::move(other.computePath_);
+  generated_ = std::exchange(other.generated_, false);
   program_ = std::exchange(other.program_, 0);
   // can be only
   // 1) Empty, so no compile needed
@@ -121,6 +149,12 @@ void Shader::Compile() {
     throw fmt::system_error(-1, "cannot read shader file: {}", e.what());
   }
 
+  Build(vertexShaderSource, fragmentShaderSource, geometryShaderSource);
+}
+
+void Shader::Build(const std::string& vertexShaderSource,
+                   const std::string& fragmentShaderSource,
+                   const std::string& geometryShaderSource) {
   GLuint vertexShader =
       CompileShader(vertexShaderSource.c_str(), GL_VERTEX_SHADER);
   GLuint fragmentShader =
@@ -146,6 +180,31 @@ void Shader::Compile() {
     glDeleteShader(geometryShader);
   }
 
+  Link(program);
+}
+
+void Shader::CompileCompute() {
+  std::string computeShaderSource;
+
+  try {
+    computeShaderSource = ReadShaderFile(computePath_);
+  } catch (std::ifstream::failure& e) {
+    fmt::println("cannot read shader file: {}", e.what());
+    throw fmt::system_error(-1, "cannot read shader file: {}", e.what());
+  }
+
+  GLuint computeShader =
+      CompileShader(computeShaderSource.c_str(), GL_COMPUTE_SHADER);
+
+  GLuint program = glCreateProgram();
+  glAttachShader(program, computeShader);
+  glLinkProgram(program);
+  glDeleteShader(computeShader);
+
+  Link(program);
+}
+
+void Shader::Link(GLuint program) {
   int32 success;
   char infoLog[512];
   glGetProgramiv(program, GL_LINK_STATUS, &success);
@@ -158,16 +217,19 @@ void Shader::Compile() {
   FreeGPU();
 
   program_ = program;
+  OVER_RENDER_STAT(created, 1);
 }
 
 void Shader::FreeGPU() noexcept {
   // if no program or it's view of other shader
-  if (0 == program_ || vertexPath_.empty() && fragmentPath_.empty()) {
+  if (0 == program_ || !generated_ && vertexPath_.empty() &&
+                           fragmentPath_.empty() && computePath_.empty()) {
     return;
   }
 
   glDeleteProgram(program_);
   program_ = 0;
+  OVER_RENDER_STAT(destroyed, 1);
 }
 
 void Shader::Activate() noexcept {
@@ -184,6 +246,8 @@ void Shader::Unbind() noexcept {
 }
 
 GLint Shader::GetUniformLocation(const std::string& name) const {
+  // every uniform call resolves its location here
+  OVER_RENDER_STAT(uniformCalls, 1);
   return glGetUniformLocation(program_, name.c_str());
 }
 
@@ -199,6 +263,10 @@ void Shader::SetInt(const std::string& name, int32 value) {
   glUniform1i(GetUniformLocation(name), value);
 }
 
+void Shader::SetUInt(const std::string& name, uint32 value) {
+  glUniform1ui(GetUniformLocation(name), value);
+}
+
 void Shader::SetMatrix4f(const std::string& name, float32* ptr) {
   glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, ptr);
 }
@@ -237,12 +305,61 @@ void Shader::SetVec2f(const std::string& name, float32* ptr) {
   glUniform2fv(GetUniformLocation(name), 1, ptr);
 }
 
+void Shader::SetVec4f(const std::string& name, glm::vec4 v) {
+  glUniform4f(GetUniformLocation(name), v.x, v.y, v.z, v.w);
+}
+
+void Shader::SetVec4fv(const std::string& name, usize count,
+                       const float32* ptr) {
+  glUniform4fv(GetUniformLocation(name), static_cast<GLsizei>(count), ptr);
+}
+
+void Shader::SetIVec2(const std::string& name, glm::ivec2 v) {
+  glUniform2i(GetUniformLocation(name), v.x, v.y);
+}
+
+void Shader::SetIVec3(const std::string& name, glm::ivec3 v) {
+  glUniform3i(GetUniformLocation(name), v.x, v.y, v.z);
+}
+
 void Shader::BindUniform(std::string_view name, usize index) {
   uint32 uniformId = glGetUniformBlockIndex(program_, name.data());
   glUniformBlockBinding(program_, static_cast<GLuint>(uniformId),
                         static_cast<GLuint>(index));
 }
 
+void Shader::BindStorage(const std::string& name, usize index) {
+  GLuint blockId = glGetProgramResourceIndex(program_, GL_SHADER_STORAGE_BLOCK,
+                                             name.c_str());
+  if (blockId == GL_INVALID_INDEX) {
+    throw std::runtime_error(
+        fmt::format("shader has no storage block {}", name));
+  }
+  glShaderStorageBlockBinding(program_, blockId, static_cast<GLuint>(index));
+}
+
+glm::ivec3 Shader::GetWorkGroupSize() const {
+  assert(IsCompute());
+  glm::ivec3 result(0);
+  glGetProgramiv(program_, GL_COMPUTE_WORK_GROUP_SIZE, glm::value_ptr(result));
+  return result;
+}
+
+void Shader::Dispatch(uint32 x, uint32 y, uint32 z) {
+  assert(IsCompute());
+  Activate();
+  glDispatchCompute(static_cast<GLuint>(x), static_cast<GLuint>(y),
+                    static_cast<GLuint>(z));
+  OVER_RENDER_STAT(dispatches, 1);
+}
+
+void Shader::DispatchIndirect(usize offset) {
+  assert(IsCompute());
+  Activate();
+  glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+  OVER_RENDER_STAT(dispatches, 1);
+}
+
 Shader Shader::GetCurrent() noexcept {
   return Shader(s_currentProgram);
 }
@@ -253,6 +370,7 @@ void Shader::UseProgram(Shader& shader) {
   if (s_currentProgram != shader.program_) {
     glUseProgram(shader.program_);
     s_currentProgram = shader.program_;
+    OVER_RENDER_STAT(programBinds, 1);
   }
 }
 
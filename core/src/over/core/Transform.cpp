@@ -1,26 +1,96 @@
 #include <over/core/Transform.hpp>
 
-#include <glm/glm.hpp>
-#include <glm/ext/matrix_transform.hpp>
+#include <utility>
 
 namespace over {
-Transform::Transform() : position(0), rotation(0), scale(1) {}
+namespace {
+glm::quat FromEuler(glm::vec3 angles) {
+  return glm::angleAxis(angles.x, glm::vec3(1, 0, 0)) *
+         glm::angleAxis(angles.y, glm::vec3(0, 1, 0)) *
+         glm::angleAxis(angles.z, glm::vec3(0, 0, 1));
+}
+}  // namespace
+
+Transform::Transform() : Transform(TransformStorage::GetDefault()) {}
 
 Transform::Transform(glm::vec3 position, glm::vec3 rotation, glm::vec3 scale)
-    : position(position), rotation(rotation), scale(scale) {}
+    : Transform(TransformStorage::GetDefault(), position, FromEuler(rotation),
+                scale) {}
 
-glm::mat4 Transform::GetModel() const noexcept {
-  glm::mat4 result = glm::mat4(1);
+Transform::Transform(TransformStorage& storage, glm::vec3 position,
+                     glm::quat rotation, glm::vec3 scale)
+    : _storage(&storage), _id(storage.Create(position, rotation, scale)) {}
 
-  result = glm::translate(result, position);
+Transform::Transform(const Transform& other)
+    : Transform(*other._storage, other.GetPosition(), other.GetRotation(),
+                other.GetScale()) {}
+
+Transform& Transform::operator=(const Transform& other) {
+  if (this != &other) {
+    SetPosition(other.GetPosition());
+    SetRotation(other.GetRotation());
+    SetScale(other.GetScale());
+  }
+  return *this;
+}
 
-  // TODO: change to quaternion
-  result = glm::rotate(result, rotation.x, glm::vec3(1, 0, 0));
-  result = glm::rotate(result, rotation.y, glm::vec3(0, 1, 0));
-  result = glm::rotate(result, rotation.z, glm::vec3(0, 0, 1));
+Transform::Transform(Transform&& other) noexcept
+    : _storage(std::exchange(other._storage, nullptr)), _id(other._id) {}
 
-  result = glm::scale(result, scale);
+Transform& Transform::operator=(Transform&& other) noexcept {
+  if (this != &other) {
+    if (_storage) {
+      _storage->Destroy(_id);
+    }
+    _storage = std::exchange(other._storage, nullptr);
+    _id = other._id;
+  }
+  return *this;
+}
+
+Transform::~Transform() {
+  if (_storage) {
+    _storage->Destroy(_id);
+  }
+}
+
+glm::vec3 Transform::GetPosition() const noexcept {
+  return _storage->GetPosition(_id);
+}
+
+void Transform::SetPosition(glm::vec3 position) noexcept {
+  _storage->SetPosition(_id, position);
+}
+
+void Transform::Translate(glm::vec3 offset) noexcept {
+  SetPosition(GetPosition() + offset);
+}
+
+glm::quat Transform::GetRotation() const noexcept {
+  return _storage->GetRotation(_id);
+}
+
+void Transform::SetRotation(glm::quat rotation) noexcept {
+  _storage->SetRotation(_id, rotation);
+}
+
+void Transform::SetRotation(glm::vec3 angles) noexcept {
+  SetRotation(FromEuler(angles));
+}
+
+void Transform::Rotate(float32 angle, glm::vec3 axis) noexcept {
+  SetRotation(GetRotation() * glm::angleAxis(angle, glm::normalize(axis)));
+}
+
+glm::vec3 Transform::GetScale() const noexcept {
+  return _storage->GetScale(_id);
+}
+
+void Transform::SetScale(glm::vec3 scale) noexcept {
+  _storage->SetScale(_id, scale);
+}
 
-  return result;
+const glm::mat4& Transform::GetModel() const noexcept {
+  return _storage->GetModel(_id);
 }
 }  // namespace over
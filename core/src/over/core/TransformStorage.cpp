@@ -0,0 +1,285 @@
+#include <over/core/TransformStorage.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <over/core/WorkerPool.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OVER_TRANSFORM_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace over {
+
+TransformStorage::TransformStorage()
+    : _positionX(),
+      _positionY(),
+      _positionZ(),
+      _rotationX(),
+      _rotationY(),
+      _rotationZ(),
+      _rotationW(),
+      _scaleX(),
+      _scaleY(),
+      _scaleZ(),
+      _models(),
+      _dirty(),
+      _free(),
+      _size(0),
+      _dirtyCount(0) {}
+
+TransformStorage& TransformStorage::GetDefault() {
+  static TransformStorage storage;
+  return storage;
+}
+
+void TransformStorage::Reserve(usize count) {
+  auto padded = (count + BATCH - 1) / BATCH * BATCH;
+  for (auto* v : {&_positionX, &_positionY, &_positionZ, &_rotationX,
+                  &_rotationY, &_rotationZ, &_rotationW, &_scaleX, &_scaleY,
+                  &_scaleZ}) {
+    v->reserve(padded);
+  }
+  _models.reserve(padded);
+  _dirty.reserve(padded);
+}
+
+TransformStorage::Id TransformStorage::Create(glm::vec3 position,
+                                              glm::quat rotation,
+                                              glm::vec3 scale) {
+  Id id;
+  if (!_free.empty()) {
+    id = _free.back();
+    _free.pop_back();
+  } else {
+    // grow by whole batch, tail stays identity and clean
+    id = static_cast<Id>(_models.size());
+    auto padded = _models.size() + BATCH;
+    for (auto* v : {&_positionX, &_positionY, &_positionZ, &_rotationX,
+                    &_rotationY, &_rotationZ}) {
+      v->resize(padded, 0.f);
+    }
+    for (auto* v : {&_rotationW, &_scaleX, &_scaleY, &_scaleZ}) {
+      v->resize(padded, 1.f);
+    }
+    _models.resize(padded, glm::mat4(1));
+    _dirty.resize(padded, 0);
+    for (usize i = padded - 1; i > id; i--) {
+      _free.push_back(static_cast<Id>(i));
+    }
+  }
+
+  _size++;
+
+  SetPosition(id, position);
+  SetRotation(id, rotation);
+  SetScale(id, scale);
+  return id;
+}
+
+void TransformStorage::Destroy(Id id) {
+  if (_dirty[id] != 0) {
+    _dirty[id] = 0;
+    _dirtyCount--;
+  }
+  _free.push_back(id);
+  _size--;
+}
+
+glm::vec3 TransformStorage::GetPosition(Id id) const noexcept {
+  return glm::vec3(_positionX[id], _positionY[id], _positionZ[id]);
+}
+
+glm::quat TransformStorage::GetRotation(Id id) const noexcept {
+  return glm::quat(_rotationW[id], _rotationX[id], _rotationY[id],
+                   _rotationZ[id]);
+}
+
+glm::vec3 TransformStorage::GetScale(Id id) const noexcept {
+  return glm::vec3(_scaleX[id], _scaleY[id], _scaleZ[id]);
+}
+
+void TransformStorage::SetPosition(Id id, glm::vec3 position) noexcept {
+  _positionX[id] = position.x;
+  _positionY[id] = position.y;
+  _positionZ[id] = position.z;
+  MarkDirty(id);
+}
+
+void TransformStorage::SetRotation(Id id, glm::quat rotation) noexcept {
+  rotation = glm::normalize(rotation);
+  _rotationX[id] = rotation.x;
+  _rotationY[id] = rotation.y;
+  _rotationZ[id] = rotation.z;
+  _rotationW[id] = rotation.w;
+  MarkDirty(id);
+}
+
+void TransformStorage::SetScale(Id id, glm::vec3 scale) noexcept {
+  _scaleX[id] = scale.x;
+  _scaleY[id] = scale.y;
+  _scaleZ[id] = scale.z;
+  MarkDirty(id);
+}
+
+void TransformStorage::MarkDirty(Id id) noexcept {
+  if (_dirty[id] == 0) {
+    _dirty[id] = 1;
+    _dirtyCount++;
+  }
+}
+
+const glm::mat4& TransformStorage::GetModel(Id id) noexcept {
+  if (_dirty[id] != 0) {
+    RebuildOne(id);
+    _dirty[id] = 0;
+    _dirtyCount--;
+  }
+  return _models[id];
+}
+
+usize TransformStorage::Update() {
+  usize dirty = _dirtyCount;
+  if (dirty == 0) {
+    return 0;
+  }
+
+  usize size = _models.size();
+  auto& pool = WorkerPool::GetShared();
+  usize threads = std::min(pool.Size(), dirty / (PARALLEL_THRESHOLD / 4));
+
+  if (dirty < PARALLEL_THRESHOLD || threads <= 1) {
+    Rebuild(0, size);
+  } else {
+    // ranges are batch aligned, so threads never share dirty flags
+    usize batches = size / BATCH;
+    usize step = (batches + threads - 1) / threads * BATCH;
+
+    pool.Run(threads, [this, step, size](usize worker) {
+      usize begin = std::min(worker * step, size);
+      Rebuild(begin, std::min(begin + step, size));
+    });
+  }
+
+  _dirtyCount = 0;
+  return dirty;
+}
+
+void TransformStorage::RebuildOne(Id id) noexcept {
+  float32 x = _rotationX[id], y = _rotationY[id], z = _rotationZ[id],
+          w = _rotationW[id];
+  float32 sx = _scaleX[id], sy = _scaleY[id], sz = _scaleZ[id];
+
+  glm::mat4& m = _models[id];
+
+  m[0][0] = (1 - 2 * (y * y + z * z)) * sx;
+  m[0][1] = 2 * (x * y + w * z) * sx;
+  m[0][2] = 2 * (x * z - w * y) * sx;
+  m[0][3] = 0;
+
+  m[1][0] = 2 * (x * y - w * z) * sy;
+  m[1][1] = (1 - 2 * (x * x + z * z)) * sy;
+  m[1][2] = 2 * (y * z + w * x) * sy;
+  m[1][3] = 0;
+
+  m[2][0] = 2 * (x * z + w * y) * sz;
+  m[2][1] = 2 * (y * z - w * x) * sz;
+  m[2][2] = (1 - 2 * (x * x + y * y)) * sz;
+  m[2][3] = 0;
+
+  m[3][0] = _positionX[id];
+  m[3][1] = _positionY[id];
+  m[3][2] = _positionZ[id];
+  m[3][3] = 1;
+}
+
+#if defined(OVER_TRANSFORM_SSE)
+
+void TransformStorage::Rebuild(usize begin, usize end) noexcept {
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 two = _mm_set1_ps(2.f);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (usize i = begin; i < end; i += BATCH) {
+    uint32 mask;
+    std::memcpy(&mask, _dirty.data() + i, sizeof(mask));
+    if (mask == 0) {
+      continue;
+    }
+
+    __m128 x = _mm_loadu_ps(_rotationX.data() + i);
+    __m128 y = _mm_loadu_ps(_rotationY.data() + i);
+    __m128 z = _mm_loadu_ps(_rotationZ.data() + i);
+    __m128 w = _mm_loadu_ps(_rotationW.data() + i);
+
+    __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y),
+           zz = _mm_mul_ps(z, z);
+    __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z),
+           yz = _mm_mul_ps(y, z);
+    __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y),
+           wz = _mm_mul_ps(w, z);
+
+    __m128 sx = _mm_loadu_ps(_scaleX.data() + i);
+    __m128 sy = _mm_loadu_ps(_scaleY.data() + i);
+    __m128 sz = _mm_loadu_ps(_scaleZ.data() + i);
+
+    // rows hold one matrix element of four transforms
+    __m128 c0[4] = {
+        _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+        _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+        _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx), zero};
+    __m128 c1[4] = {
+        _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+        _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+        _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy), zero};
+    __m128 c2[4] = {
+        _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+        _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+        _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+        zero};
+    __m128 c3[4] = {_mm_loadu_ps(_positionX.data() + i),
+                    _mm_loadu_ps(_positionY.data() + i),
+                    _mm_loadu_ps(_positionZ.data() + i), one};
+
+    // after transpose register k is the column of transform i + k
+    _MM_TRANSPOSE4_PS(c0[0], c0[1], c0[2], c0[3]);
+    _MM_TRANSPOSE4_PS(c1[0], c1[1], c1[2], c1[3]);
+    _MM_TRANSPOSE4_PS(c2[0], c2[1], c2[2], c2[3]);
+    _MM_TRANSPOSE4_PS(c3[0], c3[1], c3[2], c3[3]);
+
+    for (usize k = 0; k < BATCH; k++) {
+      float32* m = &_models[i + k][0][0];
+      _mm_storeu_ps(m, c0[k]);
+      _mm_storeu_ps(m + 4, c1[k]);
+      _mm_storeu_ps(m + 8, c2[k]);
+      _mm_storeu_ps(m + 12, c3[k]);
+    }
+
+    std::memset(_dirty.data() + i, 0, BATCH);
+  }
+}
+
+const char* TransformStorage::GetInstructionSet() noexcept {
+  return "SSE";
+}
+
+#else
+
+void TransformStorage::Rebuild(usize begin, usize end) noexcept {
+  for (usize i = begin; i < end; i++) {
+    if (_dirty[i] != 0) {
+      RebuildOne(static_cast<Id>(i));
+      _dirty[i] = 0;
+    }
+  }
+}
+
+const char* TransformStorage::GetInstructionSet() noexcept {
+  return "Scalar";
+}
+
+#endif
+
+}  // namespace over
@@ -0,0 +1,102 @@
+#include <over/core/WorkerPool.hpp>
+
+#include <algorithm>
+
+namespace over {
+
+WorkerPool::WorkerPool(usize workers)
+    : _workers(),
+      _run(),
+      _mutex(),
+      _start(),
+      _done(),
+      _task(nullptr),
+      _count(0),
+      _generation(0),
+      _pending(0),
+      _stop(false) {
+  if (workers == 0) {
+    workers = std::max<usize>(std::thread::hardware_concurrency(), 1) - 1;
+  }
+
+  _workers.reserve(workers);
+  for (usize i = 0; i < workers; i++) {
+    _workers.emplace_back([this, i] { Work(i + 1); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard lock(_mutex);
+    _stop = true;
+  }
+  _start.notify_all();
+
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+void WorkerPool::Run(usize count, const std::function<void(usize)>& func) {
+  if (count == 0) {
+    return;
+  }
+
+  std::lock_guard run(_run);
+
+  usize helpers = std::min(count, Size()) - 1;
+  if (helpers > 0) {
+    {
+      std::lock_guard lock(_mutex);
+      _task = &func;
+      _count = count;
+      _pending = helpers;
+      _generation++;
+    }
+    _start.notify_all();
+  }
+
+  func(0);
+  for (usize i = Size(); i < count; i++) {
+    func(i);
+  }
+
+  if (helpers > 0) {
+    std::unique_lock lock(_mutex);
+    _done.wait(lock, [this] { return _pending == 0; });
+    _task = nullptr;
+  }
+}
+
+WorkerPool& WorkerPool::GetShared() {
+  static WorkerPool pool;
+  return pool;
+}
+
+void WorkerPool::Work(usize index) {
+  usize seen = 0;
+  while (true) {
+    const std::function<void(usize)>* task;
+    {
+      std::unique_lock lock(_mutex);
+      _start.wait(lock, [&] { return _stop || _generation != seen; });
+      if (_stop) {
+        return;
+      }
+      seen = _generation;
+      if (index >= _count) {
+        continue;
+      }
+      task = _task;
+    }
+
+    (*task)(index);
+
+    std::lock_guard lock(_mutex);
+    if (--_pending == 0) {
+      _done.notify_one();
+    }
+  }
+}
+
+}  // namespace over
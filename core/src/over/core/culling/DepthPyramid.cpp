@@ -0,0 +1,91 @@
+#include <over/core/culling/DepthPyramid.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <over/core/opengl/Barrier.hpp>
+#include <over/core/opengl/Texture.hpp>
+
+namespace over::culling {
+
+constexpr usize DEPTH_UNIT = 0;
+constexpr usize PREVIOUS_IMAGE = 0;
+constexpr usize DESTINATION_IMAGE = 1;
+
+DepthPyramid::DepthPyramid(std::string shaderPath)
+    : _shader(Shader::FromCompute(std::move(shaderPath))),
+      _texture(),
+      _size(0),
+      _levels(0) {}
+
+uint32 DepthPyramid::GetLevelCount(glm::ivec2 size) noexcept {
+  uint32 levels = 1;
+  for (int32 s = std::max(size.x, size.y); s > 1; s >>= 1) {
+    levels++;
+  }
+  return levels;
+}
+
+void DepthPyramid::Resize(glm::ivec2 size) {
+  // immutable storage can not be resized, allocate a new texture
+  _texture = gl::TextureWrapper<>();
+  _size = size;
+  _levels = GetLevelCount(size);
+
+  auto view = _texture.As<gl::TextureTarget::TEXTURE_2D>();
+  view.Bind();
+  view.Storage2D(_levels, GL_R32F, _size.x, _size.y);
+  view.SetParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+  view.SetParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  view.SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  view.SetParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  view.Unbind();
+}
+
+void DepthPyramid::Build(gl::Texture2DView depth, glm::ivec2 size) {
+  if (size.x <= 0 || size.y <= 0) {
+    return;
+  }
+  if (size != _size) {
+    Resize(size);
+  }
+
+  auto view = GetTexture();
+  auto group = _shader.GetWorkGroupSize();
+
+  gl::Texture::Activate(GL_TEXTURE0 + DEPTH_UNIT);
+  depth.Bind();
+
+  _shader.Use([&] {
+    _shader.SetInt("depth", DEPTH_UNIT);
+
+    glm::ivec2 previous = _size;
+    for (uint32 level = 0; level < _levels; level++) {
+      glm::ivec2 current(std::max(_size.x >> level, 1),
+                         std::max(_size.y >> level, 1));
+
+      if (level > 0) {
+        view.BindImage(PREVIOUS_IMAGE, level - 1, GL_READ_ONLY, GL_R32F);
+      }
+      view.BindImage(DESTINATION_IMAGE, level, GL_WRITE_ONLY, GL_R32F);
+
+      _shader.SetInt("level", static_cast<int32>(level));
+      _shader.SetIVec2("previousSize", previous);
+      _shader.SetIVec2("size", current);
+      _shader.Dispatch((current.x + group.x - 1) / group.x,
+                       (current.y + group.y - 1) / group.y);
+
+      // next level reads what this one wrote
+      gl::Barrier::ImageAccess();
+      previous = current;
+    }
+  });
+
+  view.UnbindImage(PREVIOUS_IMAGE);
+  view.UnbindImage(DESTINATION_IMAGE);
+  depth.Unbind();
+
+  gl::Barrier::TextureFetch();
+}
+
+}  // namespace over::culling
@@ -0,0 +1,236 @@
+#include <over/core/culling/FrustumCuller.hpp>
+
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__)
+#define OVER_CULLING_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OVER_CULLING_SSE
+#include <emmintrin.h>
+#endif
+
+namespace over::culling {
+
+// padding never passes "distance + radius >= 0"
+constexpr float32 EMPTY_EXTENT = -std::numeric_limits<float32>::max() / 4;
+
+void BoundsSoA::Reserve(usize count) {
+  auto padded = (count + BATCH - 1) / BATCH * BATCH;
+  for (auto* v : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY,
+                  &_extentZ}) {
+    v->reserve(padded);
+  }
+}
+
+void BoundsSoA::Clear() noexcept {
+  for (auto* v : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY,
+                  &_extentZ}) {
+    v->clear();
+  }
+  _size = 0;
+}
+
+void BoundsSoA::Resize(usize size) {
+  auto padded = (size + BATCH - 1) / BATCH * BATCH;
+  for (auto* v : {&_centerX, &_centerY, &_centerZ}) {
+    v->resize(padded, 0.f);
+  }
+  for (auto* v : {&_extentX, &_extentY, &_extentZ}) {
+    v->resize(padded, EMPTY_EXTENT);
+  }
+  _size = size;
+}
+
+usize BoundsSoA::Add(const AABB& box) {
+  auto index = _size;
+  Resize(_size + 1);
+  Set(index, box);
+  return index;
+}
+
+void BoundsSoA::Set(usize index, const AABB& box) {
+  if (box.IsEmpty()) {
+    _centerX[index] = _centerY[index] = _centerZ[index] = 0.f;
+    _extentX[index] = _extentY[index] = _extentZ[index] = EMPTY_EXTENT;
+    return;
+  }
+
+  auto center = box.GetCenter();
+  auto extents = box.GetExtents();
+
+  _centerX[index] = center.x;
+  _centerY[index] = center.y;
+  _centerZ[index] = center.z;
+  _extentX[index] = extents.x;
+  _extentY[index] = extents.y;
+  _extentZ[index] = extents.z;
+}
+
+static void EmitMask(uint32 mask, usize base, usize size,
+                     std::vector<uint32>& visible) {
+  for (uint32 j = 0; mask != 0; j++, mask >>= 1) {
+    if ((mask & 1) != 0 && base + j < size) {
+      visible.push_back(static_cast<uint32>(base + j));
+    }
+  }
+}
+
+usize FrustumCuller::CullScalar(const Frustum& frustum,
+                                const BoundsSoA& bounds,
+                                std::vector<uint32>& visible) {
+  const auto& planes = frustum.GetPlanes();
+  usize before = visible.size();
+
+  for (usize i = 0; i < bounds.Size(); i++) {
+    bool inside = true;
+    for (const auto& plane : planes) {
+      float32 distance = plane.x * bounds.CenterX()[i] +
+                         plane.y * bounds.CenterY()[i] +
+                         plane.z * bounds.CenterZ()[i] + plane.w;
+      float32 radius = std::abs(plane.x) * bounds.ExtentX()[i] +
+                       std::abs(plane.y) * bounds.ExtentY()[i] +
+                       std::abs(plane.z) * bounds.ExtentZ()[i];
+      if (distance + radius < 0.f) {
+        inside = false;
+        break;
+      }
+    }
+
+    if (inside) {
+      visible.push_back(static_cast<uint32>(i));
+    }
+  }
+
+  return visible.size() - before;
+}
+
+#if defined(OVER_CULLING_AVX)
+
+usize FrustumCuller::Cull(const Frustum& frustum, const BoundsSoA& bounds,
+                          std::vector<uint32>& visible) {
+  const auto& planes = frustum.GetPlanes();
+  usize before = visible.size();
+
+  __m256 nx[Frustum::COUNT], ny[Frustum::COUNT], nz[Frustum::COUNT];
+  __m256 ax[Frustum::COUNT], ay[Frustum::COUNT], az[Frustum::COUNT];
+  __m256 nw[Frustum::COUNT];
+  for (usize p = 0; p < Frustum::COUNT; p++) {
+    nx[p] = _mm256_set1_ps(planes[p].x);
+    ny[p] = _mm256_set1_ps(planes[p].y);
+    nz[p] = _mm256_set1_ps(planes[p].z);
+    nw[p] = _mm256_set1_ps(planes[p].w);
+    ax[p] = _mm256_set1_ps(std::abs(planes[p].x));
+    ay[p] = _mm256_set1_ps(std::abs(planes[p].y));
+    az[p] = _mm256_set1_ps(std::abs(planes[p].z));
+  }
+
+  const __m256 zero = _mm256_setzero_ps();
+
+  for (usize i = 0; i < bounds.PaddedSize(); i += BoundsSoA::BATCH) {
+    __m256 cx = _mm256_loadu_ps(bounds.CenterX() + i);
+    __m256 cy = _mm256_loadu_ps(bounds.CenterY() + i);
+    __m256 cz = _mm256_loadu_ps(bounds.CenterZ() + i);
+    __m256 ex = _mm256_loadu_ps(bounds.ExtentX() + i);
+    __m256 ey = _mm256_loadu_ps(bounds.ExtentY() + i);
+    __m256 ez = _mm256_loadu_ps(bounds.ExtentZ() + i);
+
+    __m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+    for (usize p = 0; p < Frustum::COUNT; p++) {
+      __m256 distance = _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(nx[p], cx), _mm256_mul_ps(ny[p], cy)),
+          _mm256_add_ps(_mm256_mul_ps(nz[p], cz), nw[p]));
+      __m256 radius = _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(ax[p], ex), _mm256_mul_ps(ay[p], ey)),
+          _mm256_mul_ps(az[p], ez));
+      inside = _mm256_and_ps(
+          inside,
+          _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+    }
+
+    EmitMask(static_cast<uint32>(_mm256_movemask_ps(inside)), i, bounds.Size(),
+             visible);
+  }
+
+  return visible.size() - before;
+}
+
+const char* FrustumCuller::GetInstructionSet() noexcept {
+  return "AVX";
+}
+
+#elif defined(OVER_CULLING_SSE)
+
+static uint32 CullBatch4(const __m128* nx, const __m128* ny, const __m128* nz,
+                         const __m128* nw, const __m128* ax, const __m128* ay,
+                         const __m128* az, const BoundsSoA& bounds, usize i) {
+  __m128 cx = _mm_loadu_ps(bounds.CenterX() + i);
+  __m128 cy = _mm_loadu_ps(bounds.CenterY() + i);
+  __m128 cz = _mm_loadu_ps(bounds.CenterZ() + i);
+  __m128 ex = _mm_loadu_ps(bounds.ExtentX() + i);
+  __m128 ey = _mm_loadu_ps(bounds.ExtentY() + i);
+  __m128 ez = _mm_loadu_ps(bounds.ExtentZ() + i);
+
+  const __m128 zero = _mm_setzero_ps();
+  __m128 inside = _mm_cmpeq_ps(zero, zero);
+  for (usize p = 0; p < Frustum::COUNT; p++) {
+    __m128 distance =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx), _mm_mul_ps(ny[p], cy)),
+                   _mm_add_ps(_mm_mul_ps(nz[p], cz), nw[p]));
+    __m128 radius =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)),
+                   _mm_mul_ps(az[p], ez));
+    inside =
+        _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+  }
+
+  return static_cast<uint32>(_mm_movemask_ps(inside));
+}
+
+usize FrustumCuller::Cull(const Frustum& frustum, const BoundsSoA& bounds,
+                          std::vector<uint32>& visible) {
+  const auto& planes = frustum.GetPlanes();
+  usize before = visible.size();
+
+  __m128 nx[Frustum::COUNT], ny[Frustum::COUNT], nz[Frustum::COUNT];
+  __m128 ax[Frustum::COUNT], ay[Frustum::COUNT], az[Frustum::COUNT];
+  __m128 nw[Frustum::COUNT];
+  for (usize p = 0; p < Frustum::COUNT; p++) {
+    nx[p] = _mm_set1_ps(planes[p].x);
+    ny[p] = _mm_set1_ps(planes[p].y);
+    nz[p] = _mm_set1_ps(planes[p].z);
+    nw[p] = _mm_set1_ps(planes[p].w);
+    ax[p] = _mm_set1_ps(std::abs(planes[p].x));
+    ay[p] = _mm_set1_ps(std::abs(planes[p].y));
+    az[p] = _mm_set1_ps(std::abs(planes[p].z));
+  }
+
+  for (usize i = 0; i < bounds.PaddedSize(); i += BoundsSoA::BATCH) {
+    uint32 low = CullBatch4(nx, ny, nz, nw, ax, ay, az, bounds, i);
+    uint32 high = CullBatch4(nx, ny, nz, nw, ax, ay, az, bounds, i + 4);
+    EmitMask(low | (high << 4), i, bounds.Size(), visible);
+  }
+
+  return visible.size() - before;
+}
+
+const char* FrustumCuller::GetInstructionSet() noexcept {
+  return "SSE";
+}
+
+#else
+
+usize FrustumCuller::Cull(const Frustum& frustum, const BoundsSoA& bounds,
+                          std::vector<uint32>& visible) {
+  return CullScalar(frustum, bounds, visible);
+}
+
+const char* FrustumCuller::GetInstructionSet() noexcept {
+  return "scalar";
+}
+
+#endif
+
+}  // namespace over::culling
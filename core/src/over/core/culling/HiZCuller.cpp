@@ -0,0 +1,211 @@
+#include <over/core/culling/HiZCuller.hpp>
+
+#include <utility>
+
+#include <over/core/Frustum.hpp>
+#include <over/core/opengl/Barrier.hpp>
+#include <over/core/opengl/Texture.hpp>
+
+namespace over::culling {
+
+constexpr usize PYRAMID_UNIT = 0;
+
+// center.xyz, extents.xyz, std430 vec4 each
+class GPUBounds {
+ public:
+  glm::vec4 center;
+  glm::vec4 extents;
+};
+
+HiZCuller::HiZCuller(std::string pyramidShaderPath, std::string cullShaderPath)
+    : _pyramid(std::move(pyramidShaderPath)),
+      _shader(Shader::FromCompute(std::move(cullShaderPath))),
+      _model(nullptr),
+      _count(0),
+      _commandTemplate(),
+      _bounds(),
+      _visibility(),
+      _instances({}, GL_STATIC_DRAW),
+      _output{InstanceBuffer({}, GL_DYNAMIC_COPY),
+              InstanceBuffer({}, GL_DYNAMIC_COPY)},
+      _commands(),
+      _statisticsBuffers(),
+      _statistics(),
+      _frame(0),
+      _viewProjection(1),
+      _occlusionTest(true) {}
+
+void HiZCuller::SetObjects(Model& model, std::vector<Instance> instances,
+                           const std::vector<AABB>& bounds) {
+  _model = &model;
+  _count = instances.size();
+
+  _commandTemplate.clear();
+  for (const auto& mesh : model.GetMeshes()) {
+    auto command = mesh.GetDrawCommand();
+    command.instanceCount = 0;
+    _commandTemplate.push_back(command);
+  }
+
+  std::vector<GPUBounds> gpuBounds(_count);
+  for (usize i = 0; i < _count && i < bounds.size(); i++) {
+    gpuBounds[i].center = glm::vec4(bounds[i].GetCenter(), 0.f);
+    gpuBounds[i].extents = glm::vec4(bounds[i].GetExtents(), 0.f);
+  }
+
+  auto boundsView = _bounds.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>();
+  boundsView.Bind();
+  boundsView.Reserve(sizeof(GPUBounds) * _count, gpuBounds.data(),
+                     GL_STATIC_DRAW);
+  boundsView.Unbind();
+
+  _instances.GetInstances() = std::move(instances);
+  _instances.ToGPU(true);
+
+  for (auto& output : _output) {
+    output.Reserve(_count);
+  }
+  for (auto& commands : _commands) {
+    auto view = commands.As<gl::BufferTarget::DRAW_INDIRECT_BUFFER>();
+    view.Bind();
+    view.Reserve(sizeof(gl::DrawElementsCommand) * _commandTemplate.size(),
+                 nullptr, GL_DYNAMIC_COPY);
+    view.Unbind();
+  }
+
+  Statistics empty;
+  for (auto& buffer : _statisticsBuffers) {
+    auto view = buffer.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>();
+    view.Bind();
+    view.Reserve(sizeof(Statistics), &empty, GL_DYNAMIC_READ);
+    view.Unbind();
+  }
+  _statistics = empty;
+  _statistics.objects = static_cast<uint32>(_count);
+  _frame = 0;
+
+  ResetVisibility();
+}
+
+void HiZCuller::ResetVisibility() {
+  std::vector<uint32> visibility(_count, 0);
+  auto view = _visibility.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>();
+  view.Bind();
+  view.Reserve(sizeof(uint32) * _count, visibility.data(), GL_DYNAMIC_COPY);
+  view.Unbind();
+}
+
+void HiZCuller::DrawVisible(Shader& shader, const glm::mat4& viewProjection) {
+  if (_model == nullptr || _count == 0) {
+    return;
+  }
+
+  _viewProjection = viewProjection;
+  // before this frame binds the slot, both phases write it
+  ReadStatistics();
+  Cull(VISIBLE);
+  Draw(shader, VISIBLE);
+}
+
+void HiZCuller::DrawRevealed(Shader& shader, gl::Texture2DView depth,
+                             glm::ivec2 size) {
+  if (_model == nullptr || _count == 0) {
+    return;
+  }
+
+  _pyramid.Build(depth, size);
+
+  Cull(REVEALED);
+  Draw(shader, REVEALED);
+
+  _frame++;
+}
+
+void HiZCuller::Cull(Phase phase) {
+  // instance counts start from zero, the cull shader appends
+  auto commands = _commands[phase].As<gl::BufferTarget::DRAW_INDIRECT_BUFFER>();
+  commands.Bind();
+  commands.Write(0, sizeof(gl::DrawElementsCommand) * _commandTemplate.size(),
+                 _commandTemplate.data());
+  commands.Unbind();
+
+  auto frustum = Frustum::FromMatrix(_viewProjection);
+  const auto& planes = frustum.GetPlanes();
+
+  _bounds.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>().BindBase(
+      BOUNDS_BINDING);
+  _instances.BindStorage(INSTANCES_BINDING);
+  _visibility.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>().BindBase(
+      VISIBILITY_BINDING);
+  _output[phase].BindStorage(OUTPUT_BINDING);
+  _commands[phase].As<gl::BufferTarget::SHADER_STORAGE_BUFFER>().BindBase(
+      COMMANDS_BINDING);
+  _statisticsBuffers[_frame % STATISTICS_LATENCY]
+      .As<gl::BufferTarget::SHADER_STORAGE_BUFFER>()
+      .BindBase(STATISTICS_BINDING);
+
+  auto pyramid = _pyramid.GetTexture();
+  if (phase == REVEALED) {
+    gl::Texture::Activate(GL_TEXTURE0 + PYRAMID_UNIT);
+    pyramid.Bind();
+  }
+
+  auto group = _shader.GetWorkGroupSize();
+  _shader.Use([&] {
+    _shader.SetUInt("phase", phase);
+    _shader.SetUInt("count", static_cast<uint32>(_count));
+    _shader.SetUInt("meshCount", static_cast<uint32>(_commandTemplate.size()));
+    _shader.SetMatrix4f("viewProjection", _viewProjection);
+    _shader.SetVec4fv("planes", Frustum::COUNT, &planes[0].x);
+    _shader.SetBool("occlusionTest", _occlusionTest);
+    _shader.SetInt("pyramid", PYRAMID_UNIT);
+    _shader.SetIVec2("pyramidSize", _pyramid.GetSize());
+    _shader.SetInt("pyramidLevels", static_cast<int32>(_pyramid.GetLevels()));
+
+    _shader.Dispatch(
+        static_cast<uint32>((_count + group.x - 1) / group.x));
+  });
+
+  if (phase == REVEALED) {
+    pyramid.Unbind();
+  }
+
+  // draw reads commands and instances written by the dispatch
+  gl::Barrier::Memory(GL_COMMAND_BARRIER_BIT |
+                      GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
+                      GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void HiZCuller::Draw(Shader& shader, Phase phase) {
+  auto commands = _commands[phase].As<gl::BufferTarget::DRAW_INDIRECT_BUFFER>();
+  auto& meshes = _model->GetMeshes();
+
+  commands.Bind();
+  shader.Use([&] {
+    for (usize i = 0; i < meshes.size(); i++) {
+      shader.SetMatrix4f(_model->GetModelUniform(),
+                         _model->GetMeshTransform(i));
+      meshes[i].DrawIndirect(shader, _output[phase],
+                             i * sizeof(gl::DrawElementsCommand));
+    }
+  });
+  commands.Unbind();
+}
+
+void HiZCuller::ReadStatistics() {
+  // the slot of this frame is the oldest one: it was last bound
+  // STATISTICS_LATENCY frames ago and is cleared just before its reuse
+  auto view = _statisticsBuffers[_frame % STATISTICS_LATENCY]
+                  .As<gl::BufferTarget::SHADER_STORAGE_BUFFER>();
+  Statistics empty;
+
+  view.Bind();
+  if (_frame >= STATISTICS_LATENCY) {
+    view.Read(0, sizeof(Statistics), &_statistics);
+    _statistics.objects = static_cast<uint32>(_count);
+  }
+  view.Write(0, sizeof(Statistics), &empty);
+  view.Unbind();
+}
+
+}  // namespace over::culling
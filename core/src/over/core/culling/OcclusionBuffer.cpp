@@ -0,0 +1,537 @@
+#include <over/core/culling/OcclusionBuffer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#if defined(__AVX2__)
+#define OVER_OCCLUSION_AVX2
+#include <immintrin.h>
+#endif
+
+namespace over::culling {
+
+// cleared tiles are farther than any projected depth
+constexpr float32 CLEAR_DEPTH = std::numeric_limits<float32>::max();
+
+#pragma region Occluder
+
+Occluder::Occluder() : vertices(), indices(), bounds() {}
+
+Occluder::Occluder(std::vector<glm::vec3> vertices,
+                   std::vector<uint32> indices)
+    : vertices(std::move(vertices)), indices(std::move(indices)), bounds() {
+  for (const auto& vertex : this->vertices) {
+    bounds.Expand(vertex);
+  }
+}
+
+Occluder Occluder::FromMesh(const Mesh& mesh) {
+  const auto& source = mesh.GetVBO().GetVerticies();
+  const auto& elements = mesh.GetIBO().GetElements();
+
+  std::vector<glm::vec3> vertices;
+  vertices.reserve(source.size());
+  for (const auto& vertex : source) {
+    vertices.push_back(vertex.position);
+  }
+
+  std::vector<uint32> indices;
+  indices.reserve(elements.size() * 3);
+  for (const auto& element : elements) {
+    indices.insert(indices.end(), {element.a, element.b, element.c});
+  }
+
+  return Occluder(std::move(vertices), std::move(indices));
+}
+
+Occluder Occluder::FromBox(const AABB& box) {
+  // corner i takes max on axis k when bit k of i is set
+  std::vector<glm::vec3> vertices;
+  vertices.reserve(8);
+  for (uint32 i = 0; i < 8; i++) {
+    vertices.emplace_back((i & 1) ? box.max.x : box.min.x,
+                          (i & 2) ? box.max.y : box.min.y,
+                          (i & 4) ? box.max.z : box.min.z);
+  }
+
+  std::vector<uint32> indices = {
+      1, 3, 7, 1, 7, 5,  // +x
+      0, 4, 6, 0, 6, 2,  // -x
+      2, 6, 7, 2, 7, 3,  // +y
+      0, 1, 5, 0, 5, 4,  // -y
+      4, 5, 7, 4, 7, 6,  // +z
+      0, 2, 3, 0, 3, 1,  // -z
+  };
+
+  return Occluder(std::move(vertices), std::move(indices));
+}
+
+#pragma endregion
+
+OcclusionBuffer::OcclusionBuffer(uint32 width, uint32 height, usize threads)
+    : _width((width + TILE_WIDTH - 1) / TILE_WIDTH * TILE_WIDTH),
+      _height((height + TILE_HEIGHT - 1) / TILE_HEIGHT * TILE_HEIGHT),
+      _tilesX(_width / TILE_WIDTH),
+      _tilesY(_height / TILE_HEIGHT),
+      _threads(1),
+      _pool(),
+      _backfaceCulling(true),
+      _viewProjection(1),
+      _frustum(),
+      _tiles(static_cast<usize>(_tilesX) * _tilesY,
+             Tile{CLEAR_DEPTH, CLEAR_DEPTH, 0}),
+      _draws(),
+      _triangles() {
+  SetThreads(threads);
+}
+
+void OcclusionBuffer::SetThreads(usize threads) {
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  threads = std::clamp<usize>(threads, 1, _tilesY);
+  if (threads != _threads) {
+    _pool = threads > 1 ? std::make_shared<WorkerPool>(threads - 1) : nullptr;
+  }
+  _threads = threads;
+  _triangles.resize(_threads);
+}
+
+void OcclusionBuffer::Begin(const Camera& camera) {
+  Begin(camera.GetViewProjection());
+}
+
+void OcclusionBuffer::Begin(const glm::mat4& viewProjection) {
+  _viewProjection = viewProjection;
+  _frustum = Frustum::FromMatrix(viewProjection);
+
+  std::fill(_tiles.begin(), _tiles.end(), Tile{CLEAR_DEPTH, CLEAR_DEPTH, 0});
+  _draws.clear();
+  for (auto& triangles : _triangles) {
+    triangles.clear();
+  }
+}
+
+void OcclusionBuffer::Add(const Occluder& occluder, const glm::mat4& model) {
+  if (!_frustum.Intersects(occluder.bounds.Transformed(model))) {
+    return;
+  }
+  _draws.push_back(Draw{&occluder, model});
+}
+
+template <class F>
+void OcclusionBuffer::Parallel(F&& func) {
+  if (!_pool) {
+    func(0);
+    return;
+  }
+  _pool->Run(_threads, func);
+}
+
+void OcclusionBuffer::Render() {
+  // every worker sets up its share of occluders...
+  Parallel([this](usize worker) { Setup(worker); });
+
+  // ...then rasterizes all triangles into its own band of tile rows
+  uint32 rows = static_cast<uint32>((_tilesY + _threads - 1) / _threads);
+  Parallel([this, rows](usize worker) {
+    uint32 first = static_cast<uint32>(worker) * rows;
+    Rasterize(first, std::min(first + rows, _tilesY));
+  });
+}
+
+usize OcclusionBuffer::GetTriangleCount() const noexcept {
+  usize count = 0;
+  for (const auto& triangles : _triangles) {
+    count += triangles.size();
+  }
+  return count;
+}
+
+#pragma region Setup
+
+void OcclusionBuffer::Setup(usize worker) {
+  auto& triangles = _triangles[worker];
+  triangles.clear();
+
+  // contiguous ranges keep draw order, result does not depend on threads
+  usize begin = _draws.size() * worker / _threads;
+  usize end = _draws.size() * (worker + 1) / _threads;
+
+  std::vector<glm::vec4> clip;
+  for (usize i = begin; i < end; i++) {
+    const auto& draw = _draws[i];
+    const auto& occluder = *draw.occluder;
+    glm::mat4 transform = _viewProjection * draw.model;
+
+    clip.resize(occluder.vertices.size());
+    for (usize v = 0; v < clip.size(); v++) {
+      clip[v] = transform * glm::vec4(occluder.vertices[v], 1.f);
+    }
+
+    for (usize t = 0; t + 2 < occluder.indices.size(); t += 3) {
+      SetupTriangle(clip[occluder.indices[t]], clip[occluder.indices[t + 1]],
+                    clip[occluder.indices[t + 2]], triangles);
+    }
+  }
+}
+
+void OcclusionBuffer::SetupTriangle(const glm::vec4& a, const glm::vec4& b,
+                                    const glm::vec4& c,
+                                    std::vector<Triangle>& triangles) const {
+  // all vertices outside of one side plane
+  if ((a.x > a.w && b.x > b.w && c.x > c.w) ||
+      (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+      (a.y > a.w && b.y > b.w && c.y > c.w) ||
+      (a.y < -a.w && b.y < -b.w && c.y < -c.w)) {
+    return;
+  }
+
+  auto project = [this](const glm::vec4& v) {
+    glm::vec3 ndc = glm::vec3(v) / v.w;
+    return glm::vec3((ndc.x * 0.5f + 0.5f) * _width,
+                     (ndc.y * 0.5f + 0.5f) * _height, ndc.z);
+  };
+
+  // signed distance to the near plane (z >= -w)
+  float32 da = a.z + a.w, db = b.z + b.w, dc = c.z + c.w;
+  if (da >= 0.f && db >= 0.f && dc >= 0.f) {
+    EmitTriangle(project(a), project(b), project(c), triangles);
+    return;
+  }
+  if (da < 0.f && db < 0.f && dc < 0.f) {
+    return;
+  }
+
+  // crosses the near plane: clip into a triangle or a quad
+  const glm::vec4* input[3] = {&a, &b, &c};
+  float32 distance[3] = {da, db, dc};
+  glm::vec3 polygon[4];
+  usize size = 0;
+
+  for (usize i = 0; i < 3; i++) {
+    usize j = (i + 1) % 3;
+    if (distance[i] >= 0.f) {
+      polygon[size++] = project(*input[i]);
+    }
+    if ((distance[i] >= 0.f) != (distance[j] >= 0.f)) {
+      float32 t = distance[i] / (distance[i] - distance[j]);
+      polygon[size++] = project(*input[i] + (*input[j] - *input[i]) * t);
+    }
+  }
+
+  for (usize i = 2; i < size; i++) {
+    EmitTriangle(polygon[0], polygon[i - 1], polygon[i], triangles);
+  }
+}
+
+void OcclusionBuffer::EmitTriangle(glm::vec3 a, glm::vec3 b, glm::vec3 c,
+                                   std::vector<Triangle>& triangles) const {
+  float32 area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+  if (area == 0.f) {
+    return;
+  }
+  // counter-clockwise is front facing
+  if (area < 0.f) {
+    if (_backfaceCulling) {
+      return;
+    }
+    std::swap(b, c);
+    area = -area;
+  }
+
+  Triangle triangle;
+  triangle.minX = std::max(std::min({a.x, b.x, c.x}), 0.f);
+  triangle.minY = std::max(std::min({a.y, b.y, c.y}), 0.f);
+  triangle.maxX = std::min(std::max({a.x, b.x, c.x}), float32(_width));
+  triangle.maxY = std::min(std::max({a.y, b.y, c.y}), float32(_height));
+  if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY) {
+    return;
+  }
+
+  // E(p) = A * p.x + B * p.y + C, positive on the left of edge p -> q
+  const glm::vec3* vertices[3] = {&a, &b, &c};
+  for (usize i = 0; i < 3; i++) {
+    const auto& p = *vertices[i];
+    const auto& q = *vertices[(i + 1) % 3];
+    triangle.edgeA[i] = p.y - q.y;
+    triangle.edgeB[i] = q.x - p.x;
+    triangle.edgeC[i] = -(triangle.edgeA[i] * p.x + triangle.edgeB[i] * p.y);
+  }
+
+  triangle.depthA =
+      ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+  triangle.depthB =
+      ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+  triangle.depthC = a.z - triangle.depthA * a.x - triangle.depthB * a.y;
+  triangle.maxDepth = std::max({a.z, b.z, c.z});
+
+  triangles.push_back(triangle);
+}
+
+#pragma endregion
+
+#pragma region Rasterization
+
+void OcclusionBuffer::Rasterize(uint32 firstRow, uint32 lastRow) {
+  if (firstRow >= lastRow) {
+    return;
+  }
+  for (const auto& triangles : _triangles) {
+    for (const auto& triangle : triangles) {
+      RasterizeTriangle(triangle, firstRow, lastRow);
+    }
+  }
+}
+
+void OcclusionBuffer::RasterizeTriangle(const Triangle& triangle,
+                                        uint32 firstRow, uint32 lastRow) {
+  uint32 tileY0 = static_cast<uint32>(triangle.minY) / TILE_HEIGHT;
+  uint32 tileY1 =
+      static_cast<uint32>(std::ceil(triangle.maxY) - 1.f) / TILE_HEIGHT;
+  tileY0 = std::max(tileY0, firstRow);
+  tileY1 = std::min(tileY1, lastRow - 1);
+  if (tileY0 > tileY1) {
+    return;
+  }
+
+  uint32 tileX0 = static_cast<uint32>(triangle.minX) / TILE_WIDTH;
+  uint32 tileX1 = std::min(
+      static_cast<uint32>(std::ceil(triangle.maxX) - 1.f) / TILE_WIDTH,
+      _tilesX - 1);
+
+  for (uint32 ty = tileY0; ty <= tileY1; ty++) {
+    float32 y = static_cast<float32>(ty * TILE_HEIGHT);
+    for (uint32 tx = tileX0; tx <= tileX1; tx++) {
+      float32 x = static_cast<float32>(tx * TILE_WIDTH);
+
+      uint32 coverage = Coverage(triangle, x, y);
+      if (coverage == 0) {
+        continue;
+      }
+
+      // depth plane is linear: farthest point of the covered rectangle is
+      // one of its corners
+      float32 left = std::max(x, triangle.minX);
+      float32 right = std::min(x + TILE_WIDTH, triangle.maxX);
+      float32 bottom = std::max(y, triangle.minY);
+      float32 top = std::min(y + TILE_HEIGHT, triangle.maxY);
+      float32 depth = triangle.depthA * (triangle.depthA > 0.f ? right : left) +
+                      triangle.depthB * (triangle.depthB > 0.f ? top : bottom) +
+                      triangle.depthC;
+
+      UpdateTile(_tiles[ty * _tilesX + tx], coverage,
+                 std::min(depth, triangle.maxDepth));
+    }
+  }
+}
+
+void OcclusionBuffer::UpdateTile(Tile& tile, uint32 coverage,
+                                 float32 depth) noexcept {
+  if (depth >= tile.reference) {
+    return;
+  }
+
+  // working layer is dropped when the triangle is closer to the camera than
+  // the layer is to the reference, merging would lose more than it keeps
+  if (tile.mask != 0 &&
+      tile.layer - depth > tile.reference - tile.layer) {
+    tile.mask = 0;
+  }
+
+  tile.layer = tile.mask != 0 ? std::max(tile.layer, depth) : depth;
+  tile.mask |= coverage;
+
+  if (tile.mask == FULL_MASK) {
+    tile.reference = tile.layer;
+    tile.mask = 0;
+  }
+}
+
+#if defined(OVER_OCCLUSION_AVX2)
+
+// Bit TILE_WIDTH * row + column is set for covered pixel centers
+uint32 OcclusionBuffer::Coverage(const Triangle& triangle, float32 x,
+                                 float32 y) noexcept {
+  const __m256 columns =
+      _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+  const __m256 zero = _mm256_setzero_ps();
+  __m256 px = _mm256_add_ps(_mm256_set1_ps(x), columns);
+
+  __m256 rowStart[3];
+  for (usize e = 0; e < 3; e++) {
+    rowStart[e] =
+        _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(triangle.edgeA[e]), px),
+                      _mm256_set1_ps(triangle.edgeB[e] * (y + 0.5f) +
+                                     triangle.edgeC[e]));
+  }
+
+  uint32 mask = 0;
+  for (uint32 row = 0; row < TILE_HEIGHT; row++) {
+    __m256 inside = _mm256_cmp_ps(rowStart[0], zero, _CMP_GE_OQ);
+    inside = _mm256_and_ps(inside, _mm256_cmp_ps(rowStart[1], zero, _CMP_GE_OQ));
+    inside = _mm256_and_ps(inside, _mm256_cmp_ps(rowStart[2], zero, _CMP_GE_OQ));
+    mask |= static_cast<uint32>(_mm256_movemask_ps(inside))
+            << (row * TILE_WIDTH);
+
+    for (usize e = 0; e < 3; e++) {
+      rowStart[e] =
+          _mm256_add_ps(rowStart[e], _mm256_set1_ps(triangle.edgeB[e]));
+    }
+  }
+
+  return mask;
+}
+
+const char* OcclusionBuffer::GetInstructionSet() noexcept {
+  return "AVX2";
+}
+
+#else
+
+uint32 OcclusionBuffer::Coverage(const Triangle& triangle, float32 x,
+                                 float32 y) noexcept {
+  uint32 mask = 0;
+  for (uint32 row = 0; row < TILE_HEIGHT; row++) {
+    float32 py = y + row + 0.5f;
+    for (uint32 column = 0; column < TILE_WIDTH; column++) {
+      float32 px = x + column + 0.5f;
+
+      bool inside = true;
+      for (usize e = 0; e < 3; e++) {
+        inside &= triangle.edgeA[e] * px + triangle.edgeB[e] * py +
+                      triangle.edgeC[e] >=
+                  0.f;
+      }
+      mask |= static_cast<uint32>(inside) << (row * TILE_WIDTH + column);
+    }
+  }
+  return mask;
+}
+
+const char* OcclusionBuffer::GetInstructionSet() noexcept {
+  return "scalar";
+}
+
+#endif
+
+#pragma endregion
+
+#pragma region Queries
+
+bool OcclusionBuffer::IsVisible(const AABB& box) const noexcept {
+  float32 minX = std::numeric_limits<float32>::max();
+  float32 minY = minX, minZ = minX;
+  float32 maxX = -minX, maxY = -minX;
+
+  // corners are the min corner plus any sum of the three edges
+  const auto& m = _viewProjection;
+  glm::vec3 size = box.max - box.min;
+  float32 origin[4], edges[3][4];
+  for (int32 row = 0; row < 4; row++) {
+    origin[row] = m[0][row] * box.min.x + m[1][row] * box.min.y +
+                  m[2][row] * box.min.z + m[3][row];
+    edges[0][row] = m[0][row] * size.x;
+    edges[1][row] = m[1][row] * size.y;
+    edges[2][row] = m[2][row] * size.z;
+  }
+
+  for (uint32 i = 0; i < 8; i++) {
+    float32 clip[4];
+    for (int32 row = 0; row < 4; row++) {
+      clip[row] = origin[row] + ((i & 1) ? edges[0][row] : 0.f) +
+                  ((i & 2) ? edges[1][row] : 0.f) +
+                  ((i & 4) ? edges[2][row] : 0.f);
+    }
+
+    // crosses the near plane, can not be tested
+    if (clip[2] < -clip[3] || clip[3] <= 0.f) {
+      return true;
+    }
+
+    float32 inverse = 1.f / clip[3];
+    float32 x = (clip[0] * inverse * 0.5f + 0.5f) * _width;
+    float32 y = (clip[1] * inverse * 0.5f + 0.5f) * _height;
+    minX = std::min(minX, x);
+    maxX = std::max(maxX, x);
+    minY = std::min(minY, y);
+    maxY = std::max(maxY, y);
+    minZ = std::min(minZ, clip[2] * inverse);
+  }
+
+  minX = std::max(minX, 0.f);
+  minY = std::max(minY, 0.f);
+  maxX = std::min(maxX, float32(_width));
+  maxY = std::min(maxY, float32(_height));
+  // off screen
+  if (minX >= maxX || minY >= maxY) {
+    return false;
+  }
+
+  uint32 tileX0 = static_cast<uint32>(minX) / TILE_WIDTH;
+  uint32 tileY0 = static_cast<uint32>(minY) / TILE_HEIGHT;
+  uint32 tileX1 = std::min(static_cast<uint32>(maxX) / TILE_WIDTH, _tilesX - 1);
+  uint32 tileY1 =
+      std::min(static_cast<uint32>(maxY) / TILE_HEIGHT, _tilesY - 1);
+
+  for (uint32 ty = tileY0; ty <= tileY1; ty++) {
+    for (uint32 tx = tileX0; tx <= tileX1; tx++) {
+      if (minZ <= _tiles[ty * _tilesX + tx].reference) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+usize OcclusionBuffer::Cull(const std::vector<AABB>& boxes,
+                            const std::vector<uint32>& candidates,
+                            std::vector<uint32>& visible) const {
+  usize before = visible.size();
+  usize threads = std::min(_threads, candidates.size() / PARALLEL_THRESHOLD);
+
+  if (threads <= 1) {
+    for (auto index : candidates) {
+      if (IsVisible(boxes[index])) {
+        visible.push_back(index);
+      }
+    }
+    return visible.size() - before;
+  }
+
+  // candidate order is kept: every worker fills its own list
+  std::vector<std::vector<uint32>> results(threads);
+  _pool->Run(threads, [&](usize worker) {
+    usize begin = candidates.size() * worker / threads;
+    usize end = candidates.size() * (worker + 1) / threads;
+    for (usize i = begin; i < end; i++) {
+      if (IsVisible(boxes[candidates[i]])) {
+        results[worker].push_back(candidates[i]);
+      }
+    }
+  });
+
+  for (const auto& result : results) {
+    visible.insert(visible.end(), result.begin(), result.end());
+  }
+  return visible.size() - before;
+}
+
+std::vector<float32> OcclusionBuffer::GetDepth() const {
+  std::vector<float32> depth(static_cast<usize>(_width) * _height);
+  for (uint32 y = 0; y < _height; y++) {
+    for (uint32 x = 0; x < _width; x++) {
+      const auto& tile = _tiles[(y / TILE_HEIGHT) * _tilesX + x / TILE_WIDTH];
+      depth[y * _width + x] = std::min(tile.reference, 1.f);
+    }
+  }
+  return depth;
+}
+
+#pragma endregion
+
+}  // namespace over::culling
@@ -0,0 +1,117 @@
+#include <over/core/graph/DynamicResolution.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <over/core/graph/RenderTargetPool.hpp>
+#include <over/core/opengl/TimerQuery.hpp>
+
+namespace over::graph {
+
+static_assert(DynamicResolution::SETTLE_FRAMES >=
+                  RenderTargetPool::RESIZE_FRAMES + gl::TimerQuery::LATENCY,
+              "a settled sample must measure the new extent");
+
+// bound of the integral term, a long stay at a scale limit does not wind
+// it up
+constexpr float64 INTEGRAL_LIMIT = 2.0;
+// largest relative frame time change asked at once
+constexpr float64 MAX_CHANGE = 0.5;
+
+DynamicResolution::DynamicResolution(float64 targetMilliseconds,
+                                     float32 minScale, float32 maxScale)
+    : _target(targetMilliseconds),
+      _minScale(minScale),
+      _maxScale(maxScale),
+      _step(1.f / 32.f),
+      _interval(16),
+      _proportional(0.6),
+      _integral(0.1),
+      _derivative(0.2),
+      _scale(maxScale),
+      _sum(0),
+      _samples(0),
+      _settle(0),
+      _average(0),
+      _accumulated(0),
+      _lastError(0),
+      _first(true) {}
+
+bool DynamicResolution::Update(float64 milliseconds) {
+  if (milliseconds <= 0.0) {
+    return false;
+  }
+  if (_settle > 0) {
+    _settle--;
+    return false;
+  }
+
+  _sum += milliseconds;
+  if (++_samples < _interval) {
+    return false;
+  }
+
+  _average = _sum / static_cast<float64>(_samples);
+  _sum = 0;
+  _samples = 0;
+
+  // > 0 - headroom, < 0 - over budget
+  float64 error = (_target - _average) / _target;
+  float64 derivative = _first ? 0.0 : error - _lastError;
+  _lastError = error;
+  _first = false;
+
+  float64 accumulated =
+      std::clamp(_accumulated + error, -INTEGRAL_LIMIT, INTEGRAL_LIMIT);
+  float64 change = _proportional * error + _integral * accumulated +
+                   _derivative * derivative;
+  change = std::clamp(change, -MAX_CHANGE, MAX_CHANGE);
+
+  float64 desired = _scale * std::sqrt(1.0 + change);
+  float32 scale = std::round(static_cast<float32>(desired) / _step) * _step;
+  scale = std::clamp(scale, _minScale, _maxScale);
+
+  // integrate only while the scale can still follow
+  bool saturated = (scale >= _maxScale && error > 0.0) ||
+                   (scale <= _minScale && error < 0.0);
+  if (!saturated) {
+    _accumulated = accumulated;
+  }
+
+  if (scale == _scale) {
+    return false;
+  }
+  _scale = scale;
+  _settle = SETTLE_FRAMES;
+  return true;
+}
+
+void DynamicResolution::Reset() noexcept {
+  _scale = _maxScale;
+  _sum = 0;
+  _samples = 0;
+  _settle = 0;
+  _average = 0;
+  _accumulated = 0;
+  _lastError = 0;
+  _first = true;
+}
+
+void DynamicResolution::SetTarget(float64 milliseconds) noexcept {
+  _target = std::max(milliseconds, 0.1);
+}
+
+void DynamicResolution::SetRange(float32 minScale, float32 maxScale) noexcept {
+  _minScale = std::min(minScale, maxScale);
+  _maxScale = maxScale;
+  _scale = std::clamp(_scale, _minScale, _maxScale);
+}
+
+void DynamicResolution::SetGains(float64 proportional, float64 integral,
+                                 float64 derivative) noexcept {
+  _proportional = proportional;
+  _integral = integral;
+  _derivative = derivative;
+}
+
+}  // namespace over::graph
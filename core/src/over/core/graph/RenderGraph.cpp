@@ -0,0 +1,597 @@
+#include <over/core/graph/RenderGraph.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <over/core/opengl/Barrier.hpp>
+#include <over/core/opengl/DefaultFrameBuffer.hpp>
+#include <over/core/opengl/RenderStats.hpp>
+#include <over/core/profiling/Profiler.hpp>
+
+#include <fmt/core.h>
+
+namespace over::graph {
+
+namespace {
+// Attachment point and blit mask of a format
+GLenum GetAttachment(GLenum format) {
+  if (IsStencilFormat(format)) {
+    return GL_DEPTH_STENCIL_ATTACHMENT;
+  }
+  return IsDepthFormat(format) ? GL_DEPTH_ATTACHMENT : GL_COLOR_ATTACHMENT0;
+}
+
+GLbitfield GetMask(GLenum format) {
+  if (IsStencilFormat(format)) {
+    return GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+  }
+  return IsDepthFormat(format) ? GL_DEPTH_BUFFER_BIT : GL_COLOR_BUFFER_BIT;
+}
+
+// Multisampled reads go through a resolved copy
+bool NeedsResolve(const TextureDesc& desc) {
+  return desc.samples > 0 || desc.renderBuffer;
+}
+
+std::string GetAttachmentName(GLenum attachment) {
+  switch (attachment) {
+    case GL_DEPTH_ATTACHMENT:
+      return "depth";
+    case GL_STENCIL_ATTACHMENT:
+      return "stencil";
+    case GL_DEPTH_STENCIL_ATTACHMENT:
+      return "depth_stencil";
+    default:
+      return fmt::format("color{}", attachment - GL_COLOR_ATTACHMENT0);
+  }
+}
+}  // namespace
+
+#pragma region PassBuilder
+
+void PassBuilder::Read(Resource resource) {
+  auto& node = _graph.GetNode(resource);
+  auto& pass = _graph._passes[_pass];
+
+  // sampling an attachment of the same pass is a feedback loop
+  bool attached = std::any_of(
+      pass.attachments.begin(), pass.attachments.end(),
+      [&](const auto& attachment) { return attachment.first == resource; });
+  if (attached && !NeedsResolve(node.desc)) {
+    throw std::runtime_error(fmt::format(
+        "Pass {} reads and renders to {}", pass.name, node.name));
+  }
+
+  pass.reads.push_back(resource);
+}
+
+void PassBuilder::Write(Resource resource, GLenum attachment) {
+  auto& node = _graph.GetNode(resource);
+  auto& pass = _graph._passes[_pass];
+
+  if (node.kind == RenderGraph::Kind::BACK_BUFFER) {
+    pass.backBuffer = true;
+    pass.sideEffect = true;
+    pass.writes.push_back(resource);
+    return;
+  }
+
+  bool read = std::find(pass.reads.begin(), pass.reads.end(), resource) !=
+              pass.reads.end();
+  if (read && !NeedsResolve(node.desc)) {
+    throw std::runtime_error(fmt::format(
+        "Pass {} reads and renders to {}", pass.name, node.name));
+  }
+
+  pass.attachments.emplace_back(resource, attachment);
+}
+
+void PassBuilder::Write(Resource resource) {
+  auto& node = _graph.GetNode(resource);
+  auto& pass = _graph._passes[_pass];
+
+  if (node.kind == RenderGraph::Kind::BACK_BUFFER) {
+    pass.backBuffer = true;
+    pass.sideEffect = true;
+  }
+  pass.writes.push_back(resource);
+}
+
+void PassBuilder::WriteImage(Resource resource) {
+  _graph.GetNode(resource);
+  _graph._passes[_pass].imageWrites.push_back(resource);
+}
+
+void PassBuilder::SetSideEffect() { _graph._passes[_pass].sideEffect = true; }
+
+#pragma endregion
+
+gl::Texture2DView PassContext::GetTexture(Resource resource) const {
+  return _graph.GetTexture(resource);
+}
+
+RenderGraph::RenderGraph()
+    : _width(0),
+      _height(0),
+      _backBufferWidth(0),
+      _backBufferHeight(0),
+      _passes(),
+      _resources(),
+      _pool(),
+      _targets(),
+      _released(true),
+      _resolveRead(),
+      _resolveDraw(),
+      _compiled(false),
+      _culled(0),
+      _transient(0) {}
+
+void RenderGraph::Reset(uint32 width, uint32 height, float32 scale) {
+  ReleaseTargets();
+  _targets.clear();
+
+  auto scaled = [scale](uint32 size) {
+    return size == 0 ? 0u
+                     : std::max(1u, static_cast<uint32>(
+                                        std::lround(size * scale)));
+  };
+
+  _pool.NextFrame();
+  _pool.Resize(scaled(width), scaled(height));
+
+  _width = _pool.GetWidth();
+  _height = _pool.GetHeight();
+  _backBufferWidth = width;
+  _backBufferHeight = height;
+
+  _passes.clear();
+  _resources.clear();
+
+  _compiled = false;
+  _culled = 0;
+  _transient = 0;
+}
+
+Resource RenderGraph::Create(std::string name, const TextureDesc& desc) {
+  ResourceNode node;
+  node.name = std::move(name);
+  node.desc = desc;
+  node.kind = Kind::TRANSIENT;
+  node.width = std::max(
+      static_cast<uint32>(std::lround(_width * desc.scale)), uint32(1));
+  node.height = std::max(
+      static_cast<uint32>(std::lround(_height * desc.scale)), uint32(1));
+
+  _compiled = false;
+  _resources.push_back(std::move(node));
+  return static_cast<Resource>(_resources.size() - 1);
+}
+
+Resource RenderGraph::Import(std::string name, gl::Texture2DView texture,
+                             uint32 width, uint32 height) {
+  ResourceNode node;
+  node.name = std::move(name);
+  node.kind = Kind::IMPORTED;
+  node.texture = texture;
+  node.width = width;
+  node.height = height;
+
+  _compiled = false;
+  _resources.push_back(std::move(node));
+  return static_cast<Resource>(_resources.size() - 1);
+}
+
+Resource RenderGraph::ImportBackBuffer(std::string name) {
+  ResourceNode node;
+  node.name = std::move(name);
+  node.kind = Kind::BACK_BUFFER;
+  node.width = _backBufferWidth;
+  node.height = _backBufferHeight;
+
+  _compiled = false;
+  _resources.push_back(std::move(node));
+  return static_cast<Resource>(_resources.size() - 1);
+}
+
+uint32 RenderGraph::BeginPass(std::string name,
+                              std::unique_ptr<PassBase> execute) {
+  PassNode pass;
+  pass.name = std::move(name);
+  pass.execute = std::move(execute);
+
+  _compiled = false;
+  _passes.push_back(std::move(pass));
+  return static_cast<uint32>(_passes.size() - 1);
+}
+
+RenderGraph::ResourceNode& RenderGraph::GetNode(Resource resource) {
+  if (resource >= _resources.size()) {
+    throw std::runtime_error(
+        fmt::format("Render graph resource {} does not exist", resource));
+  }
+  return _resources[resource];
+}
+
+void RenderGraph::Compile() {
+  OVER_PROFILE_ZONE("graph compile");
+  Cull();
+  ComputeLifetimes();
+  Allocate();
+  _compiled = true;
+}
+
+void RenderGraph::Cull() {
+  // Backwards: a pass is live if it has side effects or writes something a
+  // later live pass reads. Earlier writers of a needed resource stay live,
+  // passes only add to what they write
+  std::vector<bool> needed(_resources.size(), false);
+
+  _culled = 0;
+  for (usize i = _passes.size(); i-- > 0;) {
+    auto& pass = _passes[i];
+
+    bool live = pass.sideEffect;
+    for (const auto& [resource, attachment] : pass.attachments) {
+      live = live || needed[resource];
+    }
+    for (auto resource : pass.writes) {
+      live = live || needed[resource];
+    }
+    for (auto resource : pass.imageWrites) {
+      live = live || needed[resource];
+    }
+
+    pass.culled = !live;
+    if (!live) {
+      _culled++;
+      continue;
+    }
+
+    for (auto resource : pass.reads) {
+      needed[resource] = true;
+    }
+  }
+}
+
+void RenderGraph::ComputeLifetimes() {
+  auto touch = [&](Resource resource, uint32 pass) {
+    auto& node = _resources[resource];
+    node.first = std::min(node.first, pass);
+    node.last = std::max(node.last, pass);
+    node.used = true;
+  };
+
+  for (auto& node : _resources) {
+    node.first = ~0u;
+    node.last = 0;
+    node.used = false;
+    node.physical = ~0u;
+  }
+
+  for (uint32 i = 0; i < _passes.size(); i++) {
+    auto& pass = _passes[i];
+    if (pass.culled) {
+      continue;
+    }
+
+    for (const auto& [resource, attachment] : pass.attachments) {
+      touch(resource, i);
+    }
+    for (auto resource : pass.writes) {
+      touch(resource, i);
+    }
+    for (auto resource : pass.imageWrites) {
+      touch(resource, i);
+    }
+
+    // the source stays alive up to the resolve, the copy up to its readers
+    for (auto resource : pass.reads) {
+      touch(resource, i);
+      if (_resources[resource].kind != Kind::TRANSIENT ||
+          !NeedsResolve(_resources[resource].desc)) {
+        continue;
+      }
+
+      if (_resources[resource].resolve == INVALID_RESOURCE) {
+        const auto& source = _resources[resource];
+
+        ResourceNode node;
+        node.name = source.name + " (resolved)";
+        node.desc = source.desc;
+        node.desc.samples = 0;
+        node.desc.renderBuffer = false;
+        node.width = source.width;
+        node.height = source.height;
+        node.source = resource;
+
+        _resources.push_back(std::move(node));
+        _resources[resource].resolve =
+            static_cast<Resource>(_resources.size() - 1);
+      }
+      touch(_resources[resource].resolve, i);
+    }
+  }
+}
+
+void RenderGraph::Allocate() {
+  // recompiling the same frame
+  ReleaseTargets();
+  _targets.clear();
+
+  std::vector<Resource> order;
+  for (Resource i = 0; i < _resources.size(); i++) {
+    if (_resources[i].used && _resources[i].kind == Kind::TRANSIENT) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](Resource a, Resource b) {
+    return _resources[a].first < _resources[b].first;
+  });
+
+  // First fit: same desc, previous holder already dead
+  for (auto resource : order) {
+    auto& node = _resources[resource];
+
+    RenderTargetDesc desc;
+    desc.format = node.desc.format;
+    desc.width = node.width;
+    desc.height = node.height;
+    desc.samples = node.desc.samples;
+    desc.renderBuffer = node.desc.renderBuffer;
+
+    usize index = 0;
+    for (; index < _targets.size(); index++) {
+      const auto& target = _targets[index];
+      if (target.busyUntil < node.first &&
+          _pool.GetDesc(target.target) == desc) {
+        break;
+      }
+    }
+
+    if (index == _targets.size()) {
+      Target target;
+      target.target = _pool.Acquire(desc);
+      _targets.push_back(target);
+    }
+
+    _targets[index].busyUntil = node.last;
+    node.physical = static_cast<uint32>(index);
+  }
+
+  _released = false;
+  _transient = order.size();
+}
+
+void RenderGraph::ReleaseTargets() {
+  if (_released) {
+    return;
+  }
+
+  for (const auto& target : _targets) {
+    _pool.Release(target.target);
+  }
+  _released = true;
+}
+
+void RenderGraph::Execute() {
+  if (!_compiled) {
+    Compile();
+  }
+
+  for (auto& pass : _passes) {
+    if (pass.culled) {
+      continue;
+    }
+
+    // resolves and barriers count towards the pass
+    OVER_PROFILE_DYNAMIC_ZONE(pass.name);
+    OVER_PROFILE_DYNAMIC_GPU_ZONE(pass.name);
+    OVER_RENDER_STATS_PASS(pass.name);
+
+    // image stores are not ordered with later fetches or attachments
+    bool barrier = false;
+    auto consume = [&](Resource resource) {
+      barrier = barrier || _resources[resource].imageWritten;
+      _resources[resource].imageWritten = false;
+    };
+
+    for (auto resource : pass.reads) {
+      consume(resource);
+      auto& node = _resources[resource];
+      if (node.resolve != INVALID_RESOURCE && node.dirty) {
+        Resolve(resource);
+      }
+    }
+    for (const auto& [resource, attachment] : pass.attachments) {
+      consume(resource);
+    }
+
+    if (barrier) {
+      gl::Barrier::Memory(GL_TEXTURE_FETCH_BARRIER_BIT |
+                          GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
+                          GL_FRAMEBUFFER_BARRIER_BIT);
+    }
+
+    uint32 width = _backBufferWidth;
+    uint32 height = _backBufferHeight;
+    if (!pass.backBuffer && !pass.attachments.empty()) {
+      const auto& node = _resources[pass.attachments.front().first];
+      width = node.width;
+      height = node.height;
+
+      std::vector<Attachment> attachments;
+      for (const auto& [resource, point] : pass.attachments) {
+        const auto& node = _resources[resource];
+
+        Attachment attachment;
+        attachment.point = point;
+        if (node.kind == Kind::IMPORTED) {
+          attachment.texture = node.texture;
+        } else {
+          attachment.target = _targets[node.physical].target;
+        }
+        attachments.push_back(attachment);
+      }
+      _pool.GetFrameBuffer(attachments).Bind();
+    } else {
+      // back buffer, or passes binding their own frame buffer
+      glthrow(glBindFramebuffer(GL_FRAMEBUFFER, gl::GetDefaultFrameBuffer()));
+      OVER_RENDER_STAT(frameBufferBinds, 1);
+    }
+    glthrow(glViewport(0, 0, static_cast<GLsizei>(width),
+                       static_cast<GLsizei>(height)));
+
+    PassContext context(*this, width, height);
+    pass.execute->Execute(context);
+
+    for (const auto& [resource, attachment] : pass.attachments) {
+      _resources[resource].dirty = true;
+    }
+    for (auto resource : pass.writes) {
+      _resources[resource].dirty = true;
+    }
+    for (auto resource : pass.imageWrites) {
+      _resources[resource].dirty = true;
+      _resources[resource].imageWritten = true;
+    }
+  }
+
+  glthrow(glBindFramebuffer(GL_FRAMEBUFFER, gl::GetDefaultFrameBuffer()));
+  OVER_RENDER_STAT(frameBufferBinds, 1);
+  glthrow(glViewport(0, 0, static_cast<GLsizei>(_backBufferWidth),
+                     static_cast<GLsizei>(_backBufferHeight)));
+
+  // free for other pool users until the next frame
+  ReleaseTargets();
+}
+
+void RenderGraph::Resolve(Resource resource) {
+  auto& source = _resources[resource];
+  auto& target = _resources[source.resolve];
+  auto from = _targets[source.physical].target;
+  auto to = _targets[target.physical].target;
+
+  GLenum attachment = GetAttachment(source.desc.format);
+
+  auto read = _resolveRead.As<gl::FrameBufferTarget::READ_FRAMEBUFFER>();
+  auto draw = _resolveDraw.As<gl::FrameBufferTarget::DRAW_FRAMEBUFFER>();
+
+  read.Bind();
+  if (source.desc.renderBuffer) {
+    read.Attach(attachment, _pool.GetRenderBuffer(from));
+  } else {
+    read.Attach(attachment, _pool.GetMultisampleTexture(from), 0);
+  }
+  read.SetReadBuffer(attachment == GL_COLOR_ATTACHMENT0 ? attachment
+                                                        : GL_NONE);
+
+  draw.Bind();
+  draw.Attach(attachment, _pool.GetTexture(to), 0);
+  if (attachment == GL_COLOR_ATTACHMENT0) {
+    draw.SetDrawBuffers(1);
+  } else {
+    draw.SetDrawBuffers({GL_NONE});
+  }
+
+  auto width = static_cast<GLint>(source.width);
+  auto height = static_cast<GLint>(source.height);
+  glthrow(glBlitFramebuffer(0, 0, width, height, 0, 0, width, height,
+                            GetMask(source.desc.format), GL_NEAREST));
+
+  // the next resolve may use another attachment point
+  read.Attach(attachment, gl::Texture2DView(), 0);
+  draw.Attach(attachment, gl::Texture2DView(), 0);
+  draw.Unbind();
+  read.Unbind();
+
+  source.dirty = false;
+}
+
+gl::Texture2DView RenderGraph::GetTexture(Resource resource) {
+  const auto* node = &GetNode(resource);
+  if (node->kind == Kind::IMPORTED) {
+    return node->texture;
+  }
+  if (node->resolve != INVALID_RESOURCE) {
+    node = &_resources[node->resolve];
+  }
+
+  if (node->kind != Kind::TRANSIENT || node->physical == ~0u ||
+      NeedsResolve(node->desc)) {
+    throw std::runtime_error(
+        fmt::format("{} is not a texture read by the pass", node->name));
+  }
+  return _pool.GetTexture(_targets[node->physical].target);
+}
+
+std::string RenderGraph::ExportDot() const {
+  std::string dot = "digraph RenderGraph {\n";
+  dot += "  rankdir=LR;\n";
+  dot += "  node [fontname=\"Helvetica\", fontsize=10];\n";
+
+  for (usize i = 0; i < _passes.size(); i++) {
+    const auto& pass = _passes[i];
+    dot += fmt::format(
+        "  p{} [shape=box, style=\"{}\", fillcolor=\"#ffd27f\", "
+        "label=\"{}\"];\n",
+        i, pass.culled ? "dashed" : "filled", pass.name);
+  }
+
+  for (usize i = 0; i < _resources.size(); i++) {
+    const auto& node = _resources[i];
+
+    std::string label;
+    switch (node.kind) {
+      case Kind::TRANSIENT:
+        label = fmt::format("{}\\n{}x{} 0x{:04X}", node.name, node.width,
+                            node.height, node.desc.format);
+        if (node.desc.samples > 0) {
+          label += fmt::format(" x{}", node.desc.samples);
+        }
+        if (node.physical != ~0u) {
+          label += fmt::format("\\ntarget {}", _targets[node.physical].target);
+        }
+        break;
+      case Kind::IMPORTED:
+        label = fmt::format("{}\\nimported", node.name);
+        break;
+      case Kind::BACK_BUFFER:
+        label = node.name;
+        break;
+    }
+
+    dot += fmt::format("  r{} [shape=ellipse, style=\"{}\", label=\"{}\"];\n",
+                       i, node.used ? "solid" : "dotted", label);
+
+    if (node.source != INVALID_RESOURCE) {
+      dot += fmt::format("  r{} -> r{} [label=\"resolve\"];\n", node.source,
+                         i);
+    }
+  }
+
+  for (usize i = 0; i < _passes.size(); i++) {
+    const auto& pass = _passes[i];
+
+    for (auto resource : pass.reads) {
+      const auto& node = _resources[resource];
+      auto from = node.resolve != INVALID_RESOURCE ? node.resolve : resource;
+      dot += fmt::format("  r{} -> p{};\n", from, i);
+    }
+    for (const auto& [resource, attachment] : pass.attachments) {
+      dot += fmt::format("  p{} -> r{} [label=\"{}\"];\n", i, resource,
+                         GetAttachmentName(attachment));
+    }
+    for (auto resource : pass.writes) {
+      dot += fmt::format("  p{} -> r{};\n", i, resource);
+    }
+    for (auto resource : pass.imageWrites) {
+      dot += fmt::format("  p{} -> r{} [label=\"image\"];\n", i, resource);
+    }
+  }
+
+  dot += "}\n";
+  return dot;
+}
+
+}  // namespace over::graph
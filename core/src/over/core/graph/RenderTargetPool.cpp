@@ -0,0 +1,356 @@
+#include <over/core/graph/RenderTargetPool.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+namespace over::graph {
+
+bool IsDepthFormat(GLenum format) noexcept {
+  switch (format) {
+    case GL_DEPTH_COMPONENT:
+    case GL_DEPTH_COMPONENT16:
+    case GL_DEPTH_COMPONENT24:
+    case GL_DEPTH_COMPONENT32:
+    case GL_DEPTH_COMPONENT32F:
+    case GL_DEPTH_STENCIL:
+    case GL_DEPTH24_STENCIL8:
+    case GL_DEPTH32F_STENCIL8:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsStencilFormat(GLenum format) noexcept {
+  return format == GL_DEPTH_STENCIL || format == GL_DEPTH24_STENCIL8 ||
+         format == GL_DEPTH32F_STENCIL8;
+}
+
+usize GetFormatSize(GLenum format) noexcept {
+  switch (format) {
+    case GL_R8:
+      return 1;
+    case GL_RG8:
+    case GL_R16F:
+    case GL_DEPTH_COMPONENT16:
+      return 2;
+    case GL_RGB8:
+    case GL_DEPTH_COMPONENT24:
+      return 3;
+    case GL_RGBA16F:
+    case GL_RG32F:
+    case GL_DEPTH32F_STENCIL8:
+      return 8;
+    case GL_RGB16F:
+      return 6;
+    case GL_RGB32F:
+      return 12;
+    case GL_RGBA32F:
+      return 16;
+    default:
+      // RGBA8, R11F_G11F_B10F, RGB10_A2, R32F, DEPTH24_STENCIL8, ...
+      return 4;
+  }
+}
+
+RenderTargetPool::RenderTargetPool(usize idleFrames)
+    : _idleFrames(idleFrames),
+      _frame(0),
+      _width(0),
+      _height(0),
+      _pendingWidth(0),
+      _pendingHeight(0),
+      _pendingFrames(0),
+      _slots(),
+      _frameBuffers(),
+      _alive(0),
+      _allocations(0) {}
+
+bool RenderTargetPool::Resize(uint32 width, uint32 height) {
+  if (width == _width && height == _height) {
+    _pendingFrames = 0;
+    return false;
+  }
+
+  // nothing allocated yet, or a minimized window coming back
+  if (_width == 0 || _height == 0) {
+    _width = width;
+    _height = height;
+    _pendingFrames = 0;
+    return true;
+  }
+
+  // any request other than the extent counts, a drag keeps moving
+  if (width != _pendingWidth || height != _pendingHeight) {
+    _pendingWidth = width;
+    _pendingHeight = height;
+  }
+  if (++_pendingFrames < RESIZE_FRAMES) {
+    return false;
+  }
+
+  _width = width;
+  _height = height;
+  _pendingFrames = 0;
+  return true;
+}
+
+RenderTarget RenderTargetPool::Acquire(const RenderTargetDesc& desc) {
+  if (desc.width == 0 || desc.height == 0) {
+    throw std::runtime_error("Render target must not be empty");
+  }
+
+  usize dead = _slots.size();
+  for (usize i = 0; i < _slots.size(); i++) {
+    auto& slot = _slots[i];
+    if (slot.alive && slot.free && slot.desc == desc) {
+      slot.free = false;
+      return static_cast<RenderTarget>(i);
+    }
+    if (!slot.alive && dead == _slots.size()) {
+      dead = i;
+    }
+  }
+
+  if (dead == _slots.size()) {
+    _slots.emplace_back();
+  }
+
+  auto& slot = _slots[dead];
+  slot.desc = desc;
+  slot.alive = true;
+  slot.free = false;
+  Allocate(slot);
+
+  _alive++;
+  _allocations++;
+  return static_cast<RenderTarget>(dead);
+}
+
+void RenderTargetPool::Release(RenderTarget target) {
+  auto& slot = GetSlot(target);
+  slot.free = true;
+  slot.releasedFrame = _frame;
+}
+
+const RenderTargetDesc& RenderTargetPool::GetDesc(RenderTarget target) const {
+  return GetSlot(target).desc;
+}
+
+gl::Texture2DView RenderTargetPool::GetTexture(RenderTarget target) {
+  auto& slot = GetSlot(target);
+  if (slot.desc.renderBuffer || slot.desc.samples > 0) {
+    throw std::runtime_error("Render target is not a 2D texture");
+  }
+  return slot.texture.As<gl::TextureTarget::TEXTURE_2D>();
+}
+
+gl::TextureView<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE>
+RenderTargetPool::GetMultisampleTexture(RenderTarget target) {
+  auto& slot = GetSlot(target);
+  if (slot.desc.renderBuffer || slot.desc.samples == 0) {
+    throw std::runtime_error("Render target is not a multisampled texture");
+  }
+  return slot.texture.As<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE>();
+}
+
+gl::RenderBufferView<gl::RenderBufferTarget::RENDER_BUFFER>
+RenderTargetPool::GetRenderBuffer(RenderTarget target) {
+  auto& slot = GetSlot(target);
+  if (!slot.desc.renderBuffer) {
+    throw std::runtime_error("Render target is not a render buffer");
+  }
+  return slot.renderBuffer.As<gl::RenderBufferTarget::RENDER_BUFFER>();
+}
+
+gl::FrameBufferView<gl::FrameBufferTarget::FRAMEBUFFER>
+RenderTargetPool::GetFrameBuffer(const std::vector<Attachment>& attachments) {
+  std::vector<std::pair<GLenum, uint64>> key;
+  key.reserve(attachments.size());
+  for (const auto& attachment : attachments) {
+    key.emplace_back(attachment.point,
+                     attachment.target == INVALID_TARGET
+                         ? uint64(*attachment.texture.Get())
+                         : GetKey(GetSlot(attachment.target)));
+  }
+  std::sort(key.begin(), key.end());
+
+  for (auto& frameBuffer : _frameBuffers) {
+    if (frameBuffer.key == key) {
+      frameBuffer.usedFrame = _frame;
+      return frameBuffer.frame.As<gl::FrameBufferTarget::FRAMEBUFFER>();
+    }
+  }
+
+  FrameBuffer frameBuffer;
+  frameBuffer.key = std::move(key);
+  frameBuffer.usedFrame = _frame;
+
+  auto frame = frameBuffer.frame.As<gl::FrameBufferTarget::FRAMEBUFFER>();
+  frame.Bind();
+
+  usize colors = 0;
+  for (const auto& attachment : attachments) {
+    if (attachment.target == INVALID_TARGET) {
+      frame.Attach(attachment.point, attachment.texture, 0);
+    } else {
+      const auto& desc = GetSlot(attachment.target).desc;
+      if (desc.renderBuffer) {
+        frame.Attach(attachment.point, GetRenderBuffer(attachment.target));
+      } else if (desc.samples > 0) {
+        frame.Attach(attachment.point, GetMultisampleTexture(attachment.target),
+                     0);
+      } else {
+        frame.Attach(attachment.point, GetTexture(attachment.target), 0);
+      }
+    }
+
+    if (attachment.point >= GL_COLOR_ATTACHMENT0 &&
+        attachment.point < GL_COLOR_ATTACHMENT0 + frame.MAX_DRAW_BUFFERS) {
+      colors =
+          std::max<usize>(colors, attachment.point - GL_COLOR_ATTACHMENT0 + 1);
+    }
+  }
+
+  if (colors == 0) {
+    frame.SetDrawBuffers({GL_NONE});
+    frame.SetReadBuffer(GL_NONE);
+  } else {
+    frame.SetDrawBuffers(colors);
+  }
+
+  frame.ReadyOrThrow("Cannot create pooled frame buffer");
+  frame.Unbind();
+
+  _frameBuffers.push_back(std::move(frameBuffer));
+  return frame;
+}
+
+void RenderTargetPool::NextFrame() {
+  _frame++;
+
+  for (auto& slot : _slots) {
+    if (slot.alive && slot.free && _frame - slot.releasedFrame > _idleFrames) {
+      Free(slot);
+    }
+  }
+
+  _frameBuffers.erase(
+      std::remove_if(_frameBuffers.begin(), _frameBuffers.end(),
+                     [&](const FrameBuffer& frameBuffer) {
+                       return _frame - frameBuffer.usedFrame > _idleFrames;
+                     }),
+      _frameBuffers.end());
+}
+
+usize RenderTargetPool::GetFreeCount() const noexcept {
+  return static_cast<usize>(
+      std::count_if(_slots.begin(), _slots.end(),
+                    [](const Slot& slot) { return slot.alive && slot.free; }));
+}
+
+usize RenderTargetPool::GetMemory() const noexcept {
+  usize bytes = 0;
+  for (const auto& slot : _slots) {
+    if (slot.alive) {
+      const auto& desc = slot.desc;
+      bytes += usize(desc.width) * desc.height * GetFormatSize(desc.format) *
+               std::max(desc.samples, 1u);
+    }
+  }
+  return bytes;
+}
+
+RenderTargetPool::Slot& RenderTargetPool::GetSlot(RenderTarget target) {
+  if (target >= _slots.size() || !_slots[target].alive) {
+    throw std::runtime_error(
+        fmt::format("Render target {} does not exist", target));
+  }
+  return _slots[target];
+}
+
+const RenderTargetPool::Slot& RenderTargetPool::GetSlot(
+    RenderTarget target) const {
+  return const_cast<RenderTargetPool*>(this)->GetSlot(target);
+}
+
+uint64 RenderTargetPool::GetKey(const Slot& slot) const {
+  constexpr uint64 RENDER_BUFFER_TAG = uint64(1) << 32;
+  if (slot.desc.renderBuffer) {
+    return RENDER_BUFFER_TAG | *slot.renderBuffer.Get();
+  }
+  return *slot.texture.Get();
+}
+
+void RenderTargetPool::Allocate(Slot& slot) {
+  const auto& desc = slot.desc;
+
+  if (desc.renderBuffer) {
+    auto view = slot.renderBuffer.As<gl::RenderBufferTarget::RENDER_BUFFER>();
+    view.Bind();
+    if (desc.samples > 0) {
+      view.ReserveMultisample(desc.samples, desc.format, desc.width,
+                              desc.height);
+    } else {
+      view.Reserve(desc.format, desc.width, desc.height);
+    }
+    view.Unbind();
+    return;
+  }
+
+  // any pixel transfer format works without data, but depth needs its own
+  GLenum format = GL_RGBA;
+  GLenum type = GL_UNSIGNED_BYTE;
+  if (IsStencilFormat(desc.format)) {
+    format = GL_DEPTH_STENCIL;
+    type = GL_UNSIGNED_INT_24_8;
+  } else if (IsDepthFormat(desc.format)) {
+    format = GL_DEPTH_COMPONENT;
+    type = GL_FLOAT;
+  }
+
+  if (desc.samples > 0) {
+    auto view = slot.texture.As<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE>();
+    view.Bind();
+    view.Reserve2DMultisample(desc.format, desc.samples, true, desc.width,
+                              desc.height, format, type, nullptr);
+    view.Unbind();
+    return;
+  }
+
+  auto view = slot.texture.As<gl::TextureTarget::TEXTURE_2D>();
+  view.Bind();
+  view.Reserve2D(desc.format, desc.width, desc.height, format, type, nullptr);
+
+  // one texel per pixel, users change filtering on the view if they need
+  view.SetParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  view.SetParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  view.SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  view.SetParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  view.Unbind();
+}
+
+void RenderTargetPool::Free(Slot& slot) {
+  // frame buffers keep deleted attachments alive, drop them first
+  auto key = GetKey(slot);
+  _frameBuffers.erase(
+      std::remove_if(_frameBuffers.begin(), _frameBuffers.end(),
+                     [&](const FrameBuffer& frameBuffer) {
+                       return std::any_of(
+                           frameBuffer.key.begin(), frameBuffer.key.end(),
+                           [&](const auto& attachment) {
+                             return attachment.second == key;
+                           });
+                     }),
+      _frameBuffers.end());
+
+  slot.texture = gl::TextureWrapper<>();
+  slot.renderBuffer = gl::RenderBufferWrapper<>();
+  slot.alive = false;
+  slot.free = false;
+  _alive--;
+}
+
+}  // namespace over::graph
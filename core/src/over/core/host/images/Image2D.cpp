@@ -2,7 +2,10 @@
 
 #include <fmt/core.h>
 #include <stb_image.h>
+#include <stb_image_write.h>
 #include <cassert>
+#include <stdexcept>
+#include <string>
 
 namespace over::host {
 
@@ -55,4 +58,14 @@ Image2D Image2D::FromFile(std::string_view filename) {
   return Image2D(sbti.width, sbti.height, sbti.channels, sbti.data);
 }
 
+void Image2D::ToFile(std::string_view filename) const {
+  std::string path(filename);
+  auto stride = static_cast<int32>(_width * _channels);
+  if (stbi_write_png(path.c_str(), static_cast<int32>(_width),
+                     static_cast<int32>(_height), static_cast<int32>(_channels),
+                     _data.data(), stride) == 0) {
+    throw std::runtime_error(fmt::format("Cannot write image {}", path));
+  }
+}
+
 }  // namespace over::host
@@ -0,0 +1,258 @@
+#include <over/core/lighting/CascadedShadowMap.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <over/core/opengl/Texture.hpp>
+
+#include <fmt/core.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace over::lighting {
+
+CascadedShadowMap::CascadedShadowMap(std::string vertexPath,
+                                     std::string fragmentPath,
+                                     uint32 resolution, uint32 cascades)
+    : _shader(std::move(vertexPath), std::move(fragmentPath)),
+      _resolution(std::max(resolution, 1u)),
+      _count(std::clamp(cascades, 1u, MAX_CASCADES)),
+      _shadowDistance(100.f),
+      _splitLambda(0.75f),
+      _casterDistance(100.f),
+      _direction(0.f),
+      _cascades(),
+      _frame(0),
+      _updated(0),
+      _staticRenders(0),
+      _static(),
+      _shadow(),
+      _staticFrame(),
+      _shadowFrame(),
+      _viewport() {
+  // 1, 1, 2, 4: far cascades cover more and move less on screen
+  for (uint32 i = 0; i < MAX_CASCADES; i++) {
+    _cascades[i].interval = i < 2 ? 1 : 1u << (i - 1);
+  }
+
+  auto reserve = [&](gl::TextureWrapper<>& texture, bool compare) {
+    auto view = texture.As<gl::TextureTarget::TEXTURE_2D_ARRAY>();
+    view.Bind();
+    view.Reserve3D(GL_DEPTH_COMPONENT32F, _resolution, _resolution, _count,
+                   GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+    // compared lookups are filtered by the hardware (2x2 PCF)
+    GLint filter = compare ? GL_LINEAR : GL_NEAREST;
+    view.SetParameter(GL_TEXTURE_MIN_FILTER, filter);
+    view.SetParameter(GL_TEXTURE_MAG_FILTER, filter);
+    view.SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    view.SetParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    if (compare) {
+      view.SetParameter(GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+      view.SetParameter(GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    }
+    view.Unbind();
+  };
+
+  reserve(_static, false);
+  reserve(_shadow, true);
+
+  auto attach = [&](gl::FrameBufferWrapper<>& wrapper,
+                    gl::TextureWrapper<>& texture) {
+    auto frame = wrapper.As<gl::FrameBufferTarget::FRAMEBUFFER>();
+    frame.Bind();
+    frame.AttachLayer(GL_DEPTH_ATTACHMENT,
+                      texture.As<gl::TextureTarget::TEXTURE_2D_ARRAY>(), 0, 0);
+    // depth only
+    frame.SetDrawBuffers({GL_NONE});
+    frame.SetReadBuffer(GL_NONE);
+    frame.ReadyOrThrow("Cannot create shadow map frame buffer");
+    frame.Unbind();
+  };
+
+  attach(_staticFrame, _static);
+  attach(_shadowFrame, _shadow);
+}
+
+void CascadedShadowMap::InvalidateStatic() noexcept {
+  for (auto& cascade : _cascades) {
+    cascade.staticValid = false;
+  }
+}
+
+void CascadedShadowMap::SetShadowDistance(float32 distance) noexcept {
+  _shadowDistance = distance;
+  InvalidateStatic();
+}
+
+void CascadedShadowMap::SetSplitLambda(float32 lambda) noexcept {
+  _splitLambda = std::clamp(lambda, 0.f, 1.f);
+  InvalidateStatic();
+}
+
+void CascadedShadowMap::SetCasterDistance(float32 distance) noexcept {
+  _casterDistance = distance;
+  InvalidateStatic();
+}
+
+void CascadedShadowMap::Fit(const Camera& camera, glm::vec3 direction) {
+  const auto& snapshot = camera.GetSnapshot();
+  direction = glm::normalize(direction);
+
+  bool turned = direction != _direction;
+  _direction = direction;
+
+  // rotation only, cascade origins are snapped in this space
+  glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(1.f, 0.f, 0.f)
+                                               : glm::vec3(0.f, 1.f, 0.f);
+  glm::mat4 light = glm::lookAt(glm::vec3(0.f), direction, up);
+
+  float32 zNear = snapshot.zNear;
+  float32 distance = std::max(std::min(_shadowDistance, snapshot.zFar), zNear);
+
+  _updated = 0;
+  _staticRenders = 0;
+
+  float32 from = zNear;
+  for (uint32 i = 0; i < _count; i++) {
+    auto& cascade = _cascades[i];
+
+    float32 t = (i + 1.f) / _count;
+    float32 logarithmic = zNear * std::pow(distance / zNear, t);
+    float32 uniform = zNear + (distance - zNear) * t;
+    float32 to = _splitLambda * logarithmic + (1.f - _splitLambda) * uniform;
+
+    // staggered, far cascades do not all update on the same frame
+    cascade.update = turned || !cascade.rendered || cascade.split != to ||
+                     (_frame + i) % cascade.interval == 0;
+    cascade.split = to;
+
+    if (cascade.update) {
+      auto viewProjection = FitCascade(snapshot, light, from, to);
+      // snapped: a camera that moved less than a texel keeps the cache
+      if (turned || viewProjection != cascade.viewProjection) {
+        cascade.staticValid = false;
+      }
+      cascade.viewProjection = viewProjection;
+      cascade.frustum = Frustum::FromMatrix(viewProjection);
+      cascade.rendered = true;
+      _updated++;
+    }
+
+    from = to;
+  }
+
+  _frame++;
+}
+
+glm::mat4 CascadedShadowMap::FitCascade(const CameraSnapshot& camera,
+                                        const glm::mat4& light, float32 from,
+                                        float32 to) const noexcept {
+  // Bounding sphere of the slice centered on the view axis, it depends only
+  // on the projection and the split. k is the squared corner slope
+  float32 tanX = 1.f / camera.projection[0][0];
+  float32 tanY = 1.f / camera.projection[1][1];
+  float32 k = tanX * tanX + tanY * tanY;
+
+  float32 depth = std::min(0.5f * (from + to) * (1.f + k), to);
+  float32 radius = std::sqrt(to * to * k + (to - depth) * (to - depth));
+  // rounded up, float noise must not change the texel size
+  radius = std::ceil(radius * 16.f) / 16.f;
+
+  glm::vec3 center = camera.inverseView * glm::vec4(0.f, 0.f, -depth, 1.f);
+  glm::vec3 lightCenter = light * glm::vec4(center, 1.f);
+
+  float32 texel = 2.f * radius / _resolution;
+  lightCenter = glm::floor(lightCenter / texel) * texel;
+
+  // light looks down -z, casters up to caster distance before the sphere
+  auto projection = glm::ortho(
+      lightCenter.x - radius, lightCenter.x + radius, lightCenter.y - radius,
+      lightCenter.y + radius, -lightCenter.z - radius - _casterDistance,
+      -lightCenter.z + radius);
+  return projection * light;
+}
+
+void CascadedShadowMap::Begin() {
+  glthrow(glGetIntegerv(GL_VIEWPORT, _viewport.data()));
+  glthrow(glViewport(0, 0, static_cast<GLsizei>(_resolution),
+                     static_cast<GLsizei>(_resolution)));
+
+  glthrow(glEnable(GL_DEPTH_TEST));
+  glthrow(glDepthMask(GL_TRUE));
+
+  // slope scaled bias against shadow acne
+  glthrow(glEnable(GL_POLYGON_OFFSET_FILL));
+  glthrow(glPolygonOffset(2.f, 4.f));
+}
+
+bool CascadedShadowMap::BeginStatic(uint32 cascade) {
+  if (_cascades[cascade].staticValid) {
+    return false;
+  }
+
+  auto frame = _staticFrame.As<gl::FrameBufferTarget::FRAMEBUFFER>();
+  frame.Bind();
+  frame.AttachLayer(GL_DEPTH_ATTACHMENT,
+                    _static.As<gl::TextureTarget::TEXTURE_2D_ARRAY>(), 0,
+                    cascade);
+  glthrow(glClear(GL_DEPTH_BUFFER_BIT));
+
+  _shader.SetMatrix4f("lightViewProjection",
+                      _cascades[cascade].viewProjection);
+
+  _cascades[cascade].staticValid = true;
+  _staticRenders++;
+  return true;
+}
+
+void CascadedShadowMap::BeginDynamic(uint32 cascade) {
+  auto read = _staticFrame.As<gl::FrameBufferTarget::READ_FRAMEBUFFER>();
+  auto draw = _shadowFrame.As<gl::FrameBufferTarget::DRAW_FRAMEBUFFER>();
+
+  read.Bind();
+  read.AttachLayer(GL_DEPTH_ATTACHMENT,
+                   _static.As<gl::TextureTarget::TEXTURE_2D_ARRAY>(), 0,
+                   cascade);
+  draw.Bind();
+  draw.AttachLayer(GL_DEPTH_ATTACHMENT,
+                   _shadow.As<gl::TextureTarget::TEXTURE_2D_ARRAY>(), 0,
+                   cascade);
+
+  auto size = static_cast<GLint>(_resolution);
+  glthrow(glBlitFramebuffer(0, 0, size, size, 0, 0, size, size,
+                            GL_DEPTH_BUFFER_BIT, GL_NEAREST));
+  read.Unbind();
+
+  // dynamic casters on top of the cached static depth
+  _shadowFrame.As<gl::FrameBufferTarget::FRAMEBUFFER>().Bind();
+  _shader.SetMatrix4f("lightViewProjection",
+                      _cascades[cascade].viewProjection);
+}
+
+void CascadedShadowMap::End() {
+  _shadowFrame.As<gl::FrameBufferTarget::FRAMEBUFFER>().Unbind();
+
+  glthrow(glDisable(GL_POLYGON_OFFSET_FILL));
+  glthrow(glViewport(_viewport[0], _viewport[1], _viewport[2], _viewport[3]));
+}
+
+void CascadedShadowMap::Bind(Shader& shader, const glm::mat4& toWorld) {
+  gl::Texture::Activate(static_cast<GLenum>(GL_TEXTURE0 + SHADOW_UNIT));
+  _shadow.As<gl::TextureTarget::TEXTURE_2D_ARRAY>().Bind();
+  gl::Texture::Activate(GL_TEXTURE0);
+
+  shader.SetInt("shadowMap", static_cast<int32>(SHADOW_UNIT));
+  shader.SetInt("cascadeCount", static_cast<int32>(_count));
+
+  glm::vec4 splits(0.f);
+  for (uint32 i = 0; i < _count; i++) {
+    splits[i] = _cascades[i].split;
+    shader.SetMatrix4f(fmt::format("cascadeMatrices[{}]", i),
+                       _cascades[i].viewProjection * toWorld);
+  }
+  shader.SetVec4f("cascadeSplits", splits);
+}
+
+}  // namespace over::lighting
@@ -0,0 +1,320 @@
+#include <over/core/lighting/ClusteredLights.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OVER_LIGHTING_SSE
+#include <emmintrin.h>
+#endif
+
+namespace over::lighting {
+
+// padding boxes are never closer than any radius
+constexpr float32 EMPTY_MIN = std::numeric_limits<float32>::max() / 4;
+constexpr float32 EMPTY_MAX = -EMPTY_MIN;
+
+ClusteredLights::ClusteredLights(glm::uvec3 grid)
+    : _grid(glm::max(grid, glm::uvec3(1))),
+      _stride((_grid.x + BATCH - 1) / BATCH * BATCH),
+      _lights(),
+      _projection(0),
+      _near(0),
+      _far(0),
+      _depthScale(0),
+      _depthBias(0),
+      _minX(),
+      _minY(),
+      _minZ(),
+      _maxX(),
+      _maxY(),
+      _maxZ(),
+      _sliceDepth(),
+      _viewLights(),
+      _assignments(),
+      _clusters(),
+      _indices(),
+      _visibleLights(0),
+      _maxClusterLights(0),
+      _lightBuffer(),
+      _clusterBuffer(),
+      _indexBuffer() {}
+
+void ClusteredLights::Update(const Camera& camera) {
+  const auto& snapshot = camera.GetSnapshot();
+  Update(snapshot.view, snapshot.projection, snapshot.zNear, snapshot.zFar);
+}
+
+void ClusteredLights::Update(const glm::mat4& view,
+                             const glm::mat4& projection, float32 zNear,
+                             float32 zFar) {
+  if (_sliceDepth.empty() || projection != _projection || zNear != _near ||
+      zFar != _far) {
+    BuildBounds(projection, zNear, zFar);
+  }
+
+  _viewLights.resize(_lights.size());
+  _assignments.clear();
+  _visibleLights = 0;
+
+  for (usize i = 0; i < _lights.size(); i++) {
+    const auto& light = _lights[i];
+    glm::vec3 center = view * glm::vec4(light.position, 1.f);
+
+    _viewLights[i] = light;
+    _viewLights[i].position = center;
+
+    auto assigned = _assignments.size();
+    Assign(light, center, static_cast<uint32>(i));
+    if (_assignments.size() != assigned) {
+      _visibleLights++;
+    }
+  }
+
+  Upload();
+}
+
+void ClusteredLights::Bind(Shader& shader, glm::ivec2 viewport) {
+  _lightBuffer.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>().BindBase(
+      LIGHTS_BINDING);
+  _clusterBuffer.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>().BindBase(
+      CLUSTERS_BINDING);
+  _indexBuffer.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>().BindBase(
+      INDICES_BINDING);
+
+  shader.SetIVec3("clusterGrid", glm::ivec3(_grid));
+  shader.SetVec2f("clusterTileSize",
+                  glm::vec2(viewport) / glm::vec2(_grid.x, _grid.y));
+  shader.SetFloat("clusterDepthScale", _depthScale);
+  shader.SetFloat("clusterDepthBias", _depthBias);
+}
+
+float32 ClusteredLights::DepthToSlice(float32 depth) const noexcept {
+  return std::log(depth) * _depthScale - _depthBias;
+}
+
+void ClusteredLights::BuildBounds(const glm::mat4& projection, float32 zNear,
+                                  float32 zFar) {
+  _projection = projection;
+  _near = zNear;
+  _far = zFar;
+
+  // slice = log(depth) * scale - bias, same formula in the fragment shader
+  float32 range = std::log(zFar / zNear);
+  _depthScale = _grid.z / range;
+  _depthBias = _grid.z * std::log(zNear) / range;
+
+  _sliceDepth.resize(_grid.z + 1);
+  for (uint32 z = 0; z <= _grid.z; z++) {
+    _sliceDepth[z] = zNear * std::pow(zFar / zNear,
+                                      static_cast<float32>(z) / _grid.z);
+  }
+
+  // view space x = ndc x * depth * tanX for a symmetric perspective
+  float32 tanX = 1.f / projection[0][0];
+  float32 tanY = 1.f / projection[1][1];
+
+  usize size = static_cast<usize>(_stride) * _grid.y * _grid.z;
+  for (auto* v : {&_minX, &_minY, &_minZ}) {
+    v->assign(size, EMPTY_MIN);
+  }
+  for (auto* v : {&_maxX, &_maxY, &_maxZ}) {
+    v->assign(size, EMPTY_MAX);
+  }
+
+  for (uint32 z = 0; z < _grid.z; z++) {
+    float32 depth0 = _sliceDepth[z];
+    float32 depth1 = _sliceDepth[z + 1];
+    for (uint32 y = 0; y < _grid.y; y++) {
+      float32 y0 = -1.f + 2.f * y / _grid.y;
+      float32 y1 = -1.f + 2.f * (y + 1) / _grid.y;
+      for (uint32 x = 0; x < _grid.x; x++) {
+        float32 x0 = -1.f + 2.f * x / _grid.x;
+        float32 x1 = -1.f + 2.f * (x + 1) / _grid.x;
+
+        auto i = (static_cast<usize>(z) * _grid.y + y) * _stride + x;
+        _minX[i] = std::min(x0 * depth0, x0 * depth1) * tanX;
+        _maxX[i] = std::max(x1 * depth0, x1 * depth1) * tanX;
+        _minY[i] = std::min(y0 * depth0, y0 * depth1) * tanY;
+        _maxY[i] = std::max(y1 * depth0, y1 * depth1) * tanY;
+        _minZ[i] = -depth1;
+        _maxZ[i] = -depth0;
+      }
+    }
+  }
+}
+
+#ifdef OVER_LIGHTING_SSE
+
+// Sphere vs BATCH boxes starting at i, bit per touched box
+static uint32 TestBatch(const float32* minX, const float32* minY,
+                        const float32* minZ, const float32* maxX,
+                        const float32* maxY, const float32* maxZ, usize i,
+                        __m128 cx, __m128 cy, __m128 cz, __m128 radius2) {
+  __m128 zero = _mm_setzero_ps();
+  __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minX + i), cx),
+                                    _mm_sub_ps(cx, _mm_loadu_ps(maxX + i))),
+                         zero);
+  __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minY + i), cy),
+                                    _mm_sub_ps(cy, _mm_loadu_ps(maxY + i))),
+                         zero);
+  __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minZ + i), cz),
+                                    _mm_sub_ps(cz, _mm_loadu_ps(maxZ + i))),
+                         zero);
+  __m128 distance2 = _mm_add_ps(
+      _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+  return static_cast<uint32>(
+      _mm_movemask_ps(_mm_cmple_ps(distance2, radius2)));
+}
+
+const char* ClusteredLights::GetInstructionSet() noexcept { return "SSE"; }
+
+#else
+
+static uint32 TestBatch(const float32* minX, const float32* minY,
+                        const float32* minZ, const float32* maxX,
+                        const float32* maxY, const float32* maxZ, usize i,
+                        float32 cx, float32 cy, float32 cz, float32 radius2) {
+  uint32 mask = 0;
+  for (uint32 j = 0; j < ClusteredLights::BATCH; j++) {
+    float32 dx = std::max({minX[i + j] - cx, cx - maxX[i + j], 0.f});
+    float32 dy = std::max({minY[i + j] - cy, cy - maxY[i + j], 0.f});
+    float32 dz = std::max({minZ[i + j] - cz, cz - maxZ[i + j], 0.f});
+    if (dx * dx + dy * dy + dz * dz <= radius2) {
+      mask |= 1u << j;
+    }
+  }
+  return mask;
+}
+
+const char* ClusteredLights::GetInstructionSet() noexcept { return "scalar"; }
+
+#endif
+
+void ClusteredLights::Assign(const PointLight& light, glm::vec3 center,
+                             uint32 index) {
+  float32 radius = light.radius;
+  float32 depth = -center.z;
+  if (radius <= 0.f || depth + radius < _near || depth - radius > _far) {
+    return;
+  }
+
+  float32 minDepth = std::max(depth - radius, _near);
+  float32 maxDepth = std::min(depth + radius, _far);
+
+  // one extra slice each side absorbs rounding of the logarithm
+  auto lastZ = static_cast<int32>(_grid.z) - 1;
+  int32 z0 = std::clamp(
+      static_cast<int32>(std::floor(DepthToSlice(minDepth))) - 1, 0, lastZ);
+  int32 z1 = std::clamp(
+      static_cast<int32>(std::floor(DepthToSlice(maxDepth))) + 1, 0, lastZ);
+
+  float32 tanX = 1.f / _projection[0][0];
+  float32 tanY = 1.f / _projection[1][1];
+
+#ifdef OVER_LIGHTING_SSE
+  __m128 cx = _mm_set1_ps(center.x);
+  __m128 cy = _mm_set1_ps(center.y);
+  __m128 cz = _mm_set1_ps(center.z);
+  __m128 radius2 = _mm_set1_ps(radius * radius);
+#else
+  float32 cx = center.x;
+  float32 cy = center.y;
+  float32 cz = center.z;
+  float32 radius2 = radius * radius;
+#endif
+
+  // Screen range of the sphere box within the slice depth range. An edge
+  // lies farthest from the screen center at the nearest depth
+  auto tileRange = [](float32 low, float32 high, float32 tangent,
+                      float32 nearDepth, float32 farDepth, uint32 tiles,
+                      int32& first, int32& last) {
+    float32 ndcLow = low / (tangent * (low < 0.f ? nearDepth : farDepth));
+    float32 ndcHigh = high / (tangent * (high > 0.f ? nearDepth : farDepth));
+    if (ndcHigh < -1.f || ndcLow > 1.f) {
+      return false;
+    }
+    auto lastTile = static_cast<int32>(tiles) - 1;
+    first = std::clamp(
+        static_cast<int32>(std::floor((ndcLow + 1.f) * 0.5f * tiles)), 0,
+        lastTile);
+    last = std::clamp(
+        static_cast<int32>(std::floor((ndcHigh + 1.f) * 0.5f * tiles)), 0,
+        lastTile);
+    return true;
+  };
+
+  for (int32 z = z0; z <= z1; z++) {
+    float32 nearDepth = std::max(minDepth, _sliceDepth[z]);
+    float32 farDepth = std::min(maxDepth, _sliceDepth[z + 1]);
+    if (nearDepth > farDepth) {
+      continue;
+    }
+
+    int32 x0, x1, y0, y1;
+    if (!tileRange(center.x - radius, center.x + radius, tanX, nearDepth,
+                   farDepth, _grid.x, x0, x1) ||
+        !tileRange(center.y - radius, center.y + radius, tanY, nearDepth,
+                   farDepth, _grid.y, y0, y1)) {
+      continue;
+    }
+
+    for (int32 y = y0; y <= y1; y++) {
+      auto row = (static_cast<usize>(z) * _grid.y + y) * _stride;
+      auto cluster = (static_cast<uint32>(z) * _grid.y + y) * _grid.x;
+
+      for (int32 x = x0 / BATCH * BATCH; x <= x1; x += BATCH) {
+        uint32 mask = TestBatch(_minX.data(), _minY.data(), _minZ.data(),
+                                _maxX.data(), _maxY.data(), _maxZ.data(),
+                                row + x, cx, cy, cz, radius2);
+        for (int32 j = 0; mask != 0; j++, mask >>= 1) {
+          if ((mask & 1) != 0 && x + j >= x0 && x + j <= x1) {
+            _assignments.push_back(
+                {cluster + static_cast<uint32>(x + j), index});
+          }
+        }
+      }
+    }
+  }
+}
+
+void ClusteredLights::Upload() {
+  // counting sort by cluster, lights of a cluster stay in light order
+  _clusters.assign(static_cast<usize>(_grid.x) * _grid.y * _grid.z, {0, 0});
+  for (const auto& assignment : _assignments) {
+    _clusters[assignment.cluster].count++;
+  }
+
+  uint32 offset = 0;
+  _maxClusterLights = 0;
+  for (auto& cluster : _clusters) {
+    cluster.offset = offset;
+    offset += cluster.count;
+    _maxClusterLights = std::max(_maxClusterLights, cluster.count);
+    cluster.count = 0;
+  }
+
+  _indices.resize(_assignments.size());
+  for (const auto& assignment : _assignments) {
+    auto& cluster = _clusters[assignment.cluster];
+    _indices[cluster.offset + cluster.count++] = assignment.light;
+  }
+
+  auto upload = [](gl::BufferWrapper<>& buffer, usize size,
+                   const void* data) {
+    auto view = buffer.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>();
+    view.Bind();
+    view.Reserve(size, data, GL_STREAM_DRAW);
+    view.Unbind();
+  };
+
+  upload(_lightBuffer, sizeof(PointLight) * _viewLights.size(),
+         _viewLights.data());
+  upload(_clusterBuffer, sizeof(Cluster) * _clusters.size(),
+         _clusters.data());
+  upload(_indexBuffer, sizeof(uint32) * _indices.size(), _indices.data());
+}
+
+}  // namespace over::lighting
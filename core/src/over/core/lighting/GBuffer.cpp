@@ -0,0 +1,78 @@
+#include <over/core/lighting/GBuffer.hpp>
+
+#include <over/core/opengl/Texture.hpp>
+
+namespace over::lighting {
+
+GBuffer::GBuffer() : _width(0), _height(0), _targets(), _depth(), _frame() {}
+
+void GBuffer::Resize(uint32 width, uint32 height) {
+  if (width == _width && height == _height) {
+    return;
+  }
+
+  bool attached = _width != 0 && _height != 0;
+  _width = width;
+  _height = height;
+
+  auto reserve = [&](gl::TextureWrapper<>& texture, GLint internalFormat,
+                     GLenum format, GLenum type) {
+    auto view = texture.As<gl::TextureTarget::TEXTURE_2D>();
+    view.Bind();
+    view.Reserve2D(internalFormat, width, height, format, type, nullptr);
+
+    // one texel per pixel, never filtered
+    view.SetParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    view.SetParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    view.SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    view.SetParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    view.Unbind();
+  };
+
+  reserve(_targets[ALBEDO_SPECULAR], GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+  reserve(_targets[NORMAL], GL_RG16, GL_RG, GL_UNSIGNED_SHORT);
+  reserve(_depth, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8);
+
+  // attachments survive storage reallocation
+  if (attached) {
+    return;
+  }
+
+  auto frame = _frame.As<gl::FrameBufferTarget::FRAMEBUFFER>();
+  frame.Bind();
+  for (usize i = 0; i < TARGETS; i++) {
+    frame.Attach(static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + i),
+                 _targets[i].As<gl::TextureTarget::TEXTURE_2D>(), 0);
+  }
+  frame.Attach(GL_DEPTH_STENCIL_ATTACHMENT,
+               _depth.As<gl::TextureTarget::TEXTURE_2D>(), 0);
+  frame.SetDrawBuffers(TARGETS);
+  frame.ReadyOrThrow("Cannot create G-buffer");
+  frame.Unbind();
+}
+
+void GBuffer::Clear() {
+  // per target clears keep the context clear color untouched
+  constexpr GLfloat zero[4] = {0.f, 0.f, 0.f, 0.f};
+  for (usize i = 0; i < TARGETS; i++) {
+    glthrow(glClearBufferfv(GL_COLOR, static_cast<GLint>(i), zero));
+  }
+  glthrow(glClearBufferfi(GL_DEPTH_STENCIL, 0, 1.f, 0));
+}
+
+void GBuffer::BindTextures(Shader& shader) {
+  auto bind = [&](gl::TextureWrapper<>& texture, usize unit,
+                  const std::string& name) {
+    gl::Texture::Activate(static_cast<GLenum>(GL_TEXTURE0 + unit));
+    texture.As<gl::TextureTarget::TEXTURE_2D>().Bind();
+    shader.SetInt(name, static_cast<int32>(unit));
+  };
+
+  bind(_targets[ALBEDO_SPECULAR], ALBEDO_SPECULAR_UNIT, "gAlbedoSpecular");
+  bind(_targets[NORMAL], NORMAL_UNIT, "gNormal");
+  bind(_depth, DEPTH_UNIT, "gDepth");
+
+  gl::Texture::Activate(GL_TEXTURE0);
+}
+
+}  // namespace over::lighting
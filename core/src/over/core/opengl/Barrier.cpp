@@ -0,0 +1,37 @@
+#include <over/core/opengl/Barrier.hpp>
+
+#include <over/core/opengl/wrappers/Exception.hpp>
+
+namespace over::gl {
+void Barrier::Memory(GLbitfield barriers) {
+  glthrow(glMemoryBarrier(barriers));
+}
+
+void Barrier::ShaderStorage() {
+  Memory(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void Barrier::ImageAccess() {
+  Memory(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+}
+
+void Barrier::TextureFetch() {
+  Memory(GL_TEXTURE_FETCH_BARRIER_BIT);
+}
+
+void Barrier::Command() {
+  Memory(GL_COMMAND_BARRIER_BIT);
+}
+
+void Barrier::VertexData() {
+  Memory(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT);
+}
+
+void Barrier::BufferUpdate() {
+  Memory(GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+void Barrier::All() {
+  Memory(GL_ALL_BARRIER_BITS);
+}
+}  // namespace over::gl
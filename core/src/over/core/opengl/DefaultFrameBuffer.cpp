@@ -0,0 +1,20 @@
+#include <over/core/opengl/DefaultFrameBuffer.hpp>
+
+namespace over::gl {
+
+namespace {
+
+// one GL context per process
+GLuint s_defaultFrameBuffer = 0;
+
+}  // namespace
+
+GLuint GetDefaultFrameBuffer() noexcept {
+  return s_defaultFrameBuffer;
+}
+
+void SetDefaultFrameBuffer(GLuint id) noexcept {
+  s_defaultFrameBuffer = id;
+}
+
+}  // namespace over::gl
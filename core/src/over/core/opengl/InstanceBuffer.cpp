@@ -0,0 +1,64 @@
+#include <over/core/opengl/InstanceBuffer.hpp>
+
+#include <utility>
+
+namespace over {
+Instance::Instance() : model(1), color(1), material(0) {}
+
+Instance::Instance(glm::mat4 model, glm::vec4 color, uint32 material)
+    : model(model), color(color), material(material) {}
+
+InstanceBuffer::InstanceBuffer() noexcept
+    : _instances(), _buffer(), _capacity(0), _usage(GL_STREAM_DRAW) {}
+
+InstanceBuffer::InstanceBuffer(std::vector<Instance> instances, GLenum usage)
+    : _instances(std::move(instances)),
+      _buffer(),
+      _capacity(0),
+      _usage(usage) {}
+
+void InstanceBuffer::ToGPU(bool unbind) {
+  auto view = _buffer.As<gl::BufferTarget::ARRAY_BUFFER>();
+  view.Bind();
+
+  auto size = sizeof(Instance) * _instances.size();
+  if (_instances.size() > _capacity) {
+    // reallocation keeps buffer name, so attached VAOs stay valid
+    _capacity = _instances.size();
+    view.Reserve(size, _instances.data(), _usage);
+  } else {
+    // orphaning: driver doesn't wait for previous frame draws
+    view.Reserve(sizeof(Instance) * _capacity, nullptr, _usage);
+    view.Write(0, size, _instances.data());
+  }
+
+  if (unbind) {
+    Unbind();
+  }
+}
+
+void InstanceBuffer::Reserve(usize count) {
+  if (count <= _capacity) {
+    return;
+  }
+
+  auto view = _buffer.As<gl::BufferTarget::ARRAY_BUFFER>();
+  view.Bind();
+  _capacity = count;
+  view.Reserve(sizeof(Instance) * _capacity, nullptr, _usage);
+  view.Unbind();
+}
+
+void InstanceBuffer::BindStorage(usize index) const {
+  auto view = _buffer.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>();
+  view.BindBase(index);
+}
+
+void InstanceBuffer::Bind() const {
+  _buffer.As<gl::BufferTarget::ARRAY_BUFFER>().Bind();
+}
+
+void InstanceBuffer::Unbind() const {
+  _buffer.As<gl::BufferTarget::ARRAY_BUFFER>().Unbind();
+}
+}  // namespace over
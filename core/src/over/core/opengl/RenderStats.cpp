@@ -0,0 +1,173 @@
+#include <over/core/opengl/RenderStats.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+namespace over::gl {
+
+RenderCounters& RenderCounters::operator-=(
+    const RenderCounters& other) noexcept {
+  drawCalls -= other.drawCalls;
+  triangles -= other.triangles;
+  instances -= other.instances;
+  dispatches -= other.dispatches;
+  programBinds -= other.programBinds;
+  layoutBinds -= other.layoutBinds;
+  textureBinds -= other.textureBinds;
+  frameBufferBinds -= other.frameBufferBinds;
+  uniformCalls -= other.uniformCalls;
+  bufferBytes -= other.bufferBytes;
+  textureBytes -= other.textureBytes;
+  created -= other.created;
+  destroyed -= other.destroyed;
+  return *this;
+}
+
+usize GetUploadSize(GLenum format, GLenum type, usize texels) noexcept {
+  usize channels = 4;
+  switch (format) {
+    case GL_RED:
+    case GL_RED_INTEGER:
+    case GL_DEPTH_COMPONENT:
+      channels = 1;
+      break;
+    case GL_RG:
+    case GL_RG_INTEGER:
+    case GL_DEPTH_STENCIL:
+      channels = 2;
+      break;
+    case GL_RGB:
+    case GL_BGR:
+    case GL_RGB_INTEGER:
+      channels = 3;
+      break;
+    default:
+      break;
+  }
+
+  usize size = 1;
+  switch (type) {
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+      size = 2;
+      break;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+      size = 4;
+      break;
+    // packed types hold every channel in one value
+    case GL_UNSIGNED_INT_24_8:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+      return texels * 4;
+    default:
+      break;
+  }
+  return texels * channels * size;
+}
+
+RenderStats& RenderStats::Instance() {
+  static RenderStats stats;
+  return stats;
+}
+
+RenderStats::RenderStats()
+    : _totals(),
+      _frameStart(),
+      _passStart(),
+      _pass(),
+      _inPass(false),
+      _passes(),
+      _frames(HISTORY),
+      _frameIndex(0) {}
+
+void RenderStats::BeginPass(std::string_view name) {
+  if (_inPass) {
+    EndPass();
+  }
+  _pass = name;
+  _passStart = _totals;
+  _inPass = true;
+}
+
+void RenderStats::EndPass() {
+  if (!_inPass) {
+    return;
+  }
+  _inPass = false;
+
+  PassCounters pass;
+  pass.name = std::move(_pass);
+  pass.counters = _totals - _passStart;
+  _passes.push_back(std::move(pass));
+}
+
+void RenderStats::NextFrame() {
+  EndPass();
+
+  auto& frame = _frames[_frameIndex % HISTORY];
+  frame.index = _frameIndex;
+  frame.counters = _totals - _frameStart;
+  frame.passes = std::move(_passes);
+  _passes.clear();
+
+  _frameStart = _totals;
+  _frameIndex++;
+}
+
+usize RenderStats::GetFrameCount() const noexcept {
+  return std::min(_frameIndex, HISTORY);
+}
+
+const RenderCounters& RenderStats::GetFrame() const {
+  if (_frameIndex == 0) {
+    throw std::runtime_error("No frame was counted yet");
+  }
+  return _frames[(_frameIndex - 1) % HISTORY].counters;
+}
+
+const std::vector<PassCounters>& RenderStats::GetPasses() const {
+  if (_frameIndex == 0) {
+    throw std::runtime_error("No frame was counted yet");
+  }
+  return _frames[(_frameIndex - 1) % HISTORY].passes;
+}
+
+std::string RenderStats::ExportCsv() const {
+  std::string csv =
+      "frame,pass,draw_calls,triangles,instances,dispatches,program_binds,"
+      "layout_binds,texture_binds,frame_buffer_binds,uniform_calls,"
+      "buffer_bytes,texture_bytes,created,destroyed\n";
+
+  auto row = [&](usize frame, std::string_view pass,
+                 const RenderCounters& c) {
+    // names are free text, quotes double inside quoted fields
+    std::string quoted;
+    for (char ch : pass) {
+      quoted += ch;
+      if (ch == '"') {
+        quoted += '"';
+      }
+    }
+    csv += fmt::format("{},\"{}\",{},{},{},{},{},{},{},{},{},{},{},{},{}\n",
+                       frame, quoted, c.drawCalls, c.triangles, c.instances,
+                       c.dispatches, c.programBinds, c.layoutBinds,
+                       c.textureBinds, c.frameBufferBinds, c.uniformCalls,
+                       c.bufferBytes, c.textureBytes, c.created, c.destroyed);
+  };
+
+  for (usize age = GetFrameCount(); age-- > 0;) {
+    const auto& frame = _frames[(_frameIndex - 1 - age) % HISTORY];
+    row(frame.index, "total", frame.counters);
+    for (const auto& pass : frame.passes) {
+      row(frame.index, pass.name, pass.counters);
+    }
+  }
+  return csv;
+}
+
+}  // namespace over::gl
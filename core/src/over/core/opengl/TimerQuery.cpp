@@ -0,0 +1,67 @@
+#include <over/core/opengl/TimerQuery.hpp>
+
+#include <utility>
+
+#include <over/core/opengl/wrappers/Exception.hpp>
+
+namespace over::gl {
+TimerQuery::TimerQuery() noexcept : _queries{}, _frame(0), _milliseconds(0) {}
+
+TimerQuery::TimerQuery(TimerQuery&& other) noexcept : TimerQuery() {
+  *this = std::move(other);
+}
+
+TimerQuery& TimerQuery::operator=(TimerQuery&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  Free();
+
+  _queries = std::exchange(other._queries, {});
+  _frame = std::exchange(other._frame, 0);
+  _milliseconds = std::exchange(other._milliseconds, 0);
+
+  return *this;
+}
+
+TimerQuery::~TimerQuery() {
+  Free();
+}
+
+void TimerQuery::Free() noexcept {
+  if (_queries[0] != 0) {
+    glDeleteQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+    _queries.fill(0);
+  }
+}
+
+void TimerQuery::Begin() {
+  // allocated on first use, timers can be members created before the context
+  if (_queries[0] == 0) {
+    glthrow(glGenQueries(static_cast<GLsizei>(_queries.size()),
+                         _queries.data()));
+  }
+
+  usize slot = 2 * (_frame % LATENCY);
+  if (_frame >= LATENCY) {
+    // the end timestamp lands last
+    GLint available = 0;
+    glGetQueryObjectiv(_queries[slot + 1], GL_QUERY_RESULT_AVAILABLE,
+                       &available);
+    if (available != 0) {
+      GLuint64 begin = 0;
+      GLuint64 end = 0;
+      glGetQueryObjectui64v(_queries[slot], GL_QUERY_RESULT, &begin);
+      glGetQueryObjectui64v(_queries[slot + 1], GL_QUERY_RESULT, &end);
+      _milliseconds = static_cast<float64>(end - begin) / 1e6;
+    }
+  }
+
+  glthrow(glQueryCounter(_queries[slot], GL_TIMESTAMP));
+}
+
+void TimerQuery::End() {
+  glthrow(glQueryCounter(_queries[2 * (_frame % LATENCY) + 1], GL_TIMESTAMP));
+  _frame++;
+}
+}  // namespace over::gl
@@ -5,6 +5,8 @@
 
 #include <over/core/Includes.hpp>
 
+#include <glm/glm.hpp>
+
 namespace over {
 
 void VAO::AttachAttribute(uint32 location, uint32 count, GLenum type,
@@ -15,6 +17,36 @@ void VAO::AttachAttribute(uint32 location, uint32 count, GLenum type,
   view.EnableAttribute(location);
 }
 
+void VAO::AttachIntegerAttribute(uint32 location, uint32 count, GLenum type,
+                                 usize size, usize offset) {
+  auto view = _layout.As<gl::LayoutTarget::VERTEX_ARRAY>();
+  view.SetIntegerAttribute(location, count, type, size, offset);
+  view.EnableAttribute(location);
+}
+
+void VAO::AttachInstancedAttribute(uint32 location, uint32 count, GLenum type,
+                                   usize size, usize offset, uint32 divisor) {
+  AttachAttribute(location, count, type, size, offset);
+  _layout.As<gl::LayoutTarget::VERTEX_ARRAY>().SetAttributeDivisor(location,
+                                                                    divisor);
+}
+
+void VAO::AttachInstancedIntegerAttribute(uint32 location, uint32 count,
+                                          GLenum type, usize size,
+                                          usize offset, uint32 divisor) {
+  AttachIntegerAttribute(location, count, type, size, offset);
+  _layout.As<gl::LayoutTarget::VERTEX_ARRAY>().SetAttributeDivisor(location,
+                                                                    divisor);
+}
+
+void VAO::AttachInstancedMatrix(uint32 location, usize size, usize offset,
+                                uint32 divisor) {
+  for (uint32 column = 0; column < 4; column++) {
+    AttachInstancedAttribute(location + column, 4, GL_FLOAT, size,
+                             offset + sizeof(glm::vec4) * column, divisor);
+  }
+}
+
 void VAO::Bind() const {
   _layout.As<gl::LayoutTarget::VERTEX_ARRAY>().Bind();
 }
@@ -3,6 +3,7 @@
 #include <cassert>
 
 #include <over/core/Includes.hpp>
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
 
 namespace over::gl {
@@ -10,6 +11,7 @@ namespace over::gl {
 Address DefaultBufferAllocator::Alloc() {
   GLuint id = 0;
   glthrow(glGenBuffers(1, &id));
+  OVER_RENDER_STAT(created, 1);
   return Address(id);
 }
 
@@ -20,6 +22,7 @@ void DefaultBufferAllocator::Dealloc(Address ptr) {
 
   assert(glIsBuffer(*ptr));
   glthrow(glDeleteBuffers(1, &*ptr));
+  OVER_RENDER_STAT(destroyed, 1);
 }
 
 }  // namespace over::gl
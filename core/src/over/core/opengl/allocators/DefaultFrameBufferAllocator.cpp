@@ -1,12 +1,14 @@
 #include <over/core/opengl/allocators/DefaultFrameBufferAllocator.hpp>
 
 #include <over/core/Includes.hpp>
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
 
 namespace over::gl {
 Address DefaultFrameBufferAllocator::Alloc() {
   GLuint id = 0;
   glthrow(glGenFramebuffers(1, &id));
+  OVER_RENDER_STAT(created, 1);
   return Address(id);
 }
 
@@ -17,6 +19,7 @@ void DefaultFrameBufferAllocator::Dealloc(Address ptr) {
 
   assert(glIsFramebuffer(*ptr));
   glthrow(glDeleteFramebuffers(1, &*ptr));
+  OVER_RENDER_STAT(destroyed, 1);
 }
 
 }  // namespace over::gl
@@ -1,12 +1,14 @@
 #include <over/core/opengl/allocators/DefaultLayoutAllocator.hpp>
 
 #include <over/core/Includes.hpp>
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
 
 namespace over::gl {
 Address DefaultLayoutAllocator::Alloc() {
   GLuint id = 0;
   glthrow(glGenVertexArrays(1, &id));
+  OVER_RENDER_STAT(created, 1);
   return Address(id);
 }
 
@@ -17,5 +19,6 @@ void DefaultLayoutAllocator::Dealloc(Address ptr) {
 
   assert(glIsVertexArray(*ptr));
   glthrow(glDeleteVertexArrays(1, &*ptr));
+  OVER_RENDER_STAT(destroyed, 1);
 }
 }  // namespace over::gl
@@ -2,12 +2,14 @@
 
 #include <cassert>
 
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
 
 namespace over::gl {
 Address DefaultRenderBufferAllocator::Alloc() {
   GLuint id = 0;
   glthrow(glGenRenderbuffers(1, &id));
+  OVER_RENDER_STAT(created, 1);
   return Address(id);
 }
 
@@ -18,5 +20,6 @@ void DefaultRenderBufferAllocator::Dealloc(Address ptr) {
 
   assert(glIsRenderbuffer(*ptr));
   glthrow(glDeleteRenderbuffers(1, &*ptr));
+  OVER_RENDER_STAT(destroyed, 1);
 }
 }  // namespace over::gl
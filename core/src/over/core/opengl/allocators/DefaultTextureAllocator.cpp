@@ -3,12 +3,14 @@
 #include <cassert>
 
 #include <over/core/Includes.hpp>
+#include <over/core/opengl/RenderStats.hpp>
 #include <over/core/opengl/wrappers/Exception.hpp>
 
 namespace over::gl {
 Address DefaultTextureAllocator::Alloc() {
   GLuint result = 0;
   glthrow(glGenTextures(1, &result));
+  OVER_RENDER_STAT(created, 1);
   return Address(result);
 }
 
@@ -19,5 +21,6 @@ void DefaultTextureAllocator::Dealloc(Address ptr) {
 
   assert(glIsTexture(*ptr));
   glthrow(glDeleteTextures(1, &*ptr));
+  OVER_RENDER_STAT(destroyed, 1);
 }
 }  // namespace over::gl
@@ -0,0 +1,130 @@
+#include <over/core/post/Bloom.hpp>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include <over/core/opengl/RenderStats.hpp>
+#include <over/core/opengl/Texture.hpp>
+
+namespace over::post {
+
+constexpr usize SOURCE_UNIT = 0;
+// smallest level side, smaller ones only add passes
+constexpr int32 MIN_LEVEL_SIZE = 8;
+
+Bloom::Bloom(std::string vertexPath, std::string downsamplePath,
+             std::string upsamplePath, Quality quality)
+    : _downsample(vertexPath, std::move(downsamplePath)),
+      _upsample(std::move(vertexPath), std::move(upsamplePath)),
+      _quad(Mesh::GenQuad({})),
+      _quality(quality),
+      _threshold(0.8f),
+      _knee(0.5f),
+      _radius(1.f),
+      _levels() {}
+
+void Bloom::SetThreshold(float32 threshold, float32 knee) noexcept {
+  _threshold = threshold;
+  _knee = std::max(knee, 1e-4f);
+}
+
+gl::Texture2DView Bloom::Render(graph::RenderTargetPool& pool,
+                                gl::Texture2DView source, glm::ivec2 size) {
+  Release(pool);
+
+  GLint frame = 0;
+  std::array<GLint, 4> viewport{};
+  glthrow(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &frame));
+  glthrow(glGetIntegerv(GL_VIEWPORT, viewport.data()));
+  glthrow(glDisable(GL_DEPTH_TEST));
+
+  source.Bind();
+  source.SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  source.SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  std::vector<glm::ivec2> sizes;
+  glm::ivec2 levelSize = size / 2;
+  while (sizes.size() < static_cast<usize>(_quality) &&
+         std::min(levelSize.x, levelSize.y) >= MIN_LEVEL_SIZE) {
+    sizes.push_back(levelSize);
+    levelSize /= 2;
+  }
+
+  for (auto levelSize : sizes) {
+    graph::RenderTargetDesc desc;
+    desc.format = FORMAT;
+    desc.width = static_cast<uint32>(levelSize.x);
+    desc.height = static_cast<uint32>(levelSize.y);
+
+    auto target = pool.Acquire(desc);
+    auto view = pool.GetTexture(target);
+    view.Bind();
+    view.SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    view.SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    _levels.push_back(target);
+  }
+
+  auto bind = [&](usize level) {
+    graph::Attachment attachment;
+    attachment.target = _levels[level];
+    pool.GetFrameBuffer({attachment}).Bind();
+    glthrow(glViewport(0, 0, sizes[level].x, sizes[level].y));
+  };
+
+  // down: source -> 0 -> 1 -> ..., only the first pass thresholds
+  _downsample.Use([&] {
+    _downsample.SetFloat("threshold", _threshold);
+    _downsample.SetFloat("knee", _knee);
+
+    for (usize level = 0; level < _levels.size(); level++) {
+      bind(level);
+      _downsample.SetBool("prefilter", level == 0);
+      if (level == 0) {
+        Draw(_downsample, source, size);
+      } else {
+        Draw(_downsample, pool.GetTexture(_levels[level - 1]),
+             sizes[level - 1]);
+      }
+    }
+  });
+
+  // up: every level adds its blurred self to the one above
+  glthrow(glEnable(GL_BLEND));
+  glthrow(glBlendFunc(GL_ONE, GL_ONE));
+  _upsample.Use([&] {
+    _upsample.SetFloat("radius", _radius);
+    for (usize level = _levels.size(); level-- > 1;) {
+      bind(level - 1);
+      Draw(_upsample, pool.GetTexture(_levels[level]), sizes[level]);
+    }
+  });
+  glthrow(glDisable(GL_BLEND));
+
+  glthrow(glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(frame)));
+  OVER_RENDER_STAT(frameBufferBinds, 1);
+  glthrow(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+
+  if (_levels.empty()) {
+    return gl::Texture2DView();
+  }
+  return pool.GetTexture(_levels.front());
+}
+
+void Bloom::Release(graph::RenderTargetPool& pool) {
+  for (auto target : _levels) {
+    pool.Release(target);
+  }
+  _levels.clear();
+}
+
+void Bloom::Draw(Shader& shader, gl::Texture2DView source,
+                 glm::ivec2 sourceSize) {
+  gl::Texture::Activate(GL_TEXTURE0 + SOURCE_UNIT);
+  source.Bind();
+  shader.SetInt("source", SOURCE_UNIT);
+  shader.SetVec2f("texelSize", 1.f / glm::vec2(sourceSize));
+  _quad.Draw();
+}
+
+}  // namespace over::post
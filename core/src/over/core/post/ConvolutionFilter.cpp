@@ -0,0 +1,162 @@
+#include <over/core/post/ConvolutionFilter.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+#include <over/core/opengl/Barrier.hpp>
+#include <over/core/opengl/Texture.hpp>
+
+namespace over::post {
+
+constexpr usize SOURCE_UNIT = 0;
+
+ConvolutionFilter::ConvolutionFilter(std::string separablePath,
+                                     std::string tiledPath)
+    : _separable(Shader::FromCompute(std::move(separablePath))),
+      _tiled(Shader::FromCompute(std::move(tiledPath))),
+      _weights(),
+      _uploaded(),
+      _intermediate(),
+      _size(0),
+      _method(Method::AUTO),
+      _taps(0) {}
+
+ConvolutionFilter::Method ConvolutionFilter::Choose(
+    const Kernel& kernel) noexcept {
+  return kernel.IsSeparable() ? Method::SEPARABLE : Method::TILED;
+}
+
+void ConvolutionFilter::Apply(const Kernel& kernel, gl::Texture2DView source,
+                              gl::Texture2DView destination, glm::ivec2 size,
+                              GLenum format, Method method) {
+  if (size.x <= 0 || size.y <= 0) {
+    return;
+  }
+
+  if (method == Method::AUTO) {
+    method = Choose(kernel);
+  }
+  if (method == Method::SEPARABLE && !kernel.IsSeparable()) {
+    throw std::runtime_error("Kernel is not separable");
+  }
+
+  Upload(kernel, method);
+  _weights.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>().BindBase(
+      WEIGHTS_BINDING);
+
+  _method = method;
+  if (method == Method::SEPARABLE) {
+    _taps = kernel.GetSize() * 2;
+    Separable(kernel, source, destination, size, format);
+  } else {
+    _taps = kernel.GetSize() * kernel.GetSize();
+    General(kernel, source, destination, size, format,
+            method == Method::TILED);
+  }
+}
+
+void ConvolutionFilter::Upload(const Kernel& kernel, Method method) {
+  // separable: row, then column
+  std::vector<float32> weights;
+  if (method == Method::SEPARABLE) {
+    weights = kernel.GetRow();
+    weights.insert(weights.end(), kernel.GetColumn().begin(),
+                   kernel.GetColumn().end());
+  } else {
+    weights = kernel.GetWeights();
+  }
+
+  if (weights == _uploaded) {
+    return;
+  }
+
+  auto view = _weights.As<gl::BufferTarget::SHADER_STORAGE_BUFFER>();
+  view.Bind();
+  view.Reserve(sizeof(float32) * weights.size(), weights.data(),
+               GL_STATIC_DRAW);
+  view.Unbind();
+
+  _uploaded = std::move(weights);
+}
+
+void ConvolutionFilter::Resize(glm::ivec2 size) {
+  // immutable storage can not be resized, allocate a new texture
+  _intermediate = gl::TextureWrapper<>();
+  _size = size;
+
+  auto view = _intermediate.As<gl::TextureTarget::TEXTURE_2D>();
+  view.Bind();
+  view.Storage2D(1, GL_RGBA16F, _size.x, _size.y);
+  view.SetParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  view.SetParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  view.Unbind();
+}
+
+void ConvolutionFilter::Separable(const Kernel& kernel,
+                                  gl::Texture2DView source,
+                                  gl::Texture2DView destination,
+                                  glm::ivec2 size, GLenum format) {
+  if (size != _size) {
+    Resize(size);
+  }
+
+  auto intermediate = _intermediate.As<gl::TextureTarget::TEXTURE_2D>();
+  auto group = _separable.GetWorkGroupSize();
+  auto radius = static_cast<int32>(kernel.GetRadius());
+
+  _separable.Use([&] {
+    _separable.SetInt("source", SOURCE_UNIT);
+    _separable.SetInt("radius", radius);
+    _separable.SetIVec2("size", size);
+
+    auto pass = [&](gl::Texture2DView from, gl::Texture2DView to,
+                    GLenum toFormat, glm::ivec2 direction, int32 offset) {
+      gl::Texture::Activate(GL_TEXTURE0 + SOURCE_UNIT);
+      from.Bind();
+      to.BindImage(DESTINATION_IMAGE, 0, GL_WRITE_ONLY, toFormat);
+
+      _separable.SetIVec2("direction", direction);
+      _separable.SetInt("weightOffset", offset);
+      _separable.Dispatch((size.x + group.x - 1) / group.x,
+                          (size.y + group.y - 1) / group.y);
+    };
+
+    // rows read the row factor, columns the column factor after it
+    pass(source, intermediate, GL_RGBA16F, {1, 0}, 0);
+    gl::Barrier::TextureFetch();
+    pass(intermediate, destination, format, {0, 1},
+         static_cast<int32>(kernel.GetSize()));
+  });
+
+  destination.UnbindImage(DESTINATION_IMAGE);
+  intermediate.Unbind();
+
+  gl::Barrier::TextureFetch();
+}
+
+void ConvolutionFilter::General(const Kernel& kernel,
+                                gl::Texture2DView source,
+                                gl::Texture2DView destination,
+                                glm::ivec2 size, GLenum format, bool tiled) {
+  auto group = _tiled.GetWorkGroupSize();
+
+  gl::Texture::Activate(GL_TEXTURE0 + SOURCE_UNIT);
+  source.Bind();
+  destination.BindImage(DESTINATION_IMAGE, 0, GL_WRITE_ONLY, format);
+
+  _tiled.Use([&] {
+    _tiled.SetInt("source", SOURCE_UNIT);
+    _tiled.SetInt("radius", static_cast<int32>(kernel.GetRadius()));
+    _tiled.SetIVec2("size", size);
+    _tiled.SetBool("tiled", tiled);
+    _tiled.Dispatch((size.x + group.x - 1) / group.x,
+                    (size.y + group.y - 1) / group.y);
+  });
+
+  destination.UnbindImage(DESTINATION_IMAGE);
+  source.Unbind();
+
+  gl::Barrier::TextureFetch();
+}
+
+}  // namespace over::post
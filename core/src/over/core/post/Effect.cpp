@@ -0,0 +1,164 @@
+#include <over/core/post/Effect.hpp>
+
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+namespace over::post {
+
+void Effect::Set(std::string_view parameter, float32 value) {
+  for (auto& [parameterName, parameterValue] : floats) {
+    if (parameterName == parameter) {
+      parameterValue = value;
+      return;
+    }
+  }
+  throw std::runtime_error(
+      fmt::format("Effect {} has no parameter {}", name, parameter));
+}
+
+void Effect::SetTexture(std::string_view parameter,
+                        gl::Texture2DView texture) {
+  for (auto& [parameterName, parameterTexture] : textures) {
+    if (parameterName == parameter) {
+      parameterTexture = texture;
+      return;
+    }
+  }
+  throw std::runtime_error(
+      fmt::format("Effect {} has no texture {}", name, parameter));
+}
+
+Effect Effect::ToneMap(float32 exposure) {
+  Effect effect;
+  effect.name = "tone map";
+  effect.code = "color.rgb = vec3(1.0) - exp(-color.rgb * $exposure);";
+  effect.floats = {{"exposure", exposure}};
+  return effect;
+}
+
+Effect Effect::Gamma(float32 gamma) {
+  Effect effect;
+  effect.name = "gamma";
+  effect.code =
+      "color.rgb = pow(max(color.rgb, vec3(0.0)), vec3(1.0 / $gamma));";
+  effect.floats = {{"gamma", gamma}};
+  return effect;
+}
+
+Effect Effect::ColorGrading(LutView lut, uint32 size, float32 intensity) {
+  Effect effect;
+  effect.name = "color grading";
+  // texel centers of the first and last entries map to 0 and 1
+  effect.code =
+      "vec3 coord = (clamp(color.rgb, 0.0, 1.0) * ($size - 1.0) + 0.5) / "
+      "$size;\n"
+      "color.rgb = mix(color.rgb, texture($lut, coord).rgb, $intensity);";
+  effect.floats = {{"size", static_cast<float32>(size)},
+                   {"intensity", intensity}};
+  effect.luts = {{"lut", lut}};
+  return effect;
+}
+
+Effect Effect::Vignette(float32 strength, float32 radius) {
+  Effect effect;
+  effect.name = "vignette";
+  effect.code =
+      "float edge = length(uv - 0.5) * 1.41421356;\n"
+      "color.rgb *= 1.0 - $strength * smoothstep($radius, 1.0, edge);";
+  effect.floats = {{"strength", strength}, {"radius", radius}};
+  return effect;
+}
+
+Effect Effect::Invert() {
+  Effect effect;
+  effect.name = "invert";
+  effect.code = "color.rgb = vec3(1.0) - color.rgb;";
+  return effect;
+}
+
+Effect Effect::BloomComposite(float32 intensity) {
+  Effect effect;
+  effect.name = "bloom";
+  // bilinear from half resolution
+  effect.code = "color.rgb += texture($bloom, uv).rgb * $intensity;";
+  effect.floats = {{"intensity", intensity}};
+  effect.textures = {{"bloom", gl::Texture2DView()}};
+  return effect;
+}
+
+Effect Effect::Fxaa(float32 span) {
+  Effect effect;
+  effect.name = "fxaa";
+  effect.sampling = true;
+  // perceptual luma of linear colors
+  effect.functions =
+      "float $Luma(vec3 color) {\n"
+      "\treturn sqrt(dot(color, vec3(0.299, 0.587, 0.114)));\n"
+      "}\n";
+  effect.code = R"(
+vec3 nw = texture(source, uv + vec2(-1.0, -1.0) * texelSize).rgb;
+vec3 ne = texture(source, uv + vec2(1.0, -1.0) * texelSize).rgb;
+vec3 sw = texture(source, uv + vec2(-1.0, 1.0) * texelSize).rgb;
+vec3 se = texture(source, uv + vec2(1.0, 1.0) * texelSize).rgb;
+float lumaNW = $Luma(nw);
+float lumaNE = $Luma(ne);
+float lumaSW = $Luma(sw);
+float lumaSE = $Luma(se);
+float lumaM = $Luma(color.rgb);
+float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+// perpendicular to the luma gradient, along the edge
+vec2 direction = vec2(lumaSW + lumaSE - lumaNW - lumaNE,
+                      lumaNW + lumaSW - lumaNE - lumaSE);
+float reduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.03125, 0.0078125);
+float scale = 1.0 / (min(abs(direction.x), abs(direction.y)) + reduce);
+direction = clamp(direction * scale, -$span, $span) * texelSize;
+vec3 inner = 0.5 * (texture(source, uv - direction / 6.0).rgb +
+                    texture(source, uv + direction / 6.0).rgb);
+vec3 outer = inner * 0.5 + 0.25 * (texture(source, uv - direction * 0.5).rgb +
+                                   texture(source, uv + direction * 0.5).rgb);
+// the wide blend crossed another edge, keep the narrow one
+float lumaOuter = $Luma(outer);
+color.rgb = lumaOuter < lumaMin || lumaOuter > lumaMax ? inner : outer;)";
+  effect.floats = {{"span", span}};
+  return effect;
+}
+
+Effect Effect::Upscale() {
+  Effect effect;
+  effect.name = "upscale";
+  effect.sampling = true;
+  // 4x4 taps in 5 bilinear fetches, the corners weigh almost nothing
+  effect.code = R"(
+vec2 position = uv / texelSize;
+vec2 center = floor(position - 0.5) + 0.5;
+vec2 f = position - center;
+vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+vec2 w3 = f * f * (-0.5 + 0.5 * f);
+vec2 w12 = w1 + w2;
+vec2 t0 = (center - 1.0) * texelSize;
+vec2 t3 = (center + 2.0) * texelSize;
+vec2 t12 = (center + w2 / w12) * texelSize;
+vec3 sum = texture(source, vec2(t12.x, t0.y)).rgb * (w12.x * w0.y) +
+           texture(source, vec2(t0.x, t12.y)).rgb * (w0.x * w12.y) +
+           texture(source, t12).rgb * (w12.x * w12.y) +
+           texture(source, vec2(t3.x, t12.y)).rgb * (w3.x * w12.y) +
+           texture(source, vec2(t12.x, t3.y)).rgb * (w12.x * w3.y);
+float weight = w12.x * w0.y + w0.x * w12.y + w12.x * w12.y + w3.x * w12.y +
+               w12.x * w3.y;
+// negative lobes overshoot at hard edges
+color.rgb = max(sum / weight, vec3(0.0));)";
+  return effect;
+}
+
+Effect Effect::Convolution(Kernel kernel) {
+  Effect effect;
+  effect.name = fmt::format("kernel {}x{}", kernel.GetSize(), kernel.GetSize());
+  effect.kernel = std::move(kernel);
+  return effect;
+}
+
+}  // namespace over::post
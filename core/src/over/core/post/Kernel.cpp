@@ -0,0 +1,93 @@
+#include <over/core/post/Kernel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/core.h>
+
+namespace over::post {
+
+Kernel::Kernel(uint32 size, std::vector<float32> weights)
+    : _size(size), _weights(std::move(weights)), _row(), _column() {
+  if (_size % 2 == 0 || _size > MAX_SIZE) {
+    throw std::runtime_error(fmt::format(
+        "Kernel size must be odd and at most {}, got {}", MAX_SIZE, _size));
+  }
+  if (_weights.size() != _size * _size) {
+    throw std::runtime_error(
+        fmt::format("Kernel of size {} needs {} weights, got {}", _size,
+                    _size * _size, _weights.size()));
+  }
+
+  Separate();
+}
+
+Kernel Kernel::Box(uint32 size) {
+  return Kernel(size, std::vector<float32>(size * size, 1.f / (size * size)));
+}
+
+Kernel Kernel::Gaussian(uint32 size, float32 sigma) {
+  if (sigma <= 0.f) {
+    sigma = std::max(size / 6.f, 0.5f);
+  }
+
+  int32 radius = static_cast<int32>(size / 2);
+  std::vector<float32> line(size);
+  float32 sum = 0.f;
+  for (int32 i = -radius; i <= radius; i++) {
+    line[i + radius] = std::exp(-0.5f * i * i / (sigma * sigma));
+    sum += line[i + radius];
+  }
+
+  std::vector<float32> weights(size * size);
+  for (uint32 y = 0; y < size; y++) {
+    for (uint32 x = 0; x < size; x++) {
+      weights[y * size + x] = line[y] * line[x] / (sum * sum);
+    }
+  }
+  return Kernel(size, std::move(weights));
+}
+
+Kernel Kernel::EdgeDetect() {
+  return Kernel(3, {1.f, 1.f, 1.f, 1.f, -8.f, 1.f, 1.f, 1.f, 1.f});
+}
+
+void Kernel::Separate() {
+  // the largest weight is the pivot: its row and column are the factors
+  usize pivot = 0;
+  for (usize i = 1; i < _weights.size(); i++) {
+    if (std::abs(_weights[i]) > std::abs(_weights[pivot])) {
+      pivot = i;
+    }
+  }
+
+  float32 largest = std::abs(_weights[pivot]);
+  if (largest == 0.f) {
+    return;
+  }
+
+  uint32 pivotX = static_cast<uint32>(pivot % _size);
+  uint32 pivotY = static_cast<uint32>(pivot / _size);
+
+  std::vector<float32> row(_size), column(_size);
+  for (uint32 i = 0; i < _size; i++) {
+    column[i] = _weights[i * _size + pivotX];
+    row[i] = _weights[pivotY * _size + i] / _weights[pivot];
+  }
+
+  for (uint32 y = 0; y < _size; y++) {
+    for (uint32 x = 0; x < _size; x++) {
+      float32 error = std::abs(_weights[y * _size + x] - column[y] * row[x]);
+      if (error > SEPARABLE_EPSILON * largest) {
+        return;
+      }
+    }
+  }
+
+  _row = std::move(row);
+  _column = std::move(column);
+}
+
+}  // namespace over::post
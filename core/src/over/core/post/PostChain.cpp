@@ -0,0 +1,278 @@
+#include <over/core/post/PostChain.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <stdexcept>
+#include <utility>
+
+#include <over/core/opengl/RenderStats.hpp>
+#include <over/core/opengl/Texture.hpp>
+
+#include <fmt/core.h>
+
+namespace over::post {
+
+namespace {
+
+constexpr std::string_view VERTEX_SOURCE = R"(#version 330 core
+
+layout (location = 0) in vec3 vPosition;
+layout (location = 2) in vec2 vTexCoord;
+
+out vec2 fTexCoord;
+
+void main() {
+	gl_Position = vec4(vPosition.x, vPosition.y, 0.0, 1.0);
+	fTexCoord = vTexCoord;
+}
+)";
+
+// Uniforms of the j-th effect of a pass are prefixed "n<j>_"
+std::string GetUniform(usize node, std::string_view parameter) {
+  return fmt::format("n{}_{}", node, parameter);
+}
+
+// $name -> n<j>_name
+std::string Substitute(std::string_view code, usize node) {
+  std::string result;
+  result.reserve(code.size() + 16);
+  for (usize i = 0; i < code.size(); i++) {
+    if (code[i] != '$') {
+      result += code[i];
+      continue;
+    }
+
+    usize end = i + 1;
+    while (end < code.size() &&
+           (std::isalnum(static_cast<unsigned char>(code[end])) ||
+            code[end] == '_')) {
+      end++;
+    }
+    result += GetUniform(node, code.substr(i + 1, end - i - 1));
+    i = end - 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+PostChain::PostChain(ConvolutionFilter* filter)
+    : _filter(filter),
+      _effects(),
+      _plan(),
+      _programs(),
+      _quad(Mesh::GenQuad({})),
+      _passes(0) {}
+
+usize PostChain::Add(Effect effect) {
+  if (effect.kernel && _filter == nullptr) {
+    throw std::runtime_error(fmt::format(
+        "Effect {} needs a convolution filter (OpenGL 4.3)", effect.name));
+  }
+
+  _effects.push_back(std::move(effect));
+  return _effects.size() - 1;
+}
+
+void PostChain::Plan() {
+  _plan.clear();
+
+  for (usize i = 0; i < _effects.size(); i++) {
+    const auto& effect = _effects[i];
+    if (!effect.enabled) {
+      continue;
+    }
+
+    if (effect.kernel) {
+      Pass pass;
+      pass.effects.push_back(i);
+      pass.kernel = true;
+      _plan.push_back(std::move(pass));
+    } else if (_plan.empty() || _plan.back().kernel ||
+               (effect.sampling && !_plan.back().effects.empty())) {
+      // sampling effects read the input of their pass
+      Pass pass;
+      pass.effects.push_back(i);
+      _plan.push_back(std::move(pass));
+    } else {
+      _plan.back().effects.push_back(i);
+    }
+  }
+
+  // kernels write images, an empty fused pass copies to the frame buffer
+  if (_plan.empty() || _plan.back().kernel) {
+    _plan.emplace_back();
+  }
+}
+
+std::string PostChain::Generate(const Pass& pass) const {
+  std::string uniforms;
+  std::string functions;
+  std::string body;
+
+  for (usize j = 0; j < pass.effects.size(); j++) {
+    const auto& effect = _effects[pass.effects[j]];
+
+    for (const auto& [name, value] : effect.floats) {
+      uniforms += fmt::format("uniform float {};\n", GetUniform(j, name));
+    }
+    for (const auto& [name, texture] : effect.textures) {
+      uniforms += fmt::format("uniform sampler2D {};\n", GetUniform(j, name));
+    }
+    for (const auto& [name, lut] : effect.luts) {
+      uniforms += fmt::format("uniform sampler3D {};\n", GetUniform(j, name));
+    }
+
+    if (!effect.functions.empty()) {
+      functions += fmt::format("\n{}", Substitute(effect.functions, j));
+    }
+
+    // own scope, effects may declare the same locals
+    body += fmt::format("\t// {}\n\t{{\n", effect.name);
+    auto code = Substitute(effect.code, j);
+    usize start = 0;
+    while (start < code.size()) {
+      usize end = code.find('\n', start);
+      if (end == std::string::npos) {
+        end = code.size();
+      }
+      body += fmt::format("\t\t{}\n", std::string_view(code).substr(
+                                          start, end - start));
+      start = end + 1;
+    }
+    body += "\t}\n";
+  }
+
+  return fmt::format(
+      "#version 330 core\n\n"
+      "out vec4 FragColor;\n\n"
+      "in vec2 fTexCoord;\n\n"
+      "uniform sampler2D source;\n"
+      "uniform vec2 texelSize;\n"
+      "{}{}\n"
+      "void main() {{\n"
+      "\tvec2 uv = fTexCoord;\n"
+      "\tvec4 color = texture(source, uv);\n\n"
+      "{}\n"
+      "\tFragColor = color;\n"
+      "}}\n",
+      uniforms, functions, body);
+}
+
+Shader& PostChain::GetProgram(const Pass& pass) {
+  auto found = _programs.find(pass.effects);
+  if (found != _programs.end()) {
+    return found->second;
+  }
+
+  auto shader = Shader::FromSource(VERTEX_SOURCE, Generate(pass));
+  return _programs.emplace(pass.effects, std::move(shader)).first->second;
+}
+
+void PostChain::Execute(graph::RenderTargetPool& pool,
+                        gl::Texture2DView source, glm::ivec2 size) {
+  Plan();
+  _passes = _plan.size();
+
+  // ping-pong targets of the passes before the last
+  std::array<graph::RenderTarget, 2> targets{graph::INVALID_TARGET,
+                                             graph::INVALID_TARGET};
+  for (usize i = 0; i < std::min<usize>(_plan.size() - 1, 2); i++) {
+    graph::RenderTargetDesc desc;
+    desc.format = GL_RGBA16F;
+    desc.width = static_cast<uint32>(size.x);
+    desc.height = static_cast<uint32>(size.y);
+    targets[i] = pool.Acquire(desc);
+
+    // sampling effects read between texels of their input
+    auto view = pool.GetTexture(targets[i]);
+    view.Bind();
+    view.SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    view.SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  }
+
+  // the last pass goes where the caller pointed
+  GLint frame = 0;
+  std::array<GLint, 4> viewport{};
+  glthrow(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &frame));
+  glthrow(glGetIntegerv(GL_VIEWPORT, viewport.data()));
+  glthrow(glDisable(GL_DEPTH_TEST));
+
+  source.Bind();
+  source.SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  source.SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  auto input = source;
+  usize target = 0;
+  for (usize i = 0; i < _plan.size(); i++) {
+    const auto& pass = _plan[i];
+
+    if (i + 1 == _plan.size()) {
+      glthrow(glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(frame)));
+      OVER_RENDER_STAT(frameBufferBinds, 1);
+      glthrow(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+      Draw(pass, input, size);
+      break;
+    }
+
+    auto output = pool.GetTexture(targets[target]);
+    if (pass.kernel) {
+      _filter->Apply(*_effects[pass.effects.front()].kernel, input, output,
+                     size, GL_RGBA16F);
+    } else {
+      graph::Attachment attachment;
+      attachment.target = targets[target];
+      pool.GetFrameBuffer({attachment}).Bind();
+      glthrow(glViewport(0, 0, size.x, size.y));
+      Draw(pass, input, size);
+    }
+
+    input = output;
+    target ^= 1;
+  }
+
+  // recycled by the next Acquire, this frame or later
+  for (auto pooled : targets) {
+    if (pooled != graph::INVALID_TARGET) {
+      pool.Release(pooled);
+    }
+  }
+}
+
+void PostChain::Draw(const Pass& pass, gl::Texture2DView source,
+                     glm::ivec2 size) {
+  auto& program = GetProgram(pass);
+
+  program.Use([&] {
+    gl::Texture::Activate(GL_TEXTURE0 + SOURCE_UNIT);
+    source.Bind();
+    program.SetInt("source", SOURCE_UNIT);
+    program.SetVec2f("texelSize", 1.f / glm::vec2(size));
+
+    usize unit = SOURCE_UNIT + 1;
+    for (usize j = 0; j < pass.effects.size(); j++) {
+      const auto& effect = _effects[pass.effects[j]];
+      for (const auto& [name, value] : effect.floats) {
+        program.SetFloat(GetUniform(j, name), value);
+      }
+      for (const auto& [name, texture] : effect.textures) {
+        gl::Texture::Activate(static_cast<GLenum>(GL_TEXTURE0 + unit));
+        texture.Bind();
+        program.SetInt(GetUniform(j, name), static_cast<int32>(unit));
+        unit++;
+      }
+      for (const auto& [name, lut] : effect.luts) {
+        gl::Texture::Activate(static_cast<GLenum>(GL_TEXTURE0 + unit));
+        lut.Bind();
+        program.SetInt(GetUniform(j, name), static_cast<int32>(unit));
+        unit++;
+      }
+    }
+    gl::Texture::Activate(GL_TEXTURE0);
+
+    _quad.Draw();
+  });
+}
+
+}  // namespace over::post
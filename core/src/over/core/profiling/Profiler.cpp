@@ -0,0 +1,340 @@
+#include <over/core/profiling/Profiler.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include <over/core/opengl/wrappers/Exception.hpp>
+
+#include <fmt/core.h>
+
+namespace over::profiling {
+
+namespace {
+
+int64 GetClock() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// JSON string contents
+std::string Escape(std::string_view text) {
+  std::string result;
+  result.reserve(text.size());
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      result += fmt::format("\\u{:04x}", c);
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+Profiler& Profiler::Instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+Profiler::Profiler()
+    : _enabled(true),
+      _epoch(GetClock()),
+      _threadsMutex(),
+      _threads(),
+      _namesMutex(),
+      _names(),
+      _frames(HISTORY),
+      _frameIndex(0),
+      _frameStart(0),
+      _tick(0),
+      _clockOffset(0),
+      _clockSync(0),
+      _gpuOpen(),
+      _gpuClosed(),
+      _inFlight(),
+      _freeQueries(),
+      _queries() {}
+
+void Profiler::SetEnabled(bool enabled) noexcept {
+  _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+int64 Profiler::Now() const noexcept {
+  return GetClock() - _epoch;
+}
+
+void Profiler::SetThreadName(std::string name) {
+  auto& thread = GetThread();
+  std::lock_guard lock(thread.mutex);
+  thread.name = std::move(name);
+}
+
+const char* Profiler::Intern(std::string_view name) {
+  // set nodes never move, the pointer stays valid
+  std::lock_guard lock(_namesMutex);
+  return _names.emplace(name).first->c_str();
+}
+
+Profiler::Thread& Profiler::GetThread() {
+  thread_local Thread* current = nullptr;
+  if (current == nullptr) {
+    std::lock_guard lock(_threadsMutex);
+    auto thread = std::make_unique<Thread>();
+    thread->id = static_cast<uint32>(_threads.size());
+    thread->name = fmt::format("thread {}", thread->id);
+    current = thread.get();
+    _threads.push_back(std::move(thread));
+  }
+  return *current;
+}
+
+void Profiler::BeginZone(const char* name) {
+  auto& thread = GetThread();
+  Zone zone;
+  zone.name = name;
+  zone.thread = thread.id;
+  zone.depth = static_cast<uint32>(thread.open.size());
+  zone.start = Now();
+  thread.open.push_back(zone);
+}
+
+void Profiler::EndZone() {
+  auto& thread = GetThread();
+  if (thread.open.empty()) {
+    return;
+  }
+
+  auto zone = thread.open.back();
+  thread.open.pop_back();
+  zone.end = Now();
+
+  std::lock_guard lock(thread.mutex);
+  thread.closed.push_back(zone);
+}
+
+GLuint Profiler::AcquireQuery() {
+  if (_freeQueries.empty()) {
+    // grows in blocks, a frame opens a few dozen zones at most
+    constexpr usize block = 64;
+    usize first = _queries.size();
+    _queries.resize(first + block);
+    glthrow(
+        glGenQueries(static_cast<GLsizei>(block), _queries.data() + first));
+    _freeQueries.assign(_queries.begin() + first, _queries.end());
+  }
+
+  GLuint query = _freeQueries.back();
+  _freeQueries.pop_back();
+  return query;
+}
+
+void Profiler::BeginGpuZone(const char* name) {
+  GpuQuery query;
+  query.name = name;
+  query.depth = static_cast<uint32>(_gpuOpen.size());
+  query.begin = AcquireQuery();
+  glthrow(glQueryCounter(query.begin, GL_TIMESTAMP));
+  _gpuOpen.push_back(query);
+}
+
+void Profiler::EndGpuZone() {
+  if (_gpuOpen.empty()) {
+    return;
+  }
+
+  auto query = _gpuOpen.back();
+  _gpuOpen.pop_back();
+  query.end = AcquireQuery();
+  glthrow(glQueryCounter(query.end, GL_TIMESTAMP));
+  _gpuClosed.push_back(query);
+}
+
+void Profiler::NextFrame() {
+  int64 now = Now();
+  // in-flight results come back on ticks, so they drain while disabled too
+  _tick++;
+  ReadGpu();
+
+  if (!IsEnabled()) {
+    // zones closed on the frame it was disabled belong to no frame
+    for (const auto& query : _gpuClosed) {
+      _freeQueries.push_back(query.begin);
+      _freeQueries.push_back(query.end);
+    }
+    _gpuClosed.clear();
+    _frameStart = now;
+    return;
+  }
+
+  auto& frame = _frames[_frameIndex % HISTORY];
+  frame.index = _frameIndex;
+  frame.start = _frameStart;
+  frame.end = now;
+  frame.cpu.clear();
+  frame.gpu.clear();
+  frame.gpuReady = _gpuClosed.empty();
+
+  {
+    std::lock_guard lock(_threadsMutex);
+    for (auto& thread : _threads) {
+      std::lock_guard threadLock(thread->mutex);
+      frame.cpu.insert(frame.cpu.end(), thread->closed.begin(),
+                       thread->closed.end());
+      thread->closed.clear();
+    }
+  }
+
+  if (!_gpuClosed.empty()) {
+    InFlight flight;
+    flight.frame = _frameIndex;
+    flight.tick = _tick;
+    flight.offset = GetClockOffset();
+    flight.queries = std::move(_gpuClosed);
+    _gpuClosed.clear();
+    _inFlight.push_back(std::move(flight));
+  }
+
+  _frameIndex++;
+  _frameStart = now;
+}
+
+int64 Profiler::GetClockOffset() {
+  if (_tick >= _clockSync) {
+    // the current GPU time, it does not wait for queued commands
+    GLint64 gpu = 0;
+    glthrow(glGetInteger64v(GL_TIMESTAMP, &gpu));
+    _clockOffset = Now() - static_cast<int64>(gpu);
+    _clockSync = _tick + HISTORY;
+  }
+  return _clockOffset;
+}
+
+void Profiler::ReadGpu() {
+  while (!_inFlight.empty()) {
+    auto& flight = _inFlight.front();
+    if (flight.tick + GPU_LATENCY > _tick) {
+      return;
+    }
+
+    // end timestamps land in issue order, the last one covers the frame
+    GLint available = 0;
+    glGetQueryObjectiv(flight.queries.back().end, GL_QUERY_RESULT_AVAILABLE,
+                       &available);
+    if (available == 0) {
+      return;
+    }
+
+    // the frame may have left the ring while its results were late
+    Frame* frame = flight.frame + HISTORY > _frameIndex
+                       ? &_frames[flight.frame % HISTORY]
+                       : nullptr;
+    for (const auto& query : flight.queries) {
+      GLuint64 begin = 0;
+      GLuint64 end = 0;
+      glGetQueryObjectui64v(query.begin, GL_QUERY_RESULT, &begin);
+      glGetQueryObjectui64v(query.end, GL_QUERY_RESULT, &end);
+      _freeQueries.push_back(query.begin);
+      _freeQueries.push_back(query.end);
+
+      if (frame != nullptr) {
+        Zone zone;
+        zone.name = query.name;
+        zone.thread = GPU_THREAD;
+        zone.depth = query.depth;
+        zone.start = static_cast<int64>(begin) + flight.offset;
+        zone.end = static_cast<int64>(end) + flight.offset;
+        frame->gpu.push_back(zone);
+      }
+    }
+    if (frame != nullptr) {
+      frame->gpuReady = true;
+    }
+
+    _inFlight.pop_front();
+  }
+}
+
+usize Profiler::GetFrameCount() const noexcept {
+  return std::min(_frameIndex, HISTORY);
+}
+
+const Frame& Profiler::GetFrame(usize age) const {
+  if (age >= GetFrameCount()) {
+    throw std::runtime_error(
+        fmt::format("Profiler keeps {} frames, {} requested", GetFrameCount(),
+                    age));
+  }
+  return _frames[(_frameIndex - 1 - age) % HISTORY];
+}
+
+const Frame* Profiler::GetLatestComplete() const noexcept {
+  for (usize age = 0; age < GetFrameCount(); age++) {
+    const auto& frame = _frames[(_frameIndex - 1 - age) % HISTORY];
+    if (frame.gpuReady) {
+      return &frame;
+    }
+  }
+  return nullptr;
+}
+
+std::string Profiler::ExportTrace() const {
+  std::string events;
+  auto append = [&](std::string event) {
+    if (!events.empty()) {
+      events += ",\n";
+    }
+    events += event;
+  };
+
+  uint32 gpuThread = 0;
+  {
+    std::lock_guard lock(_threadsMutex);
+    for (const auto& thread : _threads) {
+      std::lock_guard threadLock(thread->mutex);
+      append(fmt::format(
+          R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"{}"}}}})",
+          thread->id, Escape(thread->name)));
+    }
+    gpuThread = static_cast<uint32>(_threads.size());
+  }
+  append(fmt::format(
+      R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"GPU"}}}})",
+      gpuThread));
+  append(fmt::format(
+      R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"frames"}}}})",
+      gpuThread + 1));
+
+  // complete events, microseconds
+  auto zone = [&](const Zone& zone, uint32 thread, std::string_view category) {
+    append(fmt::format(
+        R"({{"name":"{}","cat":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+        Escape(zone.name), category, thread,
+        static_cast<float64>(zone.start) / 1e3,
+        static_cast<float64>(zone.end - zone.start) / 1e3));
+  };
+
+  for (usize age = GetFrameCount(); age-- > 0;) {
+    const auto& frame = GetFrame(age);
+    append(fmt::format(
+        R"({{"name":"frame {}","cat":"frame","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+        frame.index, gpuThread + 1, static_cast<float64>(frame.start) / 1e3,
+        static_cast<float64>(frame.end - frame.start) / 1e3));
+    for (const auto& cpu : frame.cpu) {
+      zone(cpu, cpu.thread, "cpu");
+    }
+    for (const auto& gpu : frame.gpu) {
+      zone(gpu, gpuThread, "gpu");
+    }
+  }
+
+  return fmt::format("{{\"traceEvents\":[\n{}\n],\"displayTimeUnit\":\"ms\"}}\n",
+                     events);
+}
+
+}  // namespace over::profiling
@@ -6,7 +6,16 @@
 #include <fmt/core.h>
 
 namespace over {
-Context::Context(int32 major, int32 minor) {
+Context::Context(int32 major, int32 minor, Backend backend)
+    : _backend(backend) {
+  if (IsHeadless()) {
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4)
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#else
+    throw std::runtime_error("Headless contexts need GLFW 3.4 or newer");
+#endif
+  }
+
   auto err = glfwInit();
   if (err != GLFW_TRUE) {
     throw std::runtime_error("Failed to initialize GLFW");
@@ -15,6 +24,13 @@ Context::Context(int32 major, int32 minor) {
   glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, major);
   glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minor);
   glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+  if (IsHeadless()) {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, _backend == Backend::EGL
+                                                  ? GLFW_EGL_CONTEXT_API
+                                                  : GLFW_OSMESA_CONTEXT_API);
+  }
 }
 
 Context::~Context() {
@@ -26,6 +42,10 @@ void Context::LoadOpenGL(Window& window) {
   if (gladLoadGLLoader((GLADloadproc)glfwGetProcAddress) == 0) {
     throw std::runtime_error("Failed to initialize OpenGL context\n");
   }
+
+  if (IsHeadless()) {
+    window.CreateOffscreen();
+  }
 }
 
 void Context::Viewport(uint32 x, uint32 y, uint32 width, uint32 height) {
@@ -57,6 +77,19 @@ void Context::SetStencilTest(bool value) {
   Toggle(GL_STENCIL_TEST, value);
 }
 
+void Context::SetDepthWrite(bool value) {
+  glDepthMask(value ? GL_TRUE : GL_FALSE);
+}
+
+void Context::SetDepthFunc(GLenum func) {
+  glDepthFunc(func);
+}
+
+void Context::SetColorWrite(bool value) {
+  GLboolean mask = value ? GL_TRUE : GL_FALSE;
+  glColorMask(mask, mask, mask, mask);
+}
+
 static GLenum GetBit(GLenum name, GLbitfield bit) {
   if (glIsEnabled(name)) {
     return bit;
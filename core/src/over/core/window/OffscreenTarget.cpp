@@ -0,0 +1,49 @@
+#include <over/core/window/OffscreenTarget.hpp>
+
+#include <over/core/opengl/DefaultFrameBuffer.hpp>
+#include <over/core/opengl/views/FrameBufferView.hpp>
+#include <over/core/opengl/views/RenderBufferView.hpp>
+
+namespace over {
+
+OffscreenTarget::OffscreenTarget(uint32 width, uint32 height)
+    : _width(0), _height(0), _color(), _depth(), _frame() {
+  Resize(width, height);
+
+  auto frame = _frame.As<gl::FrameBufferTarget::FRAMEBUFFER>();
+  frame.Bind();
+  frame.Attach(GL_COLOR_ATTACHMENT0,
+               _color.As<gl::RenderBufferTarget::RENDER_BUFFER>());
+  frame.Attach(GL_DEPTH_STENCIL_ATTACHMENT,
+               _depth.As<gl::RenderBufferTarget::RENDER_BUFFER>());
+  frame.ReadyOrThrow("Cannot create offscreen frame buffer");
+
+  // stays bound, as the window frame buffer would be
+  gl::SetDefaultFrameBuffer(GetId());
+}
+
+OffscreenTarget::~OffscreenTarget() {
+  if (gl::GetDefaultFrameBuffer() == GetId()) {
+    gl::SetDefaultFrameBuffer(0);
+  }
+}
+
+void OffscreenTarget::Resize(uint32 width, uint32 height) {
+  if (width == _width && height == _height) {
+    return;
+  }
+  _width = width;
+  _height = height;
+
+  // attachments survive storage reallocation
+  auto reserve = [&](gl::RenderBufferWrapper<>& buffer, GLenum format) {
+    auto view = buffer.As<gl::RenderBufferTarget::RENDER_BUFFER>();
+    view.Bind();
+    view.Reserve(format, width, height);
+    view.Unbind();
+  };
+  reserve(_color, GL_RGBA8);
+  reserve(_depth, GL_DEPTH24_STENCIL8);
+}
+
+}  // namespace over
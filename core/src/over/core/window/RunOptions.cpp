@@ -0,0 +1,77 @@
+#include <over/core/window/RunOptions.hpp>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <fmt/core.h>
+
+namespace over {
+
+namespace {
+
+std::string_view GetVariable(const char* name) {
+  const char* value = std::getenv(name);
+  return value != nullptr ? value : "";
+}
+
+RunOptions& GetStorage() {
+  static RunOptions options = RunOptions::FromEnvironment();
+  return options;
+}
+
+}  // namespace
+
+const RunOptions& RunOptions::Get() {
+  return GetStorage();
+}
+
+void RunOptions::Set(RunOptions options) {
+  GetStorage() = std::move(options);
+}
+
+RunOptions RunOptions::FromEnvironment() {
+  RunOptions options;
+
+  auto backend = GetVariable("OVER_BACKEND");
+  if (backend.empty() || backend == "window") {
+    options.backend = Backend::WINDOW;
+  } else if (backend == "egl") {
+    options.backend = Backend::EGL;
+  } else if (backend == "osmesa") {
+    options.backend = Backend::OSMESA;
+  } else {
+    throw std::runtime_error(fmt::format(
+        "Unknown OVER_BACKEND {}, expected window, egl or osmesa", backend));
+  }
+
+  auto frames = GetVariable("OVER_FRAMES");
+  if (!frames.empty()) {
+    char* end = nullptr;
+    std::string text(frames);
+    auto value = std::strtoull(text.c_str(), &end, 10);
+    if (end != text.c_str() + text.size()) {
+      throw std::runtime_error(
+          fmt::format("OVER_FRAMES {} is not a frame count", frames));
+    }
+    options.frames = static_cast<usize>(value);
+  }
+
+  options.capture = GetVariable("OVER_CAPTURE");
+
+  auto delta = GetVariable("OVER_FIXED_DELTA");
+  if (!delta.empty()) {
+    char* end = nullptr;
+    std::string text(delta);
+    auto value = std::strtof(text.c_str(), &end);
+    if (end != text.c_str() + text.size() || value < 0.f) {
+      throw std::runtime_error(
+          fmt::format("OVER_FIXED_DELTA {} is not a duration", delta));
+    }
+    options.fixedDelta = value;
+  }
+  return options;
+}
+
+}  // namespace over
@@ -1,11 +1,15 @@
 #include <over/core/window/Window.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <utility>
 
 #include <over/core/Includes.hpp>
 #include <over/core/Types.hpp>
+#include <over/core/opengl/DefaultFrameBuffer.hpp>
+#include <over/core/opengl/wrappers/Exception.hpp>
+#include <over/core/window/OffscreenTarget.hpp>
 
 namespace over {
 Window::Window(uint32 width, uint32 height, const char* title,
@@ -19,7 +23,8 @@ Window::Window(uint32 width, uint32 height, const char* title,
   SetSwapInterval(swapInterval);
 }
 
-Window::Window(GLFWwindow* ptr) : _ptr(ptr), _swapInterval(0) {}
+Window::Window(GLFWwindow* ptr)
+    : _swapInterval(0), _ptr(ptr), _offscreen(nullptr) {}
 
 Window::Window(Window&& other) noexcept : Window(nullptr) {
   *this = std::move(other);
@@ -30,15 +35,19 @@ Window& Window::operator=(Window&& other) noexcept {
     return *this;
   }
 
+  // the offscreen frame buffer dies with the context of its window
+  _offscreen.reset();
   if (_ptr != nullptr) {
     glfwDestroyWindow(_ptr);
   }
   _ptr = std::exchange(other._ptr, nullptr);
+  _offscreen = std::move(other._offscreen);
 
   return *this;
 }
 
 Window::~Window() {
+  _offscreen.reset();
   if (_ptr != nullptr) {
     glfwDestroyWindow(_ptr);
   }
@@ -61,8 +70,11 @@ uint32 Window::GetWidth() const noexcept {
 }
 
 void Window::SetWidth(uint32 width) {
-  glfwSetWindowSize(_ptr, static_cast<int>(width),
-                    static_cast<int>(GetHeight()));
+  uint32 height = GetHeight();
+  glfwSetWindowSize(_ptr, static_cast<int>(width), static_cast<int>(height));
+  if (_offscreen != nullptr) {
+    _offscreen->Resize(width, height);
+  }
 }
 
 uint32 Window::GetHeight() const noexcept {
@@ -71,8 +83,11 @@ uint32 Window::GetHeight() const noexcept {
 }
 
 void Window::SetHeight(uint32 height) {
-  glfwSetWindowSize(_ptr, static_cast<int>(GetWidth()),
-                    static_cast<int>(height));
+  uint32 width = GetWidth();
+  glfwSetWindowSize(_ptr, static_cast<int>(width), static_cast<int>(height));
+  if (_offscreen != nullptr) {
+    _offscreen->Resize(width, height);
+  }
 }
 
 float32 Window::GetAspectRatio() const noexcept {
@@ -105,7 +120,51 @@ void Window::SetSwapInterval(int32 swapInterval) {
 }
 
 void Window::SwapBuffers() const noexcept {
+  if (_offscreen != nullptr) {
+    glFlush();
+    return;
+  }
+
   glfwSwapInterval(_swapInterval);
   glfwSwapBuffers(_ptr);
 }
+
+void Window::CreateOffscreen() {
+  auto [width, height] = GetSize();
+  _offscreen = std::make_unique<OffscreenTarget>(width, height);
+}
+
+host::Image2D Window::ReadPixels() const {
+  auto [width, height] = GetSize();
+  constexpr usize channels = 4;
+  usize stride = width * channels;
+
+  GLint previous = 0;
+  GLint alignment = 0;
+  glthrow(glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous));
+  glthrow(glGetIntegerv(GL_PACK_ALIGNMENT, &alignment));
+  glthrow(glBindFramebuffer(GL_READ_FRAMEBUFFER, gl::GetDefaultFrameBuffer()));
+  // per frame buffer state, read after binding
+  GLint readBuffer = 0;
+  glthrow(glGetIntegerv(GL_READ_BUFFER, &readBuffer));
+  glthrow(glReadBuffer(_offscreen != nullptr ? GL_COLOR_ATTACHMENT0 : GL_BACK));
+  glthrow(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+
+  std::vector<std::byte> pixels(stride * height);
+  glthrow(glReadPixels(0, 0, static_cast<GLsizei>(width),
+                       static_cast<GLsizei>(height), GL_RGBA,
+                       GL_UNSIGNED_BYTE, pixels.data()));
+
+  glthrow(glReadBuffer(static_cast<GLenum>(readBuffer)));
+  glthrow(glPixelStorei(GL_PACK_ALIGNMENT, alignment));
+  glthrow(glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previous)));
+
+  // GL rows go bottom to top
+  for (usize row = 0; row < height / 2; row++) {
+    std::swap_ranges(pixels.begin() + row * stride,
+                     pixels.begin() + (row + 1) * stride,
+                     pixels.end() - (row + 1) * stride);
+  }
+  return host::Image2D(width, height, channels, pixels.data());
+}
 }  // namespace over
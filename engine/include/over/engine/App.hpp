@@ -4,6 +4,7 @@
 
 #include <over/core/Types.hpp>
 #include <over/core/window/Context.hpp>
+#include <over/core/window/RunOptions.hpp>
 #include <over/core/window/Window.hpp>
 #include <over/engine/Input.hpp>
 
@@ -13,10 +14,13 @@ class App {
  public:
   static App& Instance();
 
-  App(std::string name);
+  // Compute shaders & storage buffers need at least 4.3
+  App(std::string name, int32 glMajor = 3, int32 glMinor = 3);
 
   virtual ~App();
 
+  // Until the window closes, or for RunOptions::frames frames. Update gets
+  // RunOptions::fixedDelta when it is set
   void Run(int32 width, int32 height, int32 swapInterval = 0);
 
   virtual void Init() = 0;
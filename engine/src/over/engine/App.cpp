@@ -1,6 +1,8 @@
 #include <over/engine/App.hpp>
 
 #include <fmt/core.h>
+#include <over/core/opengl/RenderStats.hpp>
+#include <over/core/profiling/Profiler.hpp>
 #include <over/utils/Interval.hpp>
 
 namespace over {
@@ -11,8 +13,12 @@ App& App::Instance() {
   return *s_App;
 }
 
-App::App(std::string name)
-    : _name(std::move(name)), _ctx(), _window(nullptr), _input(), _fps(0) {
+App::App(std::string name, int32 glMajor, int32 glMinor)
+    : _name(std::move(name)),
+      _ctx(glMajor, glMinor),
+      _window(nullptr),
+      _input(),
+      _fps(0) {
   assert(s_App == nullptr);
   s_App = this;
 }
@@ -24,31 +30,53 @@ void App::Run(int32 width, int32 height, int32 swapInterval) {
                    _name.c_str(), swapInterval);
   _ctx.LoadOpenGL(_window);
 
-  float32 startTime = 0;         // loop has not started yet
-  float32 deltaTime = 1 / 60.f;  // 60 frames per second
+  // OVER_FRAMES, OVER_CAPTURE and OVER_FIXED_DELTA, see RunOptions
+  const auto& options = RunOptions::Get();
+  bool fixed = options.fixedDelta > 0.f;
+
+  float32 startTime = 0;  // loop has not started yet
+  // 60 frames per second
+  float32 deltaTime = fixed ? options.fixedDelta : 1 / 60.f;
 
   int32 fpsCounter = 0;
   Interval fpsInterval(static_cast<float32>(glfwGetTime()), 1.f);
 
+  OVER_PROFILE_THREAD("main");
   Init();
 
-  while (!_window.ShouldClose()) {
+  usize frame = 0;
+
+  while (!_window.ShouldClose() && !options.IsDone(frame)) {
+    OVER_PROFILE_FRAME();
+    OVER_RENDER_STATS_FRAME();
     startTime = static_cast<float32>(glfwGetTime());
 
     _input.Poll();
     _ctx.ClearAll();
 
-    Update(deltaTime);
+    {
+      OVER_PROFILE_ZONE("update");
+      Update(deltaTime);
+    }
 
     _ctx.ThrowErrors();
     _input.Flush();
-    _window.SwapBuffers();
+    if (options.IsCaptured(frame)) {
+      _window.ReadPixels().ToFile(options.capture);
+    }
+    {
+      // waits for the GPU when it is behind
+      OVER_PROFILE_ZONE("swap");
+      _window.SwapBuffers();
+    }
 
     float32 endTime = glfwGetTime();
 
-    deltaTime = endTime - startTime;
+    // deterministic runs replay the same simulation steps
+    deltaTime = fixed ? options.fixedDelta : endTime - startTime;
 
     fpsCounter++;
+    frame++;
 
     if (fpsInterval.Check(endTime)) {
       _fps = fpsCounter;
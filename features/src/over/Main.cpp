@@ -1,38 +1,90 @@
 #include <over/engine/App.hpp>
 #include <over/engine/Core.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
 #include <memory>
+#include <random>
+#include <string_view>
 
 #include <stb_image.h>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <over/core/Camera.hpp>
 #include <over/core/Mesh.hpp>
 #include <over/core/Model.hpp>
 #include <over/core/Shader.hpp>
-#include <over/core/opengl/Framebuffer.hpp>
+#include <over/core/culling/HiZCuller.hpp>
+#include <over/core/graph/DynamicResolution.hpp>
+#include <over/core/graph/RenderGraph.hpp>
+#include <over/core/lighting/CascadedShadowMap.hpp>
+#include <over/core/lighting/ClusteredLights.hpp>
+#include <over/core/lighting/GBuffer.hpp>
+#include <over/core/opengl/RenderStats.hpp>
+#include <over/core/opengl/TimerQuery.hpp>
 #include <over/core/opengl/views/FrameBufferView.hpp>
-#include <over/core/opengl/views/RenderBufferView.hpp>
+#include <over/core/post/Bloom.hpp>
+#include <over/core/post/ConvolutionFilter.hpp>
+#include <over/core/post/Effect.hpp>
+#include <over/core/post/Kernel.hpp>
+#include <over/core/post/PostChain.hpp>
+#include <over/core/profiling/Profiler.hpp>
 
 namespace over {
 
 class FeaturesApp : public App {
  public:
+  // world space, pointing from the sun
+  inline static const glm::vec3 SUN_DIRECTION{-0.3f, -1.f, -0.2f};
+
   FeaturesApp()
       : App("features"),
         _baseShader(),
-        _screenShader(),
         _skyboxShader(),
 
-        _frame(),
+        _graph(),
+        _exportedMode(-1),
 
-        _frameColor(),
         _cubeMap(),
         _cubeMapTexturesNames({"right.jpg", "left.jpg", "top.jpg", "bottom.jpg",
                                "front.jpg", "back.jpg"}),
 
-        _frameDepth(),
-        _quad(),
         _model(nullptr),
+        _culler(nullptr),
+        _occlusionCulling(true),
+        _fieldTransforms(),
+        _fieldBounds(),
+
+        _gBuffer(),
+        _lights(),
+        _lightAnchors(),
+        _fullscreenQuad(),
+        _shadows(nullptr),
+        _shadowModel(1.f),
+        _deferred(false),
+        _deferredReady(false),
+
+        _filter(nullptr),
+        _chain(nullptr),
+        _bloom(nullptr),
+        _lut(),
+        _edgeEffect(0),
+        _blurEffect(0),
+        _bloomEffect(0),
+        _invertEffect(0),
+        _fxaaEffect(0),
+        _upscaleEffect(0),
+        _blurred(false),
+        _negative(false),
+        _bloomEnabled(true),
+        _antiAliasing(AntiAliasing::MSAA4),
+        _maxSamples(0),
+        _resolution(),
+        _dynamicResolution(true),
+        _tracePressed(false),
+        _statsPressed(false),
 
         _camera({0.f, 0.f, 3.f}, {0.f, 0.f, 0.f}, 25.f, 45.f, 16.f / 9.f),
         _cameraBuffer(),
@@ -40,9 +92,11 @@ class FeaturesApp : public App {
         //_camera({0.f, 0.f, 3.f}, {0.f, 0.f, 0.f}, 25.f, 90.f, 1.f),
 
         _elapsedTime(0.f),
+        _time(0.f),
         _explode(0.f),
 
         _debug(false),
+        _depthPrepass(true),
 
         _windowWidth(),
         _windowHeight() {}
@@ -57,57 +111,6 @@ class FeaturesApp : public App {
     _windowWidth = width;
     _windowHeight = height;
 
-    _frameColor.As<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE>(
-        [&](gl::TextureView<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE> self) {
-          self.Reserve2DMultisample(GL_RGB, 4, true, width, height, GL_RGB,
-                                    GL_UNSIGNED_BYTE, nullptr);
-        });
-
-    _frameDepth.As<gl::RenderBufferTarget::RENDER_BUFFER>(
-        [&](gl::RenderBufferView<gl::RenderBufferTarget::RENDER_BUFFER> self) {
-          self.ReserveMultisample(4, GL_DEPTH24_STENCIL8, width, height);
-        });
-
-    _frame.As<gl::FrameBufferTarget::FRAMEBUFFER>(
-        [&](gl::FrameBufferView<gl::FrameBufferTarget::FRAMEBUFFER> self) {
-          self.Attach(
-              GL_COLOR_ATTACHMENT0,
-              _frameColor.As<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE>(), 0);
-          self.Attach(GL_DEPTH_STENCIL_ATTACHMENT,
-                      _frameDepth.As<gl::RenderBufferTarget::RENDER_BUFFER>());
-
-          self.ReadyOrThrow("Cannot create frame buffer");
-        });
-
-    _middlewareColor.As<gl::TextureTarget::TEXTURE_2D>(
-        [&](gl::TextureView<gl::TextureTarget::TEXTURE_2D> self) {
-          self.Reserve2D(GL_RGB, width, height, GL_RGB, GL_UNSIGNED_BYTE,
-                         nullptr);
-          self.GenerateMipmap();
-
-          self.SetParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-          self.SetParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-          self.SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-          self.SetParameter(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-        });
-
-    _middlewareDepth.As<gl::RenderBufferTarget::RENDER_BUFFER>(
-        [&](gl::RenderBufferView<gl::RenderBufferTarget::RENDER_BUFFER> self) {
-          self.Reserve(GL_DEPTH24_STENCIL8, width, height);
-        });
-
-    _middlewareFrame.As<gl::FrameBufferTarget::FRAMEBUFFER>(
-        [&](gl::FrameBufferView<gl::FrameBufferTarget::FRAMEBUFFER> self) {
-          self.Attach(GL_COLOR_ATTACHMENT0,
-                      _middlewareColor.As<gl::TextureTarget::TEXTURE_2D>(), 0);
-          self.Attach(
-              GL_DEPTH_STENCIL_ATTACHMENT,
-              _middlewareDepth.As<gl::RenderBufferTarget::RENDER_BUFFER>());
-
-          self.ReadyOrThrow("Cannot create middleware frame buffer");
-        });
-
     _camera.SetAspectRatio(width * 1.f / height);
 
     _cubeMap.As<gl::TextureTarget::TEXTURE_CUBE_MAP>([&](gl::CubeMapView self) {
@@ -130,15 +133,9 @@ class FeaturesApp : public App {
     _baseShader = Shader("shaders/DimensionVertex.shader",
                          "shaders/DimensionFragment.shader",
                          "shaders/DimensionGeometry.shader");
-    _screenShader =
-        Shader("shaders/ScreenVertex.shader", "shaders/ScreenFragment.shader");
-
-    _quad = Mesh::GenQuad(
-        {MeshTexture(_middlewareColor.As<gl::TextureTarget::TEXTURE_2D>(),
-                     MeshTexture::Type::DIFFUSE)});
-
     _model = std::make_unique<Model>(
         "resources/backpack/backpack.obj");  // std::make_unique<Model>("resources/cube/cube.glb");
+    _model->SetModelUniform("model");
 
     // TODO: make some "shape" class
     constexpr std::array<float32,
@@ -209,27 +206,579 @@ class FeaturesApp : public App {
           self.BindBase(0);
         });
 
-    _screenBuffer.As<gl::BufferTarget::UNIFORM_BUFFER>(
-        [&](gl::BufferView<gl::BufferTarget::UNIFORM_BUFFER> self) {
-          auto vec2isz = sizeof(glm::i32vec2);
-          self.Reserve(vec2isz, nullptr, GL_STATIC_DRAW);
-          auto sz = glm::i32vec2(_windowWidth, _windowHeight);
-          self.Write(0, vec2isz, glm::value_ptr(sz));
-          self.BindBase(1);
-        });
-
     _baseShader.BindUniform("Camera", 0);
     _skyboxShader.BindUniform("Camera", 0);
 
-    _screenShader.BindUniform("Screen", 1);
+    _depthShader =
+        Shader("shaders/DepthVertex.shader", "shaders/DepthFragment.shader");
+    _depthShader.BindUniform("Camera", 0);
 
     _debugShader = Shader("shaders/NormalDebugVertex.shader",
                           "shaders/NormalDebugFragment.shader",
                           "shaders/NormalDebugGeometry.shader");
 
+    // compute shaders and indirect draws
+    if (GLAD_GL_VERSION_4_3) {
+      InitCulling();
+      InitDeferred();
+      _filter = std::make_unique<post::ConvolutionFilter>(
+          "shaders/KernelSeparableCompute.shader",
+          "shaders/KernelTiledCompute.shader");
+    } else {
+      fmt::println(
+          "occlusion culling, deferred shading and compute kernels need "
+          "OpenGL 4.3, disabled");
+    }
+
+    InitPost();
+
+    glthrow(glGetIntegerv(GL_MAX_SAMPLES, &_maxSamples));
     glthrow(glEnable(GL_MULTISAMPLE));
   }
 
+  // Screen effects, the point-wise ones run fused in one pass. Kernels need
+  // the compute filter
+  void InitPost() {
+    _chain = std::make_unique<post::PostChain>(_filter.get());
+
+    if (_filter) {
+      _edgeEffect =
+          _chain->Add(post::Effect::Convolution(post::Kernel::EdgeDetect()));
+      _blurEffect = _chain->Add(post::Effect::Convolution(
+          post::Kernel::Gaussian(post::Kernel::MAX_SIZE)));
+    }
+
+    // first, so it smooths the scene before anything reads neighbours; it
+    // starts the fused pass and costs no pass of its own
+    _fxaaEffect = _chain->Add(post::Effect::Fxaa());
+    // starts the last pass, which draws at the window size
+    _upscaleEffect = _chain->Add(post::Effect::Upscale());
+
+    // half resolution mip chain from the pool of the graph, added before
+    // grading so it takes the grade too
+    _bloom = std::make_unique<post::Bloom>(
+        "shaders/ScreenVertex.shader", "shaders/BloomDownsampleFragment.shader",
+        "shaders/BloomUpsampleFragment.shader", post::Bloom::Quality::MEDIUM);
+    _bloomEffect = _chain->Add(post::Effect::BloomComposite());
+
+    // slightly warm, lifted shadows
+    constexpr uint32 lutSize = 16;
+    _lut = post::CreateLut(lutSize, [](glm::vec3 color) {
+      color = glm::mix(glm::vec3(0.03f), glm::vec3(1.f), color);
+      return color * glm::vec3(1.04f, 1.f, 0.94f);
+    });
+
+    _chain->Add(post::Effect::ColorGrading(
+        _lut.As<gl::TextureTarget::TEXTURE_3D>(), lutSize));
+    _chain->Add(post::Effect::Vignette(0.35f));
+    _invertEffect = _chain->Add(post::Effect::Invert());
+    _chain->Add(post::Effect::Gamma());
+  }
+
+  // Field of model copies behind the main model, rows hide each other
+  void InitCulling() {
+    constexpr int32 side = 32;
+    constexpr float32 spacing = 6.f;
+
+    _instancedShader = Shader("shaders/InstancedVertex.shader",
+                              "shaders/InstancedFragment.shader");
+    _instancedShader.BindUniform("Camera", 0);
+
+    std::vector<over::Instance> instances;
+    std::vector<AABB> bounds;
+    instances.reserve(side * side);
+    bounds.reserve(side * side);
+
+    for (int32 z = 0; z < side; z++) {
+      for (int32 x = 0; x < side; x++) {
+        glm::vec3 position((x - side / 2) * spacing, -4.f,
+                           -10.f - z * spacing);
+        auto model = glm::translate(glm::mat4(1.f), position);
+        glm::vec4 color(0.5f + 0.5f * x / side, 0.5f + 0.5f * z / side, 0.75f,
+                        1.f);
+
+        instances.emplace_back(model, color, 0);
+        bounds.push_back(_model->GetBounds().Transformed(model));
+      }
+    }
+
+    // static shadow casters
+    for (const auto& instance : instances) {
+      _fieldTransforms.push_back(instance.model);
+    }
+    _fieldBounds = bounds;
+
+    _culler = std::make_unique<culling::HiZCuller>(
+        "shaders/HiZPyramidCompute.shader", "shaders/HiZCullCompute.shader");
+    _culler->SetObjects(*_model, std::move(instances), bounds);
+  }
+
+  // G-buffer of the same scene, lit by point lights wandering over the field
+  void InitDeferred() {
+    constexpr usize count = 512;
+
+    _gBuffer.Resize(_windowWidth, _windowHeight);
+
+    _gBufferShader = Shader("shaders/DimensionVertex.shader",
+                            "shaders/GBufferFragment.shader");
+    _gBufferShader.BindUniform("Camera", 0);
+    _gBufferInstancedShader = Shader("shaders/InstancedVertex.shader",
+                                     "shaders/GBufferInstancedFragment.shader");
+    _gBufferInstancedShader.BindUniform("Camera", 0);
+    _deferredShader = Shader("shaders/ScreenVertex.shader",
+                             "shaders/DeferredLightingFragment.shader");
+    _fullscreenQuad = Mesh::GenQuad({});
+
+    _shadows = std::make_unique<lighting::CascadedShadowMap>(
+        "shaders/ShadowVertex.shader", "shaders/DepthFragment.shader");
+    _shadows->SetShadowDistance(120.f);
+
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float32> unit(0.f, 1.f);
+
+    auto& lights = _lights.GetLights();
+    for (usize i = 0; i < count; i++) {
+      _lightAnchors.emplace_back((unit(random) - 0.5f) * 200.f,
+                                 -2.f + unit(random) * 4.f,
+                                 5.f - unit(random) * 200.f);
+
+      lighting::PointLight light;
+      light.position = _lightAnchors.back();
+      light.radius = 6.f + unit(random) * 6.f;
+      light.color = glm::vec3(unit(random), unit(random), unit(random));
+      light.intensity = 8.f;
+      lights.push_back(light);
+    }
+
+    _deferredReady = true;
+  }
+
+  // Because _ctx.ClearAll() only cleans enabled tests
+  void ClearFrame() {
+    _ctx.SetClearColor({0.f, 0.5f, 0.5f, 1.f});
+
+    _ctx.SetFaceCulling(true);
+    _ctx.SetDepthTest(true);
+    _ctx.SetStencilTest(true);
+
+    _ctx.ClearAll();
+
+    _ctx.SetFaceCulling(false);
+    _ctx.SetDepthTest(false);
+    _ctx.SetStencilTest(false);
+  }
+
+  // Passes of this frame. The scene targets are transient graph resources:
+  // the graph allocates them at the window size, resolves the multisampled
+  // depth for phase 2 culling and the color for the screen pass
+  void BuildGraph() {
+    _graph.Reset(_windowWidth, _windowHeight,
+                 _dynamicResolution ? _resolution.GetScale() : 1.f);
+    // the G-buffer is not pooled, it follows the scaled extent here
+    if (_deferredReady) {
+      _gBuffer.Resize(_graph.GetWidth(), _graph.GetHeight());
+    }
+
+    graph::TextureDesc colorDesc;
+    colorDesc.format = GL_RGB8;
+    colorDesc.samples = GetSamples();
+    graph::TextureDesc depthDesc;
+    depthDesc.format = GL_DEPTH24_STENCIL8;
+    depthDesc.samples = GetSamples();
+    depthDesc.renderBuffer = true;
+
+    auto color = _graph.Create("color", colorDesc);
+    auto depth = _graph.Create("depth", depthDesc);
+    auto backBuffer = _graph.ImportBackBuffer();
+
+    if (_deferred) {
+      AddDeferredPasses(color, depth);
+    } else {
+      AddForwardPasses(color, depth);
+    }
+
+    // Skybox rendering (after model for optimization)
+    _graph.AddPass(
+        "sky",
+        [&](graph::PassBuilder& builder) {
+          builder.Write(color, GL_COLOR_ATTACHMENT0);
+          builder.Write(depth, GL_DEPTH_STENCIL_ATTACHMENT);
+        },
+        [this](graph::PassContext&) { RenderSky(); });
+
+    _graph.AddPass(
+        "screen",
+        [&](graph::PassBuilder& builder) {
+          builder.Read(color);
+          builder.Write(backBuffer);
+        },
+        [this, color](graph::PassContext& context) {
+          RenderScreen(context.GetTexture(color));
+        });
+
+    _graph.Compile();
+  }
+
+  void AddForwardPasses(graph::Resource color, graph::Resource depth) {
+    _graph.AddPass(
+        "forward",
+        [&](graph::PassBuilder& builder) {
+          builder.Write(color, GL_COLOR_ATTACHMENT0);
+          builder.Write(depth, GL_DEPTH_STENCIL_ATTACHMENT);
+        },
+        [this](graph::PassContext&) { RenderForward(); });
+
+    // Phase 2 tests against depth of everything drawn so far
+    if (_culler) {
+      _graph.AddPass(
+          "revealed",
+          [&](graph::PassBuilder& builder) {
+            builder.Read(depth);
+            builder.Write(color, GL_COLOR_ATTACHMENT0);
+            builder.Write(depth, GL_DEPTH_STENCIL_ATTACHMENT);
+          },
+          [this, depth](graph::PassContext& context) {
+            RenderRevealed(context.GetTexture(depth),
+                           glm::ivec2(context.GetWidth(), context.GetHeight()));
+          });
+    }
+  }
+
+  // Geometry into the G-buffer, then one fullscreen pass shades every pixel
+  // with the lights of its cluster. Explode and reflections are forward only
+  void AddDeferredPasses(graph::Resource color, graph::Resource depth) {
+    auto width = _gBuffer.GetWidth();
+    auto height = _gBuffer.GetHeight();
+    auto albedo = _graph.Import(
+        "gAlbedoSpecular",
+        _gBuffer.GetTarget(lighting::GBuffer::ALBEDO_SPECULAR), width, height);
+    auto normal = _graph.Import(
+        "gNormal", _gBuffer.GetTarget(lighting::GBuffer::NORMAL), width,
+        height);
+    auto gDepth = _graph.Import("gDepth", _gBuffer.GetDepth(), width, height);
+    // a texture array, the graph only orders its writer and reader
+    auto shadowMap = _graph.Import(
+        "shadowMap", gl::Texture2DView(_shadows->GetTexture().Get()),
+        _shadows->GetResolution(), _shadows->GetResolution());
+
+    // both render into their own frame buffers
+    _graph.AddPass(
+        "shadows",
+        [&](graph::PassBuilder& builder) { builder.Write(shadowMap); },
+        [this](graph::PassContext&) { RenderShadows(); });
+
+    _graph.AddPass(
+        "gbuffer",
+        [&](graph::PassBuilder& builder) {
+          builder.Write(albedo);
+          builder.Write(normal);
+          builder.Write(gDepth);
+        },
+        [this](graph::PassContext&) { RenderGeometry(); });
+
+    _graph.AddPass(
+        "lighting",
+        [&](graph::PassBuilder& builder) {
+          builder.Read(albedo);
+          builder.Read(normal);
+          builder.Read(gDepth);
+          builder.Read(shadowMap);
+          builder.Write(color, GL_COLOR_ATTACHMENT0);
+          builder.Write(depth, GL_DEPTH_STENCIL_ATTACHMENT);
+        },
+        [this](graph::PassContext& context) {
+          RenderLighting(glm::ivec2(context.GetWidth(), context.GetHeight()));
+        });
+  }
+
+  void RenderForward() {
+    ClearFrame();
+
+    _ctx.SetFaceCulling(true);
+    _ctx.SetDepthTest(true);
+
+    // Depth pre-pass: reflection/refraction is shaded once per pixel.
+    // Explode moves vertices in the geometry shader, depth would differ
+    bool prepass = _depthPrepass && _explode == 0.f;
+    if (prepass) {
+      _depthTimer.Begin();
+      _depthShader.Use([&] {
+        _ctx.SetColorWrite(false);
+        _model->DrawDepth(_depthShader);
+        _ctx.SetColorWrite(true);
+      });
+      _depthTimer.End();
+
+      _ctx.SetDepthFunc(GL_EQUAL);
+      _ctx.SetDepthWrite(false);
+    }
+
+    // Model rendering
+    _colorTimer.Begin();
+    _baseShader.Use([&] {
+      _baseShader.SetVec3f("cameraPosition", _camera.GetPosition());
+
+      gl::Texture::Activate(GL_TEXTURE0 + 2);
+      _baseShader.SetInt("skybox", 2);
+      _baseShader.SetBool("doReflect", _reflectFlag);
+      _baseShader.SetFloat("time", _explode);
+      _cubeMap.As<gl::TextureTarget::TEXTURE_CUBE_MAP>(
+          [&] { _model->Draw(); });
+    });
+    _colorTimer.End();
+
+    if (prepass) {
+      _ctx.SetDepthFunc(GL_LESS);
+      _ctx.SetDepthWrite(true);
+    }
+
+    // Occlusion culled field, phase 1: visible last frame
+    if (_culler) {
+      _ctx.SetFaceCulling(true);
+      _ctx.SetDepthTest(true);
+      _culler->DrawVisible(_instancedShader, _camera.GetViewProjection());
+    }
+  }
+
+  // size of the pooled target, it lags the window while it is resized
+  void RenderRevealed(gl::Texture2DView depth, glm::ivec2 size) {
+    _ctx.SetFaceCulling(true);
+    _ctx.SetDepthTest(true);
+    _culler->SetOcclusionTest(_occlusionCulling);
+    _culler->DrawRevealed(_instancedShader, depth, size);
+  }
+
+  void RenderShadows() {
+    // the field is drawn relative to the model, rotating it moves the field
+    auto model = _model->GetTransform().GetModel();
+    if (model != _shadowModel) {
+      _shadowModel = model;
+      _shadows->InvalidateStatic();
+    }
+
+    _shadowTimer.Begin();
+    _shadows->Update(
+        _camera, SUN_DIRECTION,
+        [&](Shader& shader, const Frustum& frustum) {
+          for (usize i = 0; i < _fieldTransforms.size(); i++) {
+            if (frustum.Intersects(_fieldBounds[i])) {
+              _model->DrawDepth(shader, _fieldTransforms[i]);
+            }
+          }
+        },
+        [&](Shader& shader, const Frustum&) { _model->DrawDepth(shader); });
+    _shadowTimer.End();
+  }
+
+  void RenderGeometry() {
+    auto& lights = _lights.GetLights();
+    for (usize i = 0; i < lights.size(); i++) {
+      float32 angle = _time * 0.5f + i;
+      lights[i].position =
+          _lightAnchors[i] + glm::vec3(std::cos(angle), 0.f, std::sin(angle)) *
+                                 4.f;
+    }
+    _lights.Update(_camera);
+
+    _geometryTimer.Begin();
+    _gBuffer.Render([&] {
+      _ctx.SetFaceCulling(true);
+      _ctx.SetDepthTest(true);
+
+      _gBufferShader.Use([&] { _model->Draw(); });
+
+      // both phases write the G-buffer, phase 2 tests against its depth
+      if (_culler) {
+        _culler->SetOcclusionTest(_occlusionCulling);
+        _culler->DrawVisible(_gBufferInstancedShader,
+                             _camera.GetViewProjection());
+        _culler->DrawRevealed(
+            _gBufferInstancedShader, _gBuffer.GetDepth(),
+            glm::ivec2(_gBuffer.GetWidth(), _gBuffer.GetHeight()));
+      }
+    });
+    _geometryTimer.End();
+  }
+
+  void RenderLighting(glm::ivec2 size) {
+    // texels are read 1:1: geometry must have been framed to the same scaled
+    // extent, not to the window
+    assert(size == glm::ivec2(_gBuffer.GetWidth(), _gBuffer.GetHeight()));
+
+    _lightingTimer.Begin();
+    ClearFrame();
+
+    // writes G-buffer depth, so the skybox and debug passes still test
+    _ctx.SetDepthTest(true);
+    _ctx.SetDepthFunc(GL_ALWAYS);
+
+    _deferredShader.Use([&] {
+      _gBuffer.BindTextures(_deferredShader);
+      // clusters are tiles of the target the pass renders to
+      _lights.Bind(_deferredShader, size);
+      _shadows->Bind(_deferredShader, _camera.GetSnapshot().inverseView);
+
+      _deferredShader.SetMatrix4f("inverseProjection",
+                                  _camera.GetSnapshot().inverseProjection);
+      _deferredShader.SetVec3f(
+          "lightDirection",
+          glm::vec3(_camera.GetView() * glm::vec4(SUN_DIRECTION, 0.f)));
+      _deferredShader.SetVec3f("lightColor", glm::vec3(0.35f));
+      _deferredShader.SetVec3f("ambientColor", glm::vec3(0.05f));
+      _deferredShader.SetFloat("shininess", 32.f);
+
+      _fullscreenQuad.Draw();
+    });
+
+    _ctx.SetDepthFunc(GL_LESS);
+    _lightingTimer.End();
+  }
+
+  void RenderSky() {
+    _skyboxShader.Use([&] {
+      _ctx.SetDepthTest(true);
+      glDepthFunc(GL_LEQUAL);
+
+      _skyboxLayout.As<gl::LayoutTarget::VERTEX_ARRAY>([&] {
+        _cubeMap.As<gl::TextureTarget::TEXTURE_CUBE_MAP>(
+            [&] { glDrawArrays(GL_TRIANGLES, 0, 36); });
+      });
+      OVER_RENDER_STAT(drawCalls, 1);
+      OVER_RENDER_STAT(triangles, 12);
+      OVER_RENDER_STAT(instances, 1);
+
+      glDepthFunc(GL_LESS);
+    });
+
+    if (_debug) {
+      _debugShader.Use([&] {
+        _debugShader.SetFloat("magnitude", 0.4f);
+
+        _model->Draw();
+      });
+    }
+  }
+
+  // Breakdown of the newest frame with GPU times, graph passes are GPU zones
+  void PrintProfile() const {
+    const auto* frame = profiling::Profiler::Instance().GetLatestComplete();
+    if (frame == nullptr) {
+      return;
+    }
+
+    float64 gpu = 0.0;
+    const profiling::Zone* slowest = nullptr;
+    for (const auto& zone : frame->gpu) {
+      if (zone.depth == 0) {
+        gpu += zone.GetMilliseconds();
+        if (!slowest || zone.GetMilliseconds() > slowest->GetMilliseconds()) {
+          slowest = &zone;
+        }
+      }
+    }
+
+    fmt::println("profile: frame {} {:.3f} ms, gpu passes {:.3f} ms{}",
+                 frame->index, frame->GetMilliseconds(), gpu,
+                 slowest ? fmt::format(", slowest {} {:.3f} ms", slowest->name,
+                                       slowest->GetMilliseconds())
+                         : std::string());
+  }
+
+  // Driver work of the last frame and its costliest graph pass
+  void PrintRenderStats() const {
+    const auto& stats = gl::RenderStats::Instance();
+    if (stats.GetFrameCount() == 0) {
+      return;
+    }
+
+    const auto& frame = stats.GetFrame();
+    fmt::println(
+        "gl: {} draws, {} triangles, {} instances, {} dispatches, binds: {} "
+        "programs, {} layouts, {} textures, {} frame buffers, {} uniforms, "
+        "uploads: {} B buffers, {} B textures, objects: +{} -{}",
+        frame.drawCalls, frame.triangles, frame.instances, frame.dispatches,
+        frame.programBinds, frame.layoutBinds, frame.textureBinds,
+        frame.frameBufferBinds, frame.uniformCalls, frame.bufferBytes,
+        frame.textureBytes, frame.created, frame.destroyed);
+
+    const gl::PassCounters* busiest = nullptr;
+    for (const auto& pass : stats.GetPasses()) {
+      if (!busiest || pass.counters.drawCalls > busiest->counters.drawCalls) {
+        busiest = &pass;
+      }
+    }
+    if (busiest) {
+      fmt::println("gl: most draws in {}: {} draws, {} triangles",
+                   busiest->name, busiest->counters.drawCalls,
+                   busiest->counters.triangles);
+    }
+  }
+
+  // Samples of the scene targets, FXAA runs on a single sampled frame
+  uint32 GetSamples() const {
+    uint32 samples = 0;
+    switch (_antiAliasing) {
+      case AntiAliasing::MSAA2:
+        samples = 2;
+        break;
+      case AntiAliasing::MSAA4:
+        samples = 4;
+        break;
+      case AntiAliasing::MSAA8:
+        samples = 8;
+        break;
+      default:
+        return 0;
+    }
+    return std::min(samples, static_cast<uint32>(_maxSamples));
+  }
+
+  std::string_view GetAntiAliasingName() const {
+    switch (_antiAliasing) {
+      case AntiAliasing::MSAA2:
+        return "msaa x2";
+      case AntiAliasing::MSAA4:
+        return "msaa x4";
+      case AntiAliasing::MSAA8:
+        return "msaa x8";
+      case AntiAliasing::FXAA:
+        return "fxaa";
+      default:
+        return "off";
+    }
+  }
+
+  // to default screen framebuffer, color has the graph extent
+  void RenderScreen(gl::Texture2DView color) {
+    if (_filter) {
+      _chain->Get(_edgeEffect).enabled = _inverted && !_blurred;
+      _chain->Get(_blurEffect).enabled = _blurred;
+    }
+    _chain->Get(_invertEffect).enabled = _negative;
+    _chain->Get(_fxaaEffect).enabled = _antiAliasing == AntiAliasing::FXAA;
+
+    glm::ivec2 size(_graph.GetWidth(), _graph.GetHeight());
+    _chain->Get(_upscaleEffect).enabled =
+        size != glm::ivec2(_windowWidth, _windowHeight);
+
+    auto& pool = _graph.GetPool();
+
+    auto& bloom = _chain->Get(_bloomEffect);
+    bloom.enabled = false;
+    if (_bloomEnabled) {
+      _bloomTimer.Begin();
+      auto texture = _bloom->Render(pool, color, size);
+      _bloomTimer.End();
+
+      // nothing to composite for tiny windows
+      bloom.enabled = _bloom->GetLevels() > 0;
+      bloom.SetTexture("bloom", texture);
+    }
+
+    _chain->Execute(pool, color, size);
+    _bloom->Release(pool);
+  }
+
   void Update(float32 dt) override {
 #pragma region Input
     if (Input::Instance().IsPressed(Input::Key::ESCAPE)) {
@@ -251,32 +800,78 @@ class FeaturesApp : public App {
     constexpr float32 rotationSpeed = glm::radians(0.25f);
 
     if (Input::Instance().IsPressed(Input::Key::Y)) {
-      _model->GetTransform().rotation.x += rotationSpeed;
+      _model->GetTransform().Rotate(rotationSpeed, glm::vec3(1, 0, 0));
     }
 
     if (Input::Instance().IsPressed(Input::Key::H)) {
-      _model->GetTransform().rotation.x -= rotationSpeed;
+      _model->GetTransform().Rotate(-rotationSpeed, glm::vec3(1, 0, 0));
     }
 
     if (Input::Instance().IsPressed(Input::Key::J)) {
-      _model->GetTransform().rotation.y += rotationSpeed;
+      _model->GetTransform().Rotate(rotationSpeed, glm::vec3(0, 1, 0));
     }
 
     if (Input::Instance().IsPressed(Input::Key::G)) {
-      _model->GetTransform().rotation.y -= rotationSpeed;
+      _model->GetTransform().Rotate(-rotationSpeed, glm::vec3(0, 1, 0));
     }
 
     if (Input::Instance().IsPressed(Input::Key::N)) {
-      _model->GetTransform().rotation.z += rotationSpeed;
+      _model->GetTransform().Rotate(rotationSpeed, glm::vec3(0, 0, 1));
     }
 
     if (Input::Instance().IsPressed(Input::Key::B)) {
-      _model->GetTransform().rotation.z -= rotationSpeed;
+      _model->GetTransform().Rotate(-rotationSpeed, glm::vec3(0, 0, 1));
     }
 
-    _inverted = Input::Instance().IsPressed(Input::Key::LEFT_SHIFT);
+    bool inverted = Input::Instance().IsPressed(Input::Key::LEFT_SHIFT);
+    bool blurred = Input::Instance().IsPressed(Input::Key::K);
+    // kernels only run as compute passes, there is no fragment fallback
+    if (!_filter && ((inverted && !_inverted) || (blurred && !_blurred))) {
+      fmt::println("edge detection and blur need OpenGL 4.3, unavailable");
+    }
+    _inverted = inverted;
+    _blurred = blurred;
+    _negative = Input::Instance().IsPressed(Input::Key::I);
+    _bloomEnabled = !Input::Instance().IsPressed(Input::Key::L);
     _reflectFlag = Input::Instance().IsPressed(Input::Key::Q);
     _debug = Input::Instance().IsPressed(Input::Key::TAB);
+    _occlusionCulling = !Input::Instance().IsPressed(Input::Key::O);
+    _depthPrepass = !Input::Instance().IsPressed(Input::Key::P);
+    _deferred = _deferredReady && Input::Instance().IsPressed(Input::Key::F);
+    _dynamicResolution = !Input::Instance().IsPressed(Input::Key::U);
+
+    // once per press, the trace covers the last Profiler::HISTORY frames
+    bool tracePressed = Input::Instance().IsPressed(Input::Key::F12);
+    if (tracePressed && !_tracePressed) {
+      std::ofstream("profile.json")
+          << profiling::Profiler::Instance().ExportTrace();
+      fmt::println("profile.json written");
+    }
+    _tracePressed = tracePressed;
+
+    bool statsPressed = Input::Instance().IsPressed(Input::Key::F11);
+    if (statsPressed && !_statsPressed) {
+      std::ofstream("render_stats.csv")
+          << gl::RenderStats::Instance().ExportCsv();
+      fmt::println("render_stats.csv written");
+    }
+    _statsPressed = statsPressed;
+
+    if (Input::Instance().IsPressed(Input::Key::_1)) {
+      _antiAliasing = AntiAliasing::NONE;
+    }
+    if (Input::Instance().IsPressed(Input::Key::_2)) {
+      _antiAliasing = AntiAliasing::MSAA2;
+    }
+    if (Input::Instance().IsPressed(Input::Key::_4)) {
+      _antiAliasing = AntiAliasing::MSAA4;
+    }
+    if (Input::Instance().IsPressed(Input::Key::_8)) {
+      _antiAliasing = AntiAliasing::MSAA8;
+    }
+    if (Input::Instance().IsPressed(Input::Key::_0)) {
+      _antiAliasing = AntiAliasing::FXAA;
+    }
 #pragma endregion
 
     _camera.UpdatePositionCallback(_window.Get(), dt);
@@ -289,78 +884,83 @@ class FeaturesApp : public App {
           self.Write(matsz, matsz, glm::value_ptr(_camera.GetView()));
         });
 
-    _frame.As<gl::FrameBufferTarget::FRAMEBUFFER>([&]() {
-      _ctx.SetClearColor({0.f, 0.5f, 0.5f, 1.f});
-
-      // Because _ctx.ClearAll() only cleans enabled tests
-      _ctx.SetFaceCulling(true);
-      _ctx.SetDepthTest(true);
-      _ctx.SetStencilTest(true);
-
-      _ctx.ClearAll();
-
-      _ctx.SetFaceCulling(false);
-      _ctx.SetDepthTest(false);
-      _ctx.SetStencilTest(false);
-
-      // Model rendering
-      _baseShader.Use([&] {
-        _ctx.SetFaceCulling(true);
-        _ctx.SetDepthTest(true);
-
-        _baseShader.SetMatrix4f("model", _model->GetTransform().GetModel());
-        _baseShader.SetVec3f("cameraPosition", _camera.GetPosition());
-
-        gl::Texture::Activate(GL_TEXTURE0 + 2);
-        _baseShader.SetInt("skybox", 2);
-        _baseShader.SetBool("doReflect", _reflectFlag);
-        _baseShader.SetFloat("time", _explode);
-        _cubeMap.As<gl::TextureTarget::TEXTURE_CUBE_MAP>(
-            [&] { _model->Draw(); });
-      });
-
-      // Skybox rendering (after model for optimization)
-      _skyboxShader.Use([&] {
-        _ctx.SetDepthTest(true);
-        glDepthFunc(GL_LEQUAL);
-
-        _skyboxLayout.As<gl::LayoutTarget::VERTEX_ARRAY>([&] {
-          _cubeMap.As<gl::TextureTarget::TEXTURE_CUBE_MAP>(
-              [&] { glDrawArrays(GL_TRIANGLES, 0, 36); });
-        });
-
-        glDepthFunc(GL_LESS);
-      });
-
-      if (_debug) {
-        _debugShader.Use([&] {
-          _debugShader.SetMatrix4f("model", _model->GetTransform().GetModel());
-          _debugShader.SetFloat("magnitude", 0.4f);
-
-          _model->Draw();
-        });
-      }
-    });
-
-    gl::FrameBuffer::Copy(
-        _frame, _middlewareFrame, {0, 0, _windowWidth, _windowHeight},
-        {0, 0, _windowWidth, _windowHeight}, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-    // to default screen framebuffer
-    _screenShader.Use([&]() {
-      _ctx.SetClearColor({1.f, 1.f, 1.f, 1.f});
-      _ctx.SetDepthTest(false);
-      _ctx.ClearAll();
-
-      _screenShader.SetBool("material.inverted", _inverted);
+    _time += dt;
+    BuildGraph();
+    _frameTimer.Begin();
+    _graph.Execute();
+    _frameTimer.End();
+
+    if (_dynamicResolution &&
+        _resolution.Update(_frameTimer.GetMilliseconds())) {
+      fmt::println("resolution: {:.0f}% ({}x{}), {:.2f} ms for {:.2f} ms",
+                   _resolution.GetScale() * 100.f,
+                   std::lround(_windowWidth * _resolution.GetScale()),
+                   std::lround(_windowHeight * _resolution.GetScale()),
+                   _resolution.GetAverage(), _resolution.GetTarget());
+    }
 
-      _quad.Draw();
-    });
+    // one dump per mode, the deferred graph has more passes
+    if (_exportedMode != static_cast<int32>(_deferred)) {
+      _exportedMode = static_cast<int32>(_deferred);
+      std::ofstream("render_graph.dot") << _graph.ExportDot();
+    }
 
     _elapsedTime += dt;
     if (_elapsedTime >= 1.f) {
       _elapsedTime = 0.f;
       fmt::println("fps: {}", _fps);
+      fmt::println(
+          "graph: {} passes, {} culled, {} transient targets in {} textures, "
+          "pool: {} targets, {} allocations",
+          _graph.GetPassCount(), _graph.GetCulledPasses(),
+          _graph.GetTransientResources(), _graph.GetPhysicalResources(),
+          _graph.GetPool().GetTargetCount(), _graph.GetPool().GetAllocations());
+      fmt::println("post: {} passes, {} cached programs",
+                   _chain->GetPassCount(), _chain->GetProgramCount());
+      PrintProfile();
+      PrintRenderStats();
+      // pool memory includes targets of the last mode until they idle out
+      fmt::println("aa: {}, targets {:.1f} MiB, frame {:.3f} ms",
+                   GetAntiAliasingName(),
+                   _graph.GetPool().GetMemory() / (1024.0 * 1024.0),
+                   _frameTimer.GetMilliseconds());
+      if (_bloomEnabled) {
+        fmt::println("bloom: {:.3f} ms, {} levels",
+                     _bloomTimer.GetMilliseconds(), _bloom->GetLevels());
+      }
+      if (_filter && (_inverted || _blurred)) {
+        fmt::println("kernel: {}, {} taps per pixel",
+                     _filter->GetMethod() ==
+                             post::ConvolutionFilter::Method::SEPARABLE
+                         ? "separable"
+                         : "tiled",
+                     _filter->GetTaps());
+      }
+      if (_deferred) {
+        fmt::println(
+            "deferred: geometry {:.3f} ms, lighting {:.3f} ms, {} of {} lights "
+            "visible, {} cluster entries",
+            _geometryTimer.GetMilliseconds(), _lightingTimer.GetMilliseconds(),
+            _lights.GetVisibleLights(), _lights.GetLights().size(),
+            _lights.GetIndexCount());
+        fmt::println(
+            "shadows: {:.3f} ms, {} of {} cascades updated, {} static renders",
+            _shadowTimer.GetMilliseconds(), _shadows->GetUpdatedCascades(),
+            _shadows->GetCascadeCount(), _shadows->GetStaticRenders());
+      } else {
+        fmt::println("depth pre-pass: {}, {:.3f} ms, color pass: {:.3f} ms",
+                     _depthPrepass ? "on" : "off",
+                     _depthPrepass ? _depthTimer.GetMilliseconds() : 0.0,
+                     _colorTimer.GetMilliseconds());
+      }
+
+      if (_culler) {
+        const auto& statistics = _culler->GetStatistics();
+        fmt::println(
+            "objects: {}, frustum culled: {}, occlusion culled: {}, drawn: {}",
+            statistics.objects, statistics.frustumCulled,
+            statistics.occlusionCulled, statistics.visible);
+      }
     }
 
     auto [width, height] = _window.GetSize();
@@ -371,70 +971,101 @@ class FeaturesApp : public App {
 
       _camera.SetAspectRatio(width * 1.0 / height);
 
-      _frameColor.As<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE>(
-          [&](gl::TextureView<gl::TextureTarget::TEXTURE_2D_MULTISAMPLE> self) {
-            self.Reserve2DMultisample(GL_RGB, 4, true, width, height, GL_RGB,
-                                      GL_UNSIGNED_BYTE, nullptr);
-          });
+      // frame targets come from the graph pool, which follows the new size
+      // once the window stops changing for a few frames
 
-      _frameDepth.As<gl::RenderBufferTarget::RENDER_BUFFER>(
-          [&](gl::RenderBufferView<gl::RenderBufferTarget::RENDER_BUFFER>
-                  self) {
-            self.ReserveMultisample(4, GL_DEPTH24_STENCIL8, width, height);
-          });
-
-      _middlewareColor.As<gl::TextureTarget::TEXTURE_2D>(
-          [&](gl::TextureView<gl::TextureTarget::TEXTURE_2D> self) {
-            self.Reserve2D(GL_RGB, width, height, GL_RGB, GL_UNSIGNED_BYTE,
-                           nullptr);
-            self.GenerateMipmap();
-          });
-
-      _middlewareDepth.As<gl::RenderBufferTarget::RENDER_BUFFER>(
-          [&](gl::RenderBufferView<gl::RenderBufferTarget::RENDER_BUFFER>
-                  self) { self.Reserve(GL_DEPTH24_STENCIL8, width, height); });
-
-      _screenBuffer.As<gl::BufferTarget::UNIFORM_BUFFER>(
+      // aspect ratio changed, lighting reconstructs positions with it
+      _cameraBuffer.As<gl::BufferTarget::UNIFORM_BUFFER>(
           [&](gl::BufferView<gl::BufferTarget::UNIFORM_BUFFER> self) {
-            auto sz = glm::i32vec2(width, height);
-            self.Write(0, sizeof(glm::i32vec2), glm::value_ptr(sz));
+            self.Write(0, sizeof(glm::mat4),
+                       glm::value_ptr(_camera.GetProjection()));
           });
     }
   }
 
  private:
   Shader _baseShader;
-  Shader _screenShader;
   Shader _skyboxShader;
   Shader _debugShader;
+  Shader _instancedShader;
+  Shader _depthShader;
+  Shader _gBufferShader;
+  Shader _gBufferInstancedShader;
+  Shader _deferredShader;
+
+  gl::TimerQuery _depthTimer;
+  gl::TimerQuery _colorTimer;
+  gl::TimerQuery _geometryTimer;
+  gl::TimerQuery _lightingTimer;
+  gl::TimerQuery _shadowTimer;
+  gl::TimerQuery _bloomTimer;
+  // whole graph, the timers above nest in it
+  gl::TimerQuery _frameTimer;
 
   gl::BufferWrapper<> _skyboxBuffer;
   gl::LayoutWrapper<> _skyboxLayout;
 
-  gl::TextureWrapper<> _frameColor;
-  gl::RenderBufferWrapper<> _frameDepth;
-  gl::FrameBufferWrapper<> _frame;
-
-  gl::TextureWrapper<> _middlewareColor;
-  gl::RenderBufferWrapper<> _middlewareDepth;
-  gl::FrameBufferWrapper<> _middlewareFrame;
+  graph::RenderGraph _graph;
+  // mode of the last render_graph.dot, -1 before the first
+  int32 _exportedMode;
 
   gl::TextureWrapper<> _cubeMap;
   std::array<std::string, 6> _cubeMapTexturesNames;
 
-  Mesh _quad;
   std::unique_ptr<Model> _model;
+  std::unique_ptr<culling::HiZCuller> _culler;
+  bool _occlusionCulling;
+  std::vector<glm::mat4> _fieldTransforms;
+  std::vector<AABB> _fieldBounds;
+
+  lighting::GBuffer _gBuffer;
+  lighting::ClusteredLights _lights;
+  std::vector<glm::vec3> _lightAnchors;
+  Mesh _fullscreenQuad;
+  std::unique_ptr<lighting::CascadedShadowMap> _shadows;
+  glm::mat4 _shadowModel;
+  bool _deferred;
+  bool _deferredReady;
+
+  std::unique_ptr<post::ConvolutionFilter> _filter;
+  std::unique_ptr<post::PostChain> _chain;
+  std::unique_ptr<post::Bloom> _bloom;
+  gl::TextureWrapper<> _lut;
+  usize _edgeEffect;
+  usize _blurEffect;
+  usize _bloomEffect;
+  usize _invertEffect;
+  usize _fxaaEffect;
+  usize _upscaleEffect;
+  bool _blurred;
+  bool _negative;
+  bool _bloomEnabled;
+
+  enum class AntiAliasing { NONE, MSAA2, MSAA4, MSAA8, FXAA };
+  AntiAliasing _antiAliasing;
+  GLint _maxSamples;
+
+  // scene at a lower resolution when the frame is over budget, post
+  // effects upscale it to the window
+  graph::DynamicResolution _resolution;
+  bool _dynamicResolution;
+
+  // F12 state of the last update, traces are written on press
+  bool _tracePressed;
+  // F11, writes the kept render stats as CSV
+  bool _statsPressed;
 
   Camera _camera;
   gl::BufferWrapper<> _cameraBuffer;
-  gl::BufferWrapper<> _screenBuffer;
 
   float32 _elapsedTime;
+  float32 _time;
 
   bool _inverted = false;
   bool _reflectFlag = false;
   float32 _explode;
   bool _debug;
+  bool _depthPrepass;
 
   uint32 _windowWidth, _windowHeight;
 };
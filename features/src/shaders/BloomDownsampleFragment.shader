@@ -0,0 +1,54 @@
+#version 330 core
+
+out vec4 FragColor;
+
+in vec2 fTexCoord;
+
+uniform sampler2D source;
+uniform vec2 texelSize;
+
+// first level only: keeps what is brighter than the threshold
+uniform bool prefilter;
+uniform float threshold;
+uniform float knee;
+
+vec3 Prefilter(vec3 color) {
+	// quadratic curve through the knee, linear above it
+	float brightness = max(color.r, max(color.g, color.b));
+	float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+	soft = soft * soft / (4.0 * knee);
+	return color * max(soft, brightness - threshold) / max(brightness, 1e-4);
+}
+
+vec3 Fetch(vec2 offset) {
+	return texture(source, fTexCoord + offset * texelSize).rgb;
+}
+
+void main() {
+	// 13 bilinear taps: a box in the center and four overlapping around it,
+	// stable under motion unlike a single 2x2 box
+	vec3 a = Fetch(vec2(-2.0, 2.0));
+	vec3 b = Fetch(vec2(0.0, 2.0));
+	vec3 c = Fetch(vec2(2.0, 2.0));
+	vec3 d = Fetch(vec2(-2.0, 0.0));
+	vec3 e = Fetch(vec2(0.0, 0.0));
+	vec3 f = Fetch(vec2(2.0, 0.0));
+	vec3 g = Fetch(vec2(-2.0, -2.0));
+	vec3 h = Fetch(vec2(0.0, -2.0));
+	vec3 i = Fetch(vec2(2.0, -2.0));
+	vec3 j = Fetch(vec2(-1.0, 1.0));
+	vec3 k = Fetch(vec2(1.0, 1.0));
+	vec3 l = Fetch(vec2(-1.0, -1.0));
+	vec3 m = Fetch(vec2(1.0, -1.0));
+
+	vec3 result = e * 0.125;
+	result += (a + c + g + i) * 0.03125;
+	result += (b + d + f + h) * 0.0625;
+	result += (j + k + l + m) * 0.125;
+
+	if (prefilter) {
+		result = Prefilter(result);
+	}
+
+	FragColor = vec4(result, 1.0);
+}
@@ -0,0 +1,27 @@
+#version 330 core
+
+out vec4 FragColor;
+
+in vec2 fTexCoord;
+
+// the smaller level, added to the bound one by blending
+uniform sampler2D source;
+uniform vec2 texelSize;
+uniform float radius;
+
+void main() {
+	vec2 offset = texelSize * radius;
+
+	// 3x3 tent
+	vec3 result = texture(source, fTexCoord).rgb * 4.0;
+	result += texture(source, fTexCoord + vec2(-offset.x, 0.0)).rgb * 2.0;
+	result += texture(source, fTexCoord + vec2(offset.x, 0.0)).rgb * 2.0;
+	result += texture(source, fTexCoord + vec2(0.0, -offset.y)).rgb * 2.0;
+	result += texture(source, fTexCoord + vec2(0.0, offset.y)).rgb * 2.0;
+	result += texture(source, fTexCoord + vec2(-offset.x, -offset.y)).rgb;
+	result += texture(source, fTexCoord + vec2(offset.x, -offset.y)).rgb;
+	result += texture(source, fTexCoord + vec2(-offset.x, offset.y)).rgb;
+	result += texture(source, fTexCoord + vec2(offset.x, offset.y)).rgb;
+
+	FragColor = vec4(result / 16.0, 1.0);
+}
@@ -0,0 +1,144 @@
+#version 430 core
+
+in vec2 fTexCoord;
+
+out vec4 FragColor;
+
+uniform sampler2D gAlbedoSpecular;
+uniform sampler2D gNormal;
+uniform sampler2D gDepth;
+
+uniform mat4 inverseProjection;
+
+// view space, pointing from the light
+uniform vec3 lightDirection;
+uniform vec3 lightColor;
+uniform vec3 ambientColor;
+uniform float shininess;
+
+// Cascaded shadow maps of the directional light, see
+// lighting::CascadedShadowMap. Matrices take view space positions
+uniform sampler2DArrayShadow shadowMap;
+uniform int cascadeCount;
+uniform vec4 cascadeSplits;
+uniform mat4 cascadeMatrices[4];
+
+// view space position + radius, color + intensity
+struct PointLight {
+	vec4 positionRadius;
+	vec4 colorIntensity;
+};
+
+// Clustered point lights, see lighting::ClusteredLights
+layout(std430, binding = 6) readonly buffer PointLights {
+	PointLight pointLights[];
+};
+layout(std430, binding = 7) readonly buffer Clusters {
+	uvec2 clusters[]; // offset, count
+};
+layout(std430, binding = 8) readonly buffer LightIndices {
+	uint lightIndices[];
+};
+
+uniform ivec3 clusterGrid;
+uniform vec2 clusterTileSize;
+uniform float clusterDepthScale;
+uniform float clusterDepthBias;
+
+vec3 DecodeNormal(vec2 e) {
+	e = e * 2.0 - 1.0;
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+	return normalize(n);
+}
+
+vec3 ReconstructPosition(vec2 uv, float depth) {
+	vec4 position = inverseProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+	return position.xyz / position.w;
+}
+
+uint ClusterIndex(float depth) {
+	int slice = int(log(depth) * clusterDepthScale - clusterDepthBias);
+	ivec3 cluster = ivec3(ivec2(gl_FragCoord.xy / clusterTileSize), slice);
+	cluster = clamp(cluster, ivec3(0), clusterGrid - 1);
+	return uint(cluster.x + clusterGrid.x * (cluster.y + clusterGrid.y * cluster.z));
+}
+
+float Shadow(vec3 position, vec3 normal, vec3 lightDir) {
+	int cascade = 0;
+	while (cascade < cascadeCount && -position.z > cascadeSplits[cascade]) {
+		cascade++;
+	}
+	// beyond the shadow distance
+	if (cascade == cascadeCount) {
+		return 1.0;
+	}
+
+	// normal offset grows with the cascade texel size
+	vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+	// first row of the matrix is the light x axis over the cascade radius
+	mat4 matrix = cascadeMatrices[cascade];
+	float radius = 1.0 / length(vec3(matrix[0][0], matrix[1][0], matrix[2][0]));
+	float offset = 2.0 * radius * texel.x;
+	float slope = 1.0 - max(dot(normal, lightDir), 0.0);
+	position += normal * offset * (0.5 + slope);
+
+	vec4 coord = matrix * vec4(position, 1.0);
+	coord.xyz = coord.xyz * 0.5 + 0.5;
+
+	// 3x3 taps of the bilinear compare, soft 4x4 texel kernel
+	float lit = 0.0;
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			vec2 uv = coord.xy + vec2(x, y) * texel;
+			lit += texture(shadowMap, vec4(uv, cascade, coord.z));
+		}
+	}
+	return lit / 9.0;
+}
+
+vec3 Shade(vec3 lightDir, vec3 radiance, vec3 normal, vec3 viewDir, vec3 albedo, float specular) {
+	vec3 halfway = normalize(lightDir + viewDir);
+	float diff = max(dot(normal, lightDir), 0.0);
+	float spec = pow(max(dot(normal, halfway), 0.0), shininess) * specular;
+	return radiance * (diff * albedo + spec);
+}
+
+void main() {
+	float depth = texture(gDepth, fTexCoord).r;
+	// nothing was drawn, the skybox fills it later
+	if (depth == 1.0) {
+		discard;
+	}
+	// forward passes after lighting depth test against the G-buffer
+	gl_FragDepth = depth;
+
+	vec4 albedoSpecular = texture(gAlbedoSpecular, fTexCoord);
+	vec3 albedo = pow(albedoSpecular.rgb, vec3(2.2));
+	float specular = albedoSpecular.a;
+	vec3 normal = DecodeNormal(texture(gNormal, fTexCoord).rg);
+	vec3 position = ReconstructPosition(fTexCoord, depth);
+	vec3 viewDir = normalize(-position);
+
+	vec3 result = ambientColor * albedo;
+	vec3 sunDir = normalize(-lightDirection);
+	float shadow = Shadow(position, normal, sunDir);
+	result += Shade(sunDir, lightColor * shadow, normal, viewDir, albedo, specular);
+
+	uvec2 cluster = clusters[ClusterIndex(-position.z)];
+	for (uint i = 0; i < cluster.y; i++) {
+		PointLight light = pointLights[lightIndices[cluster.x + i]];
+		vec3 lightDiff = light.positionRadius.xyz - position;
+		float distance = length(lightDiff);
+
+		// inverse square, windowed to reach zero at the cluster radius
+		float window = clamp(1.0 - pow(distance / light.positionRadius.w, 4.0), 0.0, 1.0);
+		float attenuation = window * window / (1.0 + distance * distance);
+		vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.w * attenuation;
+
+		result += Shade(lightDiff / distance, radiance, normal, viewDir, albedo, specular);
+	}
+
+	FragColor = vec4(result, 1.0);
+}
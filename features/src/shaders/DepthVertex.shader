@@ -0,0 +1,19 @@
+#version 330 core
+
+layout (location = 0) in vec3 vPosition;
+
+layout (std140) uniform Camera {
+	mat4 projection;
+	mat4 view;
+};
+
+uniform mat4 model;
+
+// same operations as DimensionVertex + DimensionGeometry, invariant in every
+// stage so depth is bit-identical for the GL_EQUAL test of the color pass
+invariant gl_Position;
+
+void main() {
+	vec4 position = model * vec4(vPosition, 1.0);
+	gl_Position = projection * view * vec4(position.xyz, 1.0);
+}
@@ -22,6 +22,9 @@ layout (std140) uniform Camera {
 
 uniform float time;
 
+// matches the depth pre-pass (DepthVertex), see there
+invariant gl_Position;
+
 vec4 vp(vec3 position, float movable) {
 	return projection * view * vec4(position, movable);
 }
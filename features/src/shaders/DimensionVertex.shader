@@ -17,6 +17,9 @@ layout (std140) uniform Camera {
 
 uniform mat4 model;
 
+// matches the depth pre-pass (DepthVertex), see there
+invariant gl_Position;
+
 void main() {
 	vec4 position = model * vec4(vPosition, 1.0);
 
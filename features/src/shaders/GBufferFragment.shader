@@ -0,0 +1,38 @@
+#version 330 core
+
+in VS_OUT {
+	vec3 position;
+	vec3 normal;
+	vec2 texCoord;
+} fs_in;
+
+layout (location = 0) out vec4 AlbedoSpecular;
+layout (location = 1) out vec2 Normal;
+
+uniform struct {
+	sampler2D texture_diffuse0;
+
+	sampler2D texture_specular0;
+
+	float shininess;
+} material;
+
+layout (std140) uniform Camera {
+	mat4 projection;
+	mat4 view;
+};
+
+// Octahedral mapping of a unit vector to [0, 1]^2
+vec2 EncodeNormal(vec3 n) {
+	n /= abs(n.x) + abs(n.y) + abs(n.z);
+	if (n.z < 0.0) {
+		n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	}
+	return n.xy * 0.5 + 0.5;
+}
+
+void main() {
+	AlbedoSpecular = vec4(texture(material.texture_diffuse0, fs_in.texCoord).rgb,
+						  texture(material.texture_specular0, fs_in.texCoord).r);
+	Normal = EncodeNormal(normalize(mat3(view) * fs_in.normal));
+}
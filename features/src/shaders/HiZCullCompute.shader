@@ -0,0 +1,167 @@
+#version 430 core
+
+layout (local_size_x = 64) in;
+
+struct Bounds {
+	vec4 center;
+	vec4 extents;
+};
+
+struct DrawCommand {
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int baseVertex;
+	uint baseInstance;
+};
+
+// Instance is 21 tightly packed words: mat4 model, vec4 color, uint material
+// (static_assert next to over::Instance). Copied as raw words, the material
+// read as a float could be a denormal and get flushed
+const uint INSTANCE_SIZE = 21;
+
+layout (std430, binding = 0) readonly buffer BoundsBuffer {
+	Bounds bounds[];
+};
+
+layout (std430, binding = 1) readonly buffer InstanceBuffer {
+	uint instances[];
+};
+
+layout (std430, binding = 2) buffer VisibilityBuffer {
+	uint visibility[];
+};
+
+layout (std430, binding = 3) writeonly buffer OutputBuffer {
+	uint outputInstances[];
+};
+
+layout (std430, binding = 4) buffer CommandBuffer {
+	DrawCommand commands[];
+};
+
+layout (std430, binding = 5) buffer StatisticsBuffer {
+	uint objects;
+	uint frustumCulled;
+	uint occlusionCulled;
+	uint visible;
+} statistics;
+
+uniform uint phase;
+uniform uint count;
+uniform uint meshCount;
+
+uniform mat4 viewProjection;
+uniform vec4 planes[6];
+
+uniform bool occlusionTest;
+uniform sampler2D pyramid;
+uniform ivec2 pyramidSize;
+uniform int pyramidLevels;
+
+bool insideFrustum(Bounds box) {
+	for (int i = 0; i < 6; i++) {
+		float distance = dot(planes[i].xyz, box.center.xyz) + planes[i].w;
+		float radius = dot(abs(planes[i].xyz), box.extents.xyz);
+		if (distance + radius < 0.0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool occluded(Bounds box) {
+	vec3 minUV = vec3(1.0);
+	vec3 maxUV = vec3(0.0);
+
+	for (int i = 0; i < 8; i++) {
+		vec3 corner = box.center.xyz + box.extents.xyz *
+			vec3((i & 1) != 0 ? 1.0 : -1.0,
+				 (i & 2) != 0 ? 1.0 : -1.0,
+				 (i & 4) != 0 ? 1.0 : -1.0);
+		vec4 clip = viewProjection * vec4(corner, 1.0);
+
+		// crosses the near plane, can not be projected
+		if (clip.w <= 0.0) {
+			return false;
+		}
+
+		vec3 ndc = clip.xyz / clip.w * 0.5 + 0.5;
+		minUV = min(minUV, ndc);
+		maxUV = max(maxUV, ndc);
+	}
+
+	minUV = clamp(minUV, 0.0, 1.0);
+	maxUV = clamp(maxUV, 0.0, 1.0);
+
+	// level where the rectangle covers at most 2x2 texels
+	vec2 extent = (maxUV.xy - minUV.xy) * vec2(pyramidSize);
+	int lod = int(ceil(log2(max(max(extent.x, extent.y), 1.0))));
+	lod = clamp(lod, 0, pyramidLevels - 1);
+
+	ivec2 levelSize = max(pyramidSize >> lod, ivec2(1));
+	ivec2 low = clamp(ivec2(minUV.xy * vec2(levelSize)), ivec2(0), levelSize - 1);
+	ivec2 high = clamp(ivec2(maxUV.xy * vec2(levelSize)), ivec2(0), levelSize - 1);
+
+	if (any(greaterThan(high - low, ivec2(1))) && lod < pyramidLevels - 1) {
+		lod++;
+		levelSize = max(pyramidSize >> lod, ivec2(1));
+		low = clamp(ivec2(minUV.xy * vec2(levelSize)), ivec2(0), levelSize - 1);
+		high = clamp(ivec2(maxUV.xy * vec2(levelSize)), ivec2(0), levelSize - 1);
+	}
+
+	float farthest = max(
+		max(texelFetch(pyramid, low, lod).r, texelFetch(pyramid, ivec2(high.x, low.y), lod).r),
+		max(texelFetch(pyramid, ivec2(low.x, high.y), lod).r, texelFetch(pyramid, high, lod).r));
+
+	return minUV.z > farthest;
+}
+
+void append(uint object) {
+	uint slot = atomicAdd(commands[0].instanceCount, 1);
+	// every mesh of the model draws the same instances
+	for (uint mesh = 1; mesh < meshCount; mesh++) {
+		atomicAdd(commands[mesh].instanceCount, 1);
+	}
+
+	uint source = object * INSTANCE_SIZE;
+	uint destination = slot * INSTANCE_SIZE;
+	for (uint i = 0; i < INSTANCE_SIZE; i++) {
+		outputInstances[destination + i] = instances[source + i];
+	}
+}
+
+void main() {
+	uint object = gl_GlobalInvocationID.x;
+	if (object >= count) {
+		return;
+	}
+
+	Bounds box = bounds[object];
+
+	// phase 0: last frame visible set, no occlusion test
+	if (phase == 0) {
+		if (visibility[object] != 0 && insideFrustum(box)) {
+			append(object);
+		}
+		return;
+	}
+
+	// phase 1: everything against the pyramid built from phase 0 depth
+	uint previous = visibility[object];
+	uint current = 0;
+
+	if (!insideFrustum(box)) {
+		atomicAdd(statistics.frustumCulled, 1);
+	} else if (occlusionTest && occluded(box)) {
+		atomicAdd(statistics.occlusionCulled, 1);
+	} else {
+		atomicAdd(statistics.visible, 1);
+		current = 1;
+	}
+
+	visibility[object] = current;
+	if (current != 0 && previous == 0) {
+		append(object);
+	}
+}
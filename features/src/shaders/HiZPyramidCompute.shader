@@ -0,0 +1,40 @@
+#version 430 core
+
+layout (local_size_x = 8, local_size_y = 8) in;
+
+uniform sampler2D depth;
+layout (r32f, binding = 0) readonly uniform image2D previous;
+layout (r32f, binding = 1) writeonly uniform image2D destination;
+
+uniform int level;
+uniform ivec2 previousSize;
+uniform ivec2 size;
+
+void main() {
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(texel, size))) {
+		return;
+	}
+
+	if (level == 0) {
+		imageStore(destination, texel, vec4(texelFetch(depth, texel, 0).r));
+		return;
+	}
+
+	// farthest of the 2x2 footprint, odd sizes also take the 3rd row/column
+	ivec2 base = texel * 2;
+	ivec2 last = previousSize - 1;
+	ivec2 extra = ivec2(
+		(previousSize.x & 1) != 0 && texel.x == size.x - 1 ? 2 : 1,
+		(previousSize.y & 1) != 0 && texel.y == size.y - 1 ? 2 : 1);
+
+	float farthest = 0.0;
+	for (int y = 0; y <= extra.y; y++) {
+		for (int x = 0; x <= extra.x; x++) {
+			ivec2 coord = min(base + ivec2(x, y), last);
+			farthest = max(farthest, imageLoad(previous, coord).r);
+		}
+	}
+
+	imageStore(destination, texel, vec4(farthest));
+}
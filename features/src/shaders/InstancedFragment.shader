@@ -0,0 +1,19 @@
+#version 330 core
+
+in VS_OUT {
+	vec3 normal;
+	vec2 texCoord;
+	vec4 color;
+} fs_in;
+
+out vec4 FragColor;
+
+uniform struct {
+	sampler2D texture_diffuse0;
+} material;
+
+void main() {
+	// fixed light from above, enough to tell instances apart
+	float light = 0.4 + 0.6 * max(dot(normalize(fs_in.normal), vec3(0.0, 1.0, 0.0)), 0.0);
+	FragColor = vec4(texture(material.texture_diffuse0, fs_in.texCoord).rgb * fs_in.color.rgb * light, 1.0);
+}
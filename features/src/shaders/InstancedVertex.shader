@@ -0,0 +1,30 @@
+#version 330 core
+
+layout (location = 0) in vec3 vPosition;
+layout (location = 1) in vec3 vNormal;
+layout (location = 2) in vec2 vTexCoord;
+layout (location = 3) in mat4 iModel;
+layout (location = 7) in vec4 iColor;
+
+out VS_OUT {
+	vec3 normal;
+	vec2 texCoord;
+	vec4 color;
+} vs_out;
+
+layout (std140) uniform Camera {
+	mat4 projection;
+	mat4 view;
+};
+
+uniform mat4 model;
+
+void main() {
+	mat4 world = iModel * model;
+
+	vs_out.normal = mat3(world) * vNormal;
+	vs_out.texCoord = vTexCoord;
+	vs_out.color = iColor;
+
+	gl_Position = projection * view * world * vec4(vPosition, 1.0);
+}
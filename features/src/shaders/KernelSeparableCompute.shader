@@ -0,0 +1,49 @@
+#version 430 core
+
+#define GROUP_SIZE 16
+#define MAX_RADIUS 15
+
+layout (local_size_x = GROUP_SIZE, local_size_y = GROUP_SIZE) in;
+
+uniform sampler2D source;
+layout (binding = 0) writeonly uniform image2D destination;
+
+layout (std430, binding = 9) readonly buffer Weights {
+	float weights[];
+};
+
+uniform ivec2 size;
+uniform int radius;
+// (1, 0) filters rows, (0, 1) columns
+uniform ivec2 direction;
+uniform int weightOffset;
+
+// one strip along the direction per invocation across it, with its apron
+shared vec4 strips[GROUP_SIZE][GROUP_SIZE + 2 * MAX_RADIUS];
+
+void main() {
+	ivec2 local = ivec2(gl_LocalInvocationID.xy);
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+
+	int along = direction.x != 0 ? local.x : local.y;
+	int strip = direction.x != 0 ? local.y : local.x;
+	ivec2 start = texel - direction * (along + radius);
+
+	for (int i = along; i < GROUP_SIZE + 2 * radius; i += GROUP_SIZE) {
+		ivec2 coord = clamp(start + direction * i, ivec2(0), size - 1);
+		strips[strip][i] = texelFetch(source, coord, 0);
+	}
+
+	barrier();
+
+	if (any(greaterThanEqual(texel, size))) {
+		return;
+	}
+
+	vec3 result = vec3(0.0);
+	for (int i = 0; i <= 2 * radius; i++) {
+		result += weights[weightOffset + i] * strips[strip][along + i].rgb;
+	}
+
+	imageStore(destination, texel, vec4(result, strips[strip][along + radius].a));
+}
@@ -0,0 +1,63 @@
+#version 430 core
+
+#define GROUP_SIZE 16
+#define MAX_RADIUS 15
+#define MAX_TILE (GROUP_SIZE + 2 * MAX_RADIUS)
+
+layout (local_size_x = GROUP_SIZE, local_size_y = GROUP_SIZE) in;
+
+uniform sampler2D source;
+layout (binding = 0) writeonly uniform image2D destination;
+
+layout (std430, binding = 9) readonly buffer Weights {
+	float weights[];
+};
+
+uniform ivec2 size;
+uniform int radius;
+// false: every tap fetches the texture, the baseline the tile is measured by
+uniform bool tiled;
+
+// rgba as 4 halves, a full tile of vec4 does not fit the guaranteed 32 KB
+shared uvec2 tile[MAX_TILE * MAX_TILE];
+
+vec4 Fetch(ivec2 coord) {
+	return texelFetch(source, clamp(coord, ivec2(0), size - 1), 0);
+}
+
+void main() {
+	ivec2 local = ivec2(gl_LocalInvocationID.xy);
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 origin = ivec2(gl_WorkGroupID.xy) * GROUP_SIZE - radius;
+
+	int width = GROUP_SIZE + 2 * radius;
+	int count = tiled ? width * width : 0;
+	for (int i = int(gl_LocalInvocationIndex); i < count;
+	     i += GROUP_SIZE * GROUP_SIZE) {
+		vec4 color = Fetch(origin + ivec2(i % width, i / width));
+		tile[i] = uvec2(packHalf2x16(color.rg), packHalf2x16(color.ba));
+	}
+
+	barrier();
+
+	if (any(greaterThanEqual(texel, size))) {
+		return;
+	}
+
+	int kernelSize = 2 * radius + 1;
+	vec3 result = vec3(0.0);
+	for (int y = 0; y < kernelSize; y++) {
+		for (int x = 0; x < kernelSize; x++) {
+			vec3 color;
+			if (tiled) {
+				uvec2 halves = tile[(local.y + y) * width + local.x + x];
+				color = vec3(unpackHalf2x16(halves.x), unpackHalf2x16(halves.y).x);
+			} else {
+				color = Fetch(texel + ivec2(x, y) - radius).rgb;
+			}
+			result += weights[y * kernelSize + x] * color;
+		}
+	}
+
+	imageStore(destination, texel, vec4(result, Fetch(texel).a));
+}
@@ -0,0 +1,11 @@
+#version 330 core
+
+layout (location = 0) in vec3 vPosition;
+
+// cascade of lighting::CascadedShadowMap
+uniform mat4 lightViewProjection;
+uniform mat4 model;
+
+void main() {
+	gl_Position = lightViewProjection * model * vec4(vPosition, 1.0);
+}
@@ -5,6 +5,9 @@
 #include <over/core/Camera.hpp>
 #include <over/core/Includes.hpp>
 #include <over/core/Shader.hpp>
+#include <over/core/window/Context.hpp>
+#include <over/core/window/RunOptions.hpp>
+#include <over/core/window/Window.hpp>
 
 #include <fmt/core.h>
 
@@ -96,27 +99,12 @@ static void ScrollHandler(GLFWwindow* window, double _, double yscroll) {
 int main() {
   fmt::println("Fractal");
 
-  glfwInit();
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-  GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, TITLE, nullptr, nullptr);
-  if (!window) {
-    const char* err = "Window creation failed";
-    fmt::println(err);
-    glfwTerminate();
-    throw fmt::system_error(-1, err);
-  }
-
-  glfwMakeContextCurrent(window);
-
-  // Initialize GLAD
-  if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-    fmt::println("Failed to initialize GLAD");
-    glfwTerminate();
-    return -1;
-  }
+  // OVER_BACKEND, OVER_FRAMES and OVER_CAPTURE, see over::RunOptions
+  const auto& options = over::RunOptions::Get();
+  over::Context context(3, 3);
+  over::Window surface(WIDTH, HEIGHT, TITLE);
+  context.LoadOpenGL(surface);
+  GLFWwindow* window = surface.Get();
 
   glViewport(0, 0, WIDTH, HEIGHT);
   glfwSetWindowSizeCallback(window,
@@ -196,6 +184,7 @@ int main() {
   uint32_t lastFps = 0;
   float deltaTime = 0;
   float lastTime = glfwGetTime();
+  size_t frame = 0;
 
   int k = 500;
   int p = 2;
@@ -216,7 +205,7 @@ int main() {
     colors[i] /= 255.0;
   }
 
-  while (!glfwWindowShouldClose(window)) {
+  while (!glfwWindowShouldClose(window) && !options.IsDone(frame)) {
     float startTime = glfwGetTime();
     glfwPollEvents();
 
@@ -275,10 +264,14 @@ int main() {
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
-    glfwSwapBuffers(window);
+    if (options.IsCaptured(frame)) {
+      surface.ReadPixels().ToFile(options.capture);
+    }
+    surface.SwapBuffers();
 
     deltaTime = glfwGetTime() - startTime;
     fps++;
+    frame++;
   }
 
   ImGui_ImplOpenGL3_Shutdown();
@@ -289,7 +282,5 @@ int main() {
   glDeleteBuffers(1, &vbo);
   glDeleteBuffers(1, &ibo);
 
-  glfwTerminate();
-
   return 0;
 }
\ No newline at end of file
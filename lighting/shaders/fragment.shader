@@ -1,4 +1,4 @@
-#version 330 core
+#version 430 core
 
 struct Material {
 	sampler2D diffuse;
@@ -15,16 +15,10 @@ struct DirLight {
 	vec3 specular;
 };
 
+// view space position + radius, color + intensity
 struct PointLight {
-	vec3 position;
-
-	vec3 ambient;
-	vec3 diffuse;
-	vec3 specular;
-
-	float constant;
-	float linear;
-	float quadratic;
+	vec4 positionRadius;
+	vec4 colorIntensity;
 };
 
 struct SpotLight {
@@ -49,21 +43,38 @@ uniform vec3 viewPosition;
 uniform Material material;
 
 uniform DirLight dirLight;
-#define NR_POINT_LIGHTS 4
-uniform PointLight pointLights[NR_POINT_LIGHTS];
 uniform SpotLight spotLight;
 
+// Clustered point lights, see lighting::ClusteredLights
+layout(std430, binding = 6) readonly buffer PointLights {
+	PointLight pointLights[];
+};
+layout(std430, binding = 7) readonly buffer Clusters {
+	uvec2 clusters[]; // offset, count
+};
+layout(std430, binding = 8) readonly buffer LightIndices {
+	uint lightIndices[];
+};
+
+uniform ivec3 clusterGrid;
+uniform vec2 clusterTileSize;
+uniform float clusterDepthScale;
+uniform float clusterDepthBias;
+
 uniform float timePassed;
 
 vec3 CalcDirLight(DirLight light);
 vec3 CalcPointLight(PointLight light);
 vec3 CalcSpotLight(SpotLight light);
+uint ClusterIndex();
 
 void main() {
 	vec3 result = vec3(0);
 	result += CalcDirLight(dirLight);
-	for (int i = 0; i < NR_POINT_LIGHTS; i++) {
-		result += CalcPointLight(pointLights[i]);
+
+	uvec2 cluster = clusters[ClusterIndex()];
+	for (uint i = 0; i < cluster.y; i++) {
+		result += CalcPointLight(pointLights[lightIndices[cluster.x + i]]);
 	}
 	result += CalcSpotLight(spotLight);
 
@@ -86,24 +97,32 @@ vec3 CalcDirLight(DirLight light) {
 	return ambient + diffuse + specular;
 }
 
+uint ClusterIndex() {
+	int slice = int(log(-fragmentPosition.z) * clusterDepthScale - clusterDepthBias);
+	ivec3 cluster = ivec3(ivec2(gl_FragCoord.xy / clusterTileSize), slice);
+	cluster = clamp(cluster, ivec3(0), clusterGrid - 1);
+	return uint(cluster.x + clusterGrid.x * (cluster.y + clusterGrid.y * cluster.z));
+}
+
 vec3 CalcPointLight(PointLight light) {
 	vec3 norm = normalize(normal);
-	vec3 lightDiff = light.position - fragmentPosition;
+	vec3 lightDiff = light.positionRadius.xyz - fragmentPosition;
 	vec3 lightDir = normalize(lightDiff);
 	vec3 viewDir = normalize(-fragmentPosition); // view basis
 	vec3 reflectDir = reflect(-lightDir, norm);
 
+	// inverse square, windowed to reach zero at the cluster radius
 	float distance = length(lightDiff);
-	float attenuation = min(1.0, 1.0 / (light.constant + light.linear * distance +
-		light.quadratic * distance * distance));
+	float window = clamp(1.0 - pow(distance / light.positionRadius.w, 4.0), 0.0, 1.0);
+	float attenuation = window * window / (1.0 + distance * distance);
 	float diff = max(dot(norm, lightDir), 0.0);
 	float spec = pow(max(dot(reflectDir, viewDir), 0.0), material.shininess);
 
-	vec3 ambient = light.ambient * attenuation * texture(material.diffuse, texCoord).rgb;
-	vec3 diffuse = light.diffuse * diff * attenuation * texture(material.diffuse, texCoord).rgb;
-	vec3 specular = light.specular * spec * attenuation * texture(material.specular, texCoord).rgb;
+	vec3 color = light.colorIntensity.rgb * light.colorIntensity.w * attenuation;
+	vec3 diffuse = color * diff * texture(material.diffuse, texCoord).rgb;
+	vec3 specular = color * spec * texture(material.specular, texCoord).rgb;
 
-	return ambient + diffuse + specular;
+	return diffuse + specular;
 }
 
 vec3 CalcSpotLight(SpotLight light) {
@@ -1,10 +1,16 @@
 #include <fmt/core.h>
+#include <cmath>
 #include <cstdint>
+#include <random>
 #include <vector>
 
 #include <over/core/Camera.hpp>
 #include <over/core/Includes.hpp>
 #include <over/core/Shader.hpp>
+#include <over/core/window/Context.hpp>
+#include <over/core/window/RunOptions.hpp>
+#include <over/core/window/Window.hpp>
+#include <over/core/lighting/ClusteredLights.hpp>
 #include <over/examples/lighting/mesh.hpp>
 
 #include <glm/glm.hpp>
@@ -17,8 +23,15 @@ constexpr float ASPECT_RATIO = 16.0 / 9.0;
 constexpr int32_t INIT_WIDTH = 1920;
 constexpr const int32_t INIT_HEIGHT = INIT_WIDTH / ASPECT_RATIO;
 
+// Point lights wandering over a floor of cubes, shaded clustered
+constexpr size_t POINT_LIGHTS = 1024;
+constexpr int32_t FLOOR_SIZE = 32;
+constexpr float FLOOR_SPACING = 2.f;
+constexpr float FLOOR_HEIGHT = -4.f;
+
 static over::Camera camera(glm::vec3(0, 0, 3), glm::vec3(0), 20.f,
-                           glm::radians(45.f), ASPECT_RATIO);
+                           glm::radians(45.f), ASPECT_RATIO, 0.1f, 100.f);
+static glm::ivec2 viewport(INIT_WIDTH, INIT_HEIGHT);
 
 static void ProcessInput(GLFWwindow* window, over::Camera& camera,
                          float deltaTime) {
@@ -78,28 +91,13 @@ int main() {
   fmt::println("vertex sizeof: {}", sizeof(over::Vertex));
   fmt::println("element sizeof: {}", sizeof(over::Element));
 
-  // Initialize GLFW
-  glfwInit();
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-  GLFWwindow* window =
-      glfwCreateWindow(INIT_WIDTH, INIT_HEIGHT, "Lighting", nullptr, nullptr);
-  if (!window) {
-    fmt::println("Failed to create window");
-    glfwTerminate();
-    return -1;
-  }
-
-  glfwMakeContextCurrent(window);
-
-  // Initialize GLAD
-  if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-    fmt::println("Failed to initialize GLAD");
-    glfwTerminate();
-    return -1;
-  }
+  // storage buffers of the clustered light lists need 4.3
+  // OVER_BACKEND, OVER_FRAMES and OVER_CAPTURE, see over::RunOptions
+  const auto& options = over::RunOptions::Get();
+  over::Context context(4, 3);
+  over::Window surface(INIT_WIDTH, INIT_HEIGHT, "Lighting");
+  context.LoadOpenGL(surface);
+  GLFWwindow* window = surface.Get();
 
   // Callbacks
   glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -109,6 +107,7 @@ int main() {
   glfwSetFramebufferSizeCallback(window,
                                  [](GLFWwindow* window, int width, int height) {
                                    glViewport(0, 0, width, height);
+                                   viewport = glm::ivec2(width, height);
                                  });
 
   // Init
@@ -121,7 +120,6 @@ int main() {
 
   glm::vec3 globalLightColor(0.f, 1.f, 1.f);
   glm::vec3 spotLightColor(1, 1, 1);
-  glm::vec3 pointLightColor = glm::vec3(1.f, 0.f, 0.f);
   over::Shader shader("shaders/vertex.shader", "shaders/fragment.shader");
   shader.Activate();
 
@@ -156,17 +154,49 @@ int main() {
       glm::vec3(1.3f, -2.0f, -2.5f),  glm::vec3(1.5f, 2.0f, -2.5f),
       glm::vec3(1.5f, 0.2f, -1.5f),   glm::vec3(-1.3f, 1.0f, -1.5f)};
 
-  std::vector<glm::vec3> pointLightPositions = {
-      glm::vec3(0.7f, 0.2f, 2.0f), glm::vec3(2.3f, -3.3f, -4.0f),
-      glm::vec3(-4.0f, 2.0f, -12.0f), glm::vec3(0.0f, 0.0f, -3.0f)};
+  // only the scattered cubes spin
+  size_t spinningCubes = cubePositions.size();
+  constexpr float floorExtent = FLOOR_SIZE * FLOOR_SPACING / 2.f;
+  for (int32_t z = 0; z < FLOOR_SIZE; z++) {
+    for (int32_t x = 0; x < FLOOR_SIZE; x++) {
+      cubePositions.emplace_back(x * FLOOR_SPACING - floorExtent, FLOOR_HEIGHT,
+                                 z * FLOOR_SPACING - floorExtent);
+    }
+  }
+
+  // lights circle around their anchors just above the floor
+  std::mt19937 random(7);
+  std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+  std::vector<glm::vec3> pointLightAnchors;
+  std::vector<float> pointLightPhases;
+  over::lighting::ClusteredLights clusteredLights;
+  auto& pointLights = clusteredLights.GetLights();
+  for (size_t i = 0; i < POINT_LIGHTS; i++) {
+    pointLightAnchors.emplace_back(
+        (unit(random) * 2.f - 1.f) * floorExtent,
+        FLOOR_HEIGHT + 1.f + unit(random) * 2.f,
+        (unit(random) * 2.f - 1.f) * floorExtent);
+    pointLightPhases.push_back(unit(random) * 6.2831853f);
+
+    over::lighting::PointLight light;
+    light.position = pointLightAnchors.back();
+    light.radius = 2.f + unit(random) * 3.f;
+    light.color = glm::vec3(unit(random), unit(random), unit(random));
+    light.intensity = 1.5f;
+    pointLights.push_back(light);
+  }
 
   glClearColor(0.05f, 0.05f, 0.06f, 1.0f);
   glEnable(GL_DEPTH_TEST);
 
   float deltaTime = 0.0f;
+  float statisticsTime = 0.0f;
+  size_t frames = 0;
+  size_t frame = 0;
 
   // Main Loop
-  while (!glfwWindowShouldClose(window)) {
+  while (!glfwWindowShouldClose(window) && !options.IsDone(frame)) {
     float startTime = glfwGetTime();
 
     ProcessInput(window, camera, deltaTime);
@@ -183,6 +213,15 @@ int main() {
                                   0.1f, 100.0f);
     shader.SetMatrix4f("projection", glm::value_ptr(projection));
 
+    for (size_t i = 0; i < pointLights.size(); i++) {
+      float angle = startTime * 0.5f + pointLightPhases[i];
+      pointLights[i].position =
+          pointLightAnchors[i] +
+          glm::vec3(std::cos(angle), 0.f, std::sin(angle)) * 1.5f;
+    }
+    clusteredLights.Update(view, projection, 0.1f, 100.0f);
+    clusteredLights.Bind(shader, viewport);
+
     glm::vec3 globalDir = view * glm::vec4(globalLightDirection, 0.f);
     shader.SetVec3f("dirLight.direction", globalDir);
     shader.SetVec3f("dirLight.ambient", globalLightColor * 0.2f * 0.75f);
@@ -209,22 +248,6 @@ int main() {
     shader.SetVec3f("spotLight.diffuse", spotLightColor * 0.75f);
     shader.SetVec3f("spotLight.specular", spotLightColor);
 
-    for (size_t i = 0; i < pointLightPositions.size(); i++) {
-      glm::vec3 pointPos = view * glm::vec4(pointLightPositions[i], 1.0f);
-      shader.SetVec3f(fmt::format("pointLights[{}].position", i), pointPos);
-
-      shader.SetVec3f(fmt::format("pointLights[{}].ambient", i),
-                      pointLightColor * 0.2f * 0.75f);
-      shader.SetVec3f(fmt::format("pointLights[{}].diffuse", i),
-                      pointLightColor * 0.75f);
-      shader.SetVec3f(fmt::format("pointLights[{}].specular", i),
-                      pointLightColor);
-
-      shader.SetFloat(fmt::format("pointLights[{}].constant", i), 1.0f);
-      shader.SetFloat(fmt::format("pointLights[{}].linear", i), 0.09f);
-      shader.SetFloat(fmt::format("light[{}].quadratic", i), 0.032f);
-    }
-
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // Draw
@@ -239,8 +262,10 @@ int main() {
     for (size_t i = 0; i < cubePositions.size(); i++) {
       model = glm::mat4(1.0f);
       model = glm::translate(model, cubePositions[i]);
-      model = glm::rotate(model, startTime * glm::radians(i * 20.0f),
-                          glm::vec3(0.5f, 1.0f, 0.0f));
+      if (i < spinningCubes) {
+        model = glm::rotate(model, startTime * glm::radians(i * 20.0f),
+                            glm::vec3(0.5f, 1.0f, 0.0f));
+      }
       shader.SetMatrix4f("model", glm::value_ptr(model));
 
       glDrawElements(GL_TRIANGLES, mesh.Elements().size() * 3, GL_UNSIGNED_INT,
@@ -252,13 +277,13 @@ int main() {
     lightShader.Activate();
     lightShader.SetMatrix4f("view", glm::value_ptr(view));
     lightShader.SetMatrix4f("projection", glm::value_ptr(projection));
-    lightShader.SetVec3f("lightColor", pointLightColor);
     light.Bind();
-    for (size_t i = 0; i < pointLightPositions.size(); i++) {
+    for (const auto& pointLight : pointLights) {
       model = glm::mat4(1.0f);
-      model = glm::translate(model, pointLightPositions[i]);
-      model = glm::scale(model, glm::vec3(0.2f));
+      model = glm::translate(model, pointLight.position);
+      model = glm::scale(model, glm::vec3(0.1f));
       lightShader.SetMatrix4f("model", glm::value_ptr(model));
+      lightShader.SetVec3f("lightColor", pointLight.color);
 
       glDrawElements(GL_TRIANGLES, light.Elements().size() * 3, GL_UNSIGNED_INT,
                      0);
@@ -266,15 +291,30 @@ int main() {
 
     light.Unbind();
 
-    glfwSwapBuffers(window);
+    if (options.IsCaptured(frame)) {
+      surface.ReadPixels().ToFile(options.capture);
+    }
+    surface.SwapBuffers();
     glfwPollEvents();
 
     deltaTime = glfwGetTime() - startTime;
+
+    frames++;
+    frame++;
+    statisticsTime += deltaTime;
+    if (statisticsTime >= 1.f) {
+      fmt::println(
+          "fps: {}, point lights: {} visible of {}, {} cluster entries, up to "
+          "{} per cluster",
+          frames, clusteredLights.GetVisibleLights(), pointLights.size(),
+          clusteredLights.GetIndexCount(),
+          clusteredLights.GetMaxClusterLights());
+      frames = 0;
+      statisticsTime = 0.f;
+    }
   }
 
   glDeleteTextures(1, &containerTexture);
   glDeleteTextures(1, &containerSpecularTexture);
-
-  glfwTerminate();
   return 0;
 }
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <over/core/Camera.hpp>
 #include <over/core/Includes.hpp>
 #include <over/core/Shader.hpp>
+#include <over/core/window/Context.hpp>
+#include <over/core/window/RunOptions.hpp>
+#include <over/core/window/Window.hpp>
 #include <over/examples/models/mmodel.hpp>
 
 #include <fmt/core.h>
@@ -42,29 +45,12 @@ static void ScrollHandler(GLFWwindow* window, double xoffset, double yoffset) {
 int main() {
   fmt::println(TITLE);
 
-  glfwInit();
-
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-  Window* window =
-      glfwCreateWindow(INIT_WIDTH, INIT_HEIGHT, TITLE, nullptr, nullptr);
-  if (!window) {
-    fmt::println("Error: cannot create window");
-
-    glfwTerminate();
-    return -1;
-  }
-
-  glfwMakeContextCurrent(window);
-
-  if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) {
-    fmt::println("Error: cannot link glad");
-
-    glfwTerminate();
-    return -1;
-  }
+  // OVER_BACKEND, OVER_FRAMES and OVER_CAPTURE, see over::RunOptions
+  const auto& options = over::RunOptions::Get();
+  over::Context context(3, 3);
+  over::Window surface(INIT_WIDTH, INIT_HEIGHT, TITLE);
+  context.LoadOpenGL(surface);
+  Window* window = surface.Get();
 
   glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
   glfwSetCursorPosCallback(window, CursorPositionHandler);
@@ -91,13 +77,14 @@ int main() {
   over::MModel entity("resources/backpack/backpack.obj");
 
   float deltaTime = 0.0f;
+  size_t frame = 0;
 
   glClearColor(0.1f, 0.2f, 0.3f, 1.0f);
   glEnable(GL_CULL_FACE);
   glEnable(GL_DEPTH_TEST);
   glEnable(GL_STENCIL_TEST);
 
-  while (!glfwWindowShouldClose(window)) {
+  while (!glfwWindowShouldClose(window) && !options.IsDone(frame)) {
     glfwPollEvents();
     float startTime = glfwGetTime();
 
@@ -148,12 +135,14 @@ int main() {
     outlineShader.SetMatrix4f("model", glm::value_ptr(model));
     entity.Draw(outlineShader);
 
-    glfwSwapBuffers(window);
+    if (options.IsCaptured(frame)) {
+      surface.ReadPixels().ToFile(options.capture);
+    }
+    surface.SwapBuffers();
 
     deltaTime = glfwGetTime() - startTime;
+    frame++;
   }
 
-  glfwTerminate();
-
   return 0;
 }
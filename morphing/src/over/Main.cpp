@@ -2,13 +2,20 @@
 #include <over/core/Model.hpp>
 #include <over/core/Shader.hpp>
 #include <over/core/Types.hpp>
+#include <over/core/opengl/RenderStats.hpp>
+#include <over/core/profiling/Profiler.hpp>
 #include <over/core/window/Context.hpp>
+#include <over/core/window/RunOptions.hpp>
 #include <over/examples/morphing/App.hpp>
 #include <over/examples/morphing/DirectionalLight.hpp>
 #include <over/examples/morphing/SpotLight.hpp>
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
+#include <array>
+#include <fstream>
+
 #include <fmt/core.h>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -86,8 +93,98 @@ static std::vector<Vertex> GetSphereVerticies(const std::vector<Vertex>& cube) {
   return result;
 }
 
+static void DrawZones(std::vector<profiling::Zone> zones) {
+  // closed order puts children first
+  std::sort(zones.begin(), zones.end(),
+            [](const auto& a, const auto& b) { return a.start < b.start; });
+  for (const auto& zone : zones) {
+    ImGui::Text("%*s%s: %.3f ms", static_cast<int>(zone.depth * 2), "",
+                zone.name, zone.GetMilliseconds());
+  }
+}
+
+// Frame time history and the breakdown of the newest frame with GPU times
+static void DrawProfiler() {
+  auto& profiler = profiling::Profiler::Instance();
+
+  ImGui::Begin("Profiler");
+
+  bool enabled = profiler.IsEnabled();
+  if (ImGui::Checkbox("Enabled", &enabled)) {
+    profiler.SetEnabled(enabled);
+  }
+
+  std::array<float32, profiling::Profiler::HISTORY> times{};
+  usize count = profiler.GetFrameCount();
+  for (usize i = 0; i < count; i++) {
+    times[i] =
+        static_cast<float32>(profiler.GetFrame(count - 1 - i).GetMilliseconds());
+  }
+  ImGui::PlotLines("frame, ms", times.data(), static_cast<int>(count), 0,
+                   nullptr, 0.f, 33.f, ImVec2(0, 60));
+
+  if (const auto* frame = profiler.GetLatestComplete()) {
+    ImGui::Text("frame %zu: %.3f ms", frame->index, frame->GetMilliseconds());
+    ImGui::Separator();
+    ImGui::Text("CPU");
+    DrawZones(frame->cpu);
+    ImGui::Separator();
+    ImGui::Text("GPU");
+    DrawZones(frame->gpu);
+  }
+
+  if (ImGui::Button("Export trace")) {
+    std::ofstream("profile.json") << profiler.ExportTrace();
+  }
+
+  ImGui::End();
+}
+
+static void DrawCounters(const gl::RenderCounters& counters) {
+  ImGui::TextUnformatted(
+      fmt::format("draws: {}, triangles: {}, instances: {}, dispatches: {}",
+                  counters.drawCalls, counters.triangles, counters.instances,
+                  counters.dispatches)
+          .c_str());
+  ImGui::TextUnformatted(
+      fmt::format("binds: {} programs, {} layouts, {} textures, {} frame "
+                  "buffers",
+                  counters.programBinds, counters.layoutBinds,
+                  counters.textureBinds, counters.frameBufferBinds)
+          .c_str());
+  ImGui::TextUnformatted(
+      fmt::format("uniforms: {}, uploads: {} B buffers, {} B textures",
+                  counters.uniformCalls, counters.bufferBytes,
+                  counters.textureBytes)
+          .c_str());
+  ImGui::TextUnformatted(fmt::format("objects: {} created, {} destroyed",
+                                     counters.created, counters.destroyed)
+                             .c_str());
+}
+
+// Driver work of the last frame, whole and per pass
+static void DrawRenderStats() {
+  const auto& stats = gl::RenderStats::Instance();
+
+  ImGui::Begin("Render stats");
+  if (stats.GetFrameCount() > 0) {
+    DrawCounters(stats.GetFrame());
+    for (const auto& pass : stats.GetPasses()) {
+      if (ImGui::CollapsingHeader(pass.name.c_str())) {
+        DrawCounters(pass.counters);
+      }
+    }
+  }
+
+  if (ImGui::Button("Export CSV")) {
+    std::ofstream("render_stats.csv") << stats.ExportCsv();
+  }
+  ImGui::End();
+}
+
 void Run() {
   fmt::println(TITLE);
+  OVER_PROFILE_THREAD("main");
 
   App app;
   auto* window = app.GetWindow().Get();
@@ -154,7 +251,12 @@ void Run() {
         modelMesh.GetVBO().GetVerticies(), morphing);
   model.GetMeshes().back().GetVBO().ToGPU(true);
 
-  while (!glfwWindowShouldClose(window)) {
+  const auto& options = RunOptions::Get();
+  usize frame = 0;
+
+  while (!glfwWindowShouldClose(window) && !options.IsDone(frame)) {
+    OVER_PROFILE_FRAME();
+    OVER_RENDER_STATS_FRAME();
     glfwPollEvents();
 
     float32 startTime = glfwGetTime();
@@ -199,6 +301,9 @@ void Run() {
 
     ImGui::End();
 
+    DrawProfiler();
+    DrawRenderStats();
+
     spotLight.SetCutOff(glm::cos(glm::radians(cutOffDeg)));
     spotLight.SetOuterCutOff(glm::cos(glm::radians(outerCutOffDeg)));
 
@@ -211,6 +316,8 @@ void Run() {
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     if (lastMorphing != morphing) {
+      OVER_PROFILE_ZONE("morph");
+      OVER_RENDER_STATS_PASS("morph");
       Morph(from, to, modelMesh.GetIBO().GetElements(),
             modelMesh.GetVBO().GetVerticies(), morphing);
       model.GetMeshes().back().GetVBO().ToGPU(true);
@@ -222,17 +329,34 @@ void Run() {
     dirLight.Activate(shader, camera);
     spotLight.Activate(shader, camera);
 
-    model.Draw(shader);
+    {
+      OVER_PROFILE_ZONE("draw");
+      OVER_PROFILE_GPU_ZONE("draw");
+      OVER_RENDER_STATS_PASS("draw");
+      model.Draw(shader);
+    }
 
     app.SetDelta(glfwGetTime() - startTime);
 
     // Rendering
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    {
+      OVER_PROFILE_ZONE("imgui");
+      OVER_PROFILE_GPU_ZONE("imgui");
+      ImGui::Render();
+      ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
+
+    if (options.IsCaptured(frame)) {
+      app.GetWindow().ReadPixels().ToFile(options.capture);
+    }
 
-    glfwSwapBuffers(window);
+    {
+      OVER_PROFILE_ZONE("swap");
+      app.GetWindow().SwapBuffers();
+    }
 
     fps++;
+    frame++;
   }
 
   ImGui_ImplOpenGL3_Shutdown();
@@ -57,8 +57,9 @@ SpotLight& SpotLight::operator=(SpotLight&& other) noexcept {
 void SpotLight::Activate(Shader& shader, Camera& camera) {
   // TOOD: compress to one uniform call
 
-  auto position = camera.GetView() * glm::vec4(_position, 1.f);
-  auto direction = camera.GetView() * glm::vec4(_direction, 0.f);
+  const auto& view = camera.GetView();
+  auto position = view * glm::vec4(_position, 1.f);
+  auto direction = view * glm::vec4(_direction, 0.f);
 
   shader.SetVec3f("spotLight.position", position);
   shader.SetVec3f("spotLight.direction", direction);